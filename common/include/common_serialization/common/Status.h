@@ -93,7 +93,8 @@ enum class Status : int32_t
     ErrorTypeSizeIsTooBig                           =      -21,
     ErrorValueOverflow                              =      -22,
     ErrorNotAvailible                               =      -23,
-    ErrorAlreadyInited                              =      -24
+    ErrorAlreadyInited                              =      -24,
+    ErrorBusy                                       =      -25
 };
 
 AGS_CS_ALWAYS_INLINE constexpr [[nodiscard]] bool statusSuccess(Status status)
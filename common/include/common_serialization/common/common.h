@@ -29,4 +29,5 @@
 #include <common_serialization/common/std_equivalents.h>
 #include <common_serialization/common/traits.h>
 #include <common_serialization/common/Uuid.h>
+#include <common_serialization/common/interfaces/IAsyncIoProcessor.h>
 #include <common_serialization/common/interfaces/IIoProcessor.h>
@@ -119,6 +119,20 @@ constexpr uint16_t reverseEndianessUInt16(uint16_t input)
     return input >> 8 | input << 8;
 }
 
+/// @brief Calculate 64-bit FNV-1a hash of bytes
+/// @param pData Start of bytes
+/// @param size Number of bytes
+/// @return Hash value
+constexpr uint64_t getFnv1aHash(const uint8_t* pData, size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+
+    for (size_t i = 0; i < size; ++i)
+        hash = (hash ^ pData[i]) * 0x100000001b3;
+
+    return hash;
+}
+
 template<typename T>
     requires EndiannessReversable<T>
 AGS_CS_ALWAYS_INLINE constexpr T reverseEndianess(T input)
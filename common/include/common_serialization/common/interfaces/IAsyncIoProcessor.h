@@ -0,0 +1,58 @@
+/**
+ * @file common_serialization/Interfaces/IAsyncIoProcessor.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+namespace common_serialization
+{
+
+/// @brief Generic interface for asynchronous input-output operations
+template<typename InputType, typename OutputType>
+class IAsyncIoProcessor
+{
+public:
+    /// @brief Receiver of asynchronous operation result
+    class ICompletion
+    {
+    public:
+        /// @brief Called once when operation is finished
+        /// @param status Status of operation
+        virtual void complete(Status status) noexcept = 0;
+
+    protected:
+        ~ICompletion() = default;
+    };
+
+    virtual ~IAsyncIoProcessor() {}
+
+    /// @brief Method for starting processing of input data
+    /// @note Input, output and completion must stay valid until completion is called.
+    ///     Completion may be called on any thread, including current one before return from this method.
+    /// @param input Input data
+    /// @param output Output data, that is filled when completion is called
+    /// @param completion Receiver of operation result
+    /// @return Status of operation start. If it is not successful completion will not be called.
+    virtual Status processAsync(const InputType& input, OutputType& output, ICompletion& completion) = 0;
+};
+
+} // namespace common_serialization
@@ -109,4 +109,19 @@ class is_template<T<Ts...>> : public std::true_type
 template<typename T>
 constexpr bool is_template_v = is_template<T>::value;
 
+/// @brief Test that type is an instance of template with one type
+///     and one size parameters (like std::array or std::span)
+template<typename T>
+class is_sized_template : public std::false_type
+{
+};
+
+template<template<typename, std::size_t> typename T, typename U, std::size_t N>
+class is_sized_template<T<U, N>> : public std::true_type
+{
+};
+
+template<typename T>
+constexpr bool is_sized_template_v = is_sized_template<T>::value;
+
 } // namespace common_serialization
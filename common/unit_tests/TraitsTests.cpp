@@ -100,4 +100,15 @@ TEST(ConceptsTests, IsTemplateV)
     EXPECT_FALSE(is_template_v<Test>);
 }
 
+template<typename T, size_t N> struct TestSizedTempl {};
+
+TEST(ConceptsTests, IsSizedTemplateV)
+{
+    EXPECT_TRUE((is_sized_template_v<TestSizedTempl<int, 5>>));
+    EXPECT_FALSE(is_sized_template_v<TestTempl<int>>);
+
+    struct Test {};
+    EXPECT_FALSE(is_sized_template_v<Test>);
+}
+
 } // namespace
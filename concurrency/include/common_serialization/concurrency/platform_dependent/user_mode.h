@@ -27,9 +27,16 @@ namespace common_serialization
 {
 
 using SharedMutex = std::shared_mutex;
+using Mutex = std::mutex;
+using ConditionVariable = std::condition_variable_any;
+using Thread = std::thread;
 using BinarySemaphore = std::binary_semaphore;
 using Latch = std::latch;
 using AtomicUint32 = std::atomic_uint32_t;
+using AtomicUint64 = std::atomic_uint64_t;
 using AtomicBool = std::atomic_bool;
 
+template<typename T>
+using Atomic = std::atomic<T>;
+
 } // namespace common_serialization
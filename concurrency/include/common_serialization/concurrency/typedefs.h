@@ -29,6 +29,9 @@
 #include TODO
 #else // AGS_CS_NO_STD_LIB
 #include <shared_mutex>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <semaphore>
 #include <latch>
 #include <atomic>
@@ -40,11 +43,18 @@ namespace common_serialization
 {
 
 using SharedMutexT = SharedMutex;
+using MutexT = Mutex;
+using ConditionVariableT = ConditionVariable;
+using ThreadT = Thread;
 using BinarySemaphoreT = BinarySemaphore;
 using LatchT = Latch;
 using AtomicUint32T = AtomicUint32;
+using AtomicUint64T = AtomicUint64;
 using AtomicBoolT = AtomicBool;
 
+template<typename T>
+using AtomicT = Atomic<T>;
+
 } // namespace common_serialization
 
 #endif // #ifndef AGS_CS_CS_CUSTOM_CONCURENCY_TYPEDEFS
@@ -148,6 +148,15 @@ public:
         return static_cast<T*>(m_p);
     }
 
+    /// @brief Get stored pointer
+    /// @tparam T Type on which pointer points
+    /// @return Stored pointer
+    template<typename T>
+    constexpr [[nodiscard]] const T* get() const
+    {
+        return static_cast<const T*>(m_p);
+    }
+
     /// @brief Get allocated size in items
     /// @return Allocated size
     constexpr [[nodiscard]] size_t size() const
@@ -152,6 +152,7 @@ public:
                   (m_bitness32 ? CommonFlags::kBitness32 : 0)
                 | (m_bigEndianFormat ? CommonFlags::kBigEndianFormat : 0)
                 | (m_endiannessDifference ? CommonFlags::kEndiannessDifference : 0)
+                | (m_withCorrelationId ? CommonFlags::kCorrelationId : 0)
             };
     }
 
@@ -162,6 +163,7 @@ public:
         m_bitness32 = commonFlags.bitness32();
         m_bigEndianFormat = commonFlags.bigEndianFormat();
         m_endiannessDifference = commonFlags.endiannessDifference();
+        m_withCorrelationId = commonFlags.withCorrelationId();
         m_endiannessNotMatch = bigEndianFormat() != helpers::isBigEndianPlatform();
         return *this;
     }
@@ -174,6 +176,17 @@ public:
     AGS_CS_ALWAYS_INLINE constexpr [[nodiscard]] bool bitness32() const noexcept { return m_bitness32; }
     AGS_CS_ALWAYS_INLINE constexpr [[nodiscard]] bool bigEndianFormat() const noexcept { return m_bigEndianFormat; }
     AGS_CS_ALWAYS_INLINE constexpr [[nodiscard]] bool endiannessDifference() const noexcept { return m_endiannessDifference; }
+    AGS_CS_ALWAYS_INLINE constexpr [[nodiscard]] bool withCorrelationId() const noexcept { return m_withCorrelationId; }
+
+    /// @brief Get correlation id of message
+    /// @note Is meaningful only when CommonFlags::kCorrelationId is set
+    /// @return Correlation id
+    AGS_CS_ALWAYS_INLINE constexpr [[nodiscard]] uint64_t getCorrelationId() const noexcept { return m_correlationId; }
+
+    /// @brief Set correlation id of message
+    /// @note Is serialized only when CommonFlags::kCorrelationId is set
+    /// @param correlationId Correlation id
+    AGS_CS_ALWAYS_INLINE constexpr Common& setCorrelationId(uint64_t correlationId) noexcept { m_correlationId = correlationId; return *this; }
 
     /// @brief Reset all fields to their default values, but leaves binary data and common flags unchanged
     /// @note Common flags are not resets to false because because they are 
@@ -184,6 +197,7 @@ public:
             m_binaryData.seek(0);
         m_protocolVersion = traits::getLatestProtocolVersion();
         m_messageType = Message::Data;
+        m_correlationId = 0;
         return *this;
     }
 
@@ -206,6 +220,8 @@ private:
     bool m_bitness32{ false };
     bool m_bigEndianFormat{ false };
     bool m_endiannessDifference{ false };
+    bool m_withCorrelationId{ false };
+    uint64_t m_correlationId{ 0 };
 };
 
 using SCommon = Common<true>;
@@ -43,7 +43,13 @@ public:
     /// @remark Currently not implemented
     static constexpr uint32_t kEndiannessDifference = 0x4;
 
-    static constexpr uint32_t kValidFlagsMask = 0x7;
+    /// @brief Common context is followed by 64-bit correlation id,
+    ///     that is returned unchanged in response to the message.
+    ///     It allows to have many requests in flight over one channel
+    ///     and to receive responses on them in any order.
+    static constexpr uint32_t kCorrelationId = 0x8;
+
+    static constexpr uint32_t kValidFlagsMask = 0xf;
     static constexpr uint32_t kForbiddenFlagsMask = ~kValidFlagsMask;
     static constexpr uint32_t kNoFlagsMask = 0x0;
 
@@ -57,6 +63,7 @@ public:
     constexpr [[nodiscard]] bool bitness32() const noexcept;
     constexpr [[nodiscard]] bool bigEndianFormat() const noexcept;
     constexpr [[nodiscard]] bool endiannessDifference() const noexcept;
+    constexpr [[nodiscard]] bool withCorrelationId() const noexcept;
 
     constexpr [[nodiscard]] CommonFlags operator|(CommonFlags rhs) const noexcept;
     constexpr [[nodiscard]] CommonFlags operator&(CommonFlags rhs) const noexcept;
@@ -117,6 +124,11 @@ constexpr bool CommonFlags::endiannessDifference() const noexcept
     return static_cast<bool>(m_flags & kEndiannessDifference);
 }
 
+constexpr bool CommonFlags::withCorrelationId() const noexcept
+{
+    return static_cast<bool>(m_flags & kCorrelationId);
+}
+
 constexpr CommonFlags CommonFlags::operator|(CommonFlags rhs) const noexcept
 {
     return static_cast<CommonFlags>(m_flags | rhs.m_flags);
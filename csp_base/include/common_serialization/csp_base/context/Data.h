@@ -337,6 +337,18 @@ public:
     /// @param forTempUseHeap Flag indicating type of temp allocation
     AGS_CS_ALWAYS_INLINE constexpr Data& setHeapUseForTemp(bool forTempUseHeap) { m_forTempUseHeap = forTempUseHeap; return *this; }
 
+    /// @brief Test if deserialization reuses elements that are already alive in target containers
+    /// @remark availible only on deserialization mode
+    /// @return Is reuse of existing elements turned on
+    AGS_CS_ALWAYS_INLINE constexpr [[nodiscard]] bool isExistingElementsReused() const noexcept requires (!serialize) { return m_reuseExistingElements; }
+
+    /// @brief Set that deserialization should assign into elements that are already alive in target containers
+    ///     instead of destroying them and constructing new ones. Storage owned by such elements is kept,
+    ///     so repeated deserialization into the same long-lived object does not reallocate it.
+    /// @remark availible only on deserialization mode
+    /// @param reuseExistingElements Flag indicating that existing elements should be reused
+    AGS_CS_ALWAYS_INLINE constexpr Data& setExistingElementsReuse(bool reuseExistingElements) noexcept requires (!serialize) { m_reuseExistingElements = reuseExistingElements; return *this; }
+
     /// @brief Get pointer to holding pointers map
     /// @return Pointer to pointers map
     AGS_CS_ALWAYS_INLINE constexpr [[nodiscard]] PM* getPointersMap() noexcept { return m_epp.getPointersMap(); }
@@ -370,8 +382,8 @@ public:
     AGS_CS_ALWAYS_INLINE [[nodiscard]] T* allocateAndDefaultConstruct() noexcept requires (!serialize) { return m_epp.template allocateAndDefaultConstruct<T>(); }
 
     /// @brief Reset all fields to their default values, but leaves processed binary data unchanged.
-    /// @note Flag of using heap allocation also not resets to false,
-    ///     because it's rather environment tool option instead of struct/operation specific.
+    /// @note Flags of using heap allocation and of reusing existing elements also not resets to false,
+    ///     because they are rather environment tool options instead of struct/operation specific.
     Data& resetToDefaultsExceptDataContents() noexcept override
     {
         Common<serialize>::resetToDefaultsExceptDataContents();
@@ -383,8 +395,8 @@ public:
     }
 
     /// @brief Reset all fields to their default values and clears binary data container
-    /// @note Flag of using heap allocation not resets to false,
-    ///     because it's rather environment tool option instead of struct/operation specific.
+    /// @note Flags of using heap allocation and of reusing existing elements not resets to false,
+    ///     because they are rather environment tool options instead of struct/operation specific.
     Data& clear() noexcept override
     {
         Common<serialize>::clear();
@@ -401,6 +413,7 @@ private:
     DataFlags m_dataFlags;
     bool m_interfaceVersionsNotMatch{ false };
     bool m_forTempUseHeap{ false };
+    bool m_reuseExistingElements{ false };
 
     // All next bool members are mirroring m_dataFlags value
     // they all are precalculated, when m_dataFlags is set up.
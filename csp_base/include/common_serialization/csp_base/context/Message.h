@@ -99,7 +99,25 @@ enum class Message : uint16_t
     ///     In response server must send Data message without any DataFlags applied.
     ///     This Data message shall contain csp::service_structs::CspPartySettings
     ///     struct with servers mandatory settings
-    GetSettings = 0x2
+    GetSettings = 0x2,
+
+    /// @brief Many messages packed in one. All of them share Common Context of Batch message.
+    /// @details
+    ///     Format of Private parts of message:
+    /// 
+    ///     {
+    ///         struct
+    ///         {
+    ///             Message messageType;
+    ///             uint32_t size;
+    ///             uint8_t privateParts[size]; // Private parts of message of messageType
+    ///         } items[]; // until the end of message
+    ///     }
+    /// 
+    ///     Item headers are always in little-endian format.
+    ///     Client sends only Data items and server responds with Batch message
+    ///     that has Data or Status item on every item of request in the same order.
+    Batch = 0x3
 };
 
 } // namespace common_serialization::csp::context
@@ -34,6 +34,7 @@
 #include <common_serialization/csp_base/context/Data.h>
 #include <common_serialization/csp_base/context/DataFlags.h>
 #include <common_serialization/csp_base/context/Message.h>
+#include <common_serialization/csp_base/processing/batch/ContextProcessor.h>
 #include <common_serialization/csp_base/processing/common/ContextProcessor.h>
 #include <common_serialization/csp_base/processing/data/BodyProcessor.h>
 #include <common_serialization/csp_base/processing/data/ContextProcessor.h>
@@ -0,0 +1,104 @@
+/**
+ * @file common_serialization/csp_base/processing/batch/ContextProcessor.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <common_serialization/csp_base/context/Common.h>
+#include <common_serialization/csp_base/processing/rw.h>
+
+namespace common_serialization::csp::processing::batch
+{
+
+/// @brief Processor of item headers of Batch message
+/// @note Item headers are always in little-endian format, no matter of CommonFlags
+class ContextProcessor
+{
+public:
+    /// @brief Write header of next item with size placeholder
+    /// @param ctx Context of Batch message
+    /// @param messageType Type of item
+    /// @param sizeOffset Offset of size placeholder that should be passed to serializeItemEnd()
+    /// @return Status of operation
+    static constexpr Status serializeItemBegin(context::SCommon& ctx, context::Message messageType, csp_size_t& sizeOffset);
+
+    /// @brief Write actual size of item that was written after serializeItemBegin()
+    /// @param ctx Context of Batch message
+    /// @param sizeOffset Offset that was returned by serializeItemBegin()
+    /// @return Status of operation
+    static constexpr Status serializeItemEnd(context::SCommon& ctx, csp_size_t sizeOffset) noexcept;
+
+    /// @brief Read header of next item
+    /// @param ctx Context of Batch message
+    /// @param messageType Type of item
+    /// @param size Size of item private parts that are following the header
+    /// @return Status of operation
+    static constexpr Status deserializeItem(context::DCommon& ctx, context::Message& messageType, csp_size_t& size) noexcept;
+};
+
+constexpr Status ContextProcessor::serializeItemBegin(context::SCommon& ctx, context::Message messageType, csp_size_t& sizeOffset)
+{
+    context::SCommon batchContextSpecial(ctx.getBinaryData());
+    batchContextSpecial.setCommonFlags(context::CommonFlags::kNoFlagsMask);
+
+    AGS_CS_RUN(writePrimitive(messageType, batchContextSpecial));
+    sizeOffset = ctx.getBinaryData().size();
+
+    return writePrimitive(static_cast<uint32_t>(0), batchContextSpecial);
+}
+
+constexpr Status ContextProcessor::serializeItemEnd(context::SCommon& ctx, csp_size_t sizeOffset) noexcept
+{
+    BinVectorT& binData = ctx.getBinaryData();
+
+    if (binData.size() < sizeOffset + sizeof(uint32_t))
+        return Status::ErrorOverflow;
+
+    const csp_size_t size = binData.size() - sizeOffset - sizeof(uint32_t);
+    if (static_cast<uint64_t>(size) > UINT32_MAX)
+        return Status::ErrorOverflow;
+
+    for (size_t i = 0; i < sizeof(uint32_t); ++i)
+        binData[sizeOffset + i] = static_cast<uint8_t>(size >> (i * 8));
+
+    return Status::NoError;
+}
+
+constexpr Status ContextProcessor::deserializeItem(context::DCommon& ctx, context::Message& messageType, csp_size_t& size) noexcept
+{
+    context::DCommon batchContextSpecial(ctx.getBinaryData(), ctx.getProtocolVersion()
+        , ctx.getMessageType(), context::CommonFlags{ context::CommonFlags::kNoFlagsMask });
+
+    AGS_CS_RUN(readPrimitive(batchContextSpecial, messageType));
+
+    uint32_t itemSize = 0;
+    AGS_CS_RUN(readPrimitive(batchContextSpecial, itemSize));
+
+    if (ctx.getBinaryData().size() - ctx.getBinaryData().tell() < itemSize)
+        return Status::ErrorOverflow;
+
+    size = itemSize;
+
+    return Status::NoError;
+}
+
+} // namespace common_serialization::csp::processing::batch
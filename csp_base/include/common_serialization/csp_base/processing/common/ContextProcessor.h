@@ -40,6 +40,28 @@ public:
 
     static constexpr Status deserialize(context::DCommon& ctx) noexcept;
     static constexpr Status deserializeNoChecks(context::DCommon& ctx) noexcept;
+
+    /// @brief Get correlation id of serialized message without its deserialization
+    /// @param binMessage Serialized message
+    /// @param correlationId Correlation id
+    /// @return Status of operation. If message has no correlation id ErrorInvalidArgument is returned.
+    static constexpr Status getCorrelationId(const BinVectorT& binMessage, uint64_t& correlationId) noexcept;
+
+    /// @brief Set correlation id in serialized message
+    /// @details If message has no correlation id, CommonFlags::kCorrelationId is set
+    ///     and correlation id is inserted after common context
+    /// @param binMessage Serialized message
+    /// @param correlationId Correlation id
+    /// @return Status of operation
+    static constexpr Status setCorrelationId(BinVectorT& binMessage, uint64_t correlationId);
+
+private:
+    // Common context has fixed layout: 16-bit protocol version, 16-bit message type and 32-bit common flags
+    static constexpr size_t kCommonFlagsOffset = sizeof(uint16_t) + sizeof(context::Message);
+    static constexpr size_t kCorrelationIdOffset = kCommonFlagsOffset + sizeof(uint32_t);
+
+    static constexpr uint64_t readLittleEndian(const uint8_t* p, size_t size) noexcept;
+    static constexpr void writeLittleEndian(uint64_t value, uint8_t* p, size_t size) noexcept;
 };
 
 constexpr Status ContextProcessor::testCommonFlagsCompatibility(context::CommonFlags commonFlags
@@ -71,6 +93,9 @@ constexpr Status ContextProcessor::serializeNoChecks(context::SCommon& ctx)
     AGS_CS_RUN(writePrimitive(ctx.getMessageType(), commonContextSpecial));
     AGS_CS_RUN(writePrimitive(static_cast<uint32_t>(ctx.getCommonFlags()), commonContextSpecial));
 
+    if (ctx.withCorrelationId())
+        AGS_CS_RUN(writePrimitive(ctx.getCorrelationId(), commonContextSpecial));
+
     return Status::NoError;
 }
 
@@ -100,6 +125,13 @@ constexpr Status ContextProcessor::deserialize(context::DCommon& ctx) noexcept
     if (ctx.endiannessNotMatch() && !ctx.endiannessDifference())
         return Status::ErrorNotCompatibleCommonFlagsSettings;
 
+    if (ctx.withCorrelationId())
+    {
+        uint64_t correlationId = 0;
+        AGS_CS_RUN(readPrimitive(commonContextSpecial, correlationId));
+        ctx.setCorrelationId(correlationId);
+    }
+
     return Status::NoError;
 }
 
@@ -125,7 +157,70 @@ constexpr Status ContextProcessor::deserializeNoChecks(context::DCommon& ctx) no
     context::CommonFlags commonFlags(intFlags);
     ctx.setCommonFlags(commonFlags);
 
+    if (ctx.withCorrelationId())
+    {
+        uint64_t correlationId = 0;
+        AGS_CS_RUN(readPrimitive(commonContextSpecial, correlationId));
+        ctx.setCorrelationId(correlationId);
+    }
+
+    return Status::NoError;
+}
+
+constexpr Status ContextProcessor::getCorrelationId(const BinVectorT& binMessage, uint64_t& correlationId) noexcept
+{
+    if (binMessage.size() < kCorrelationIdOffset)
+        return Status::ErrorOverflow;
+
+    if (!context::CommonFlags(static_cast<uint32_t>(readLittleEndian(binMessage.data() + kCommonFlagsOffset, sizeof(uint32_t)))).withCorrelationId())
+        return Status::ErrorInvalidArgument;
+
+    if (binMessage.size() < kCorrelationIdOffset + sizeof(uint64_t))
+        return Status::ErrorOverflow;
+
+    correlationId = readLittleEndian(binMessage.data() + kCorrelationIdOffset, sizeof(uint64_t));
+
+    return Status::NoError;
+}
+
+constexpr Status ContextProcessor::setCorrelationId(BinVectorT& binMessage, uint64_t correlationId)
+{
+    if (binMessage.size() < kCorrelationIdOffset)
+        return Status::ErrorOverflow;
+
+    uint8_t correlationIdBytes[sizeof(uint64_t)]{};
+    writeLittleEndian(correlationId, correlationIdBytes, sizeof(uint64_t));
+
+    uint32_t intFlags = static_cast<uint32_t>(readLittleEndian(binMessage.data() + kCommonFlagsOffset, sizeof(uint32_t)));
+
+    if (context::CommonFlags(intFlags).withCorrelationId())
+    {
+        if (binMessage.size() < kCorrelationIdOffset + sizeof(uint64_t))
+            return Status::ErrorOverflow;
+
+        return binMessage.replace(correlationIdBytes, sizeof(uint64_t), kCorrelationIdOffset);
+    }
+
+    AGS_CS_RUN(binMessage.insert(correlationIdBytes, sizeof(uint64_t), kCorrelationIdOffset));
+    writeLittleEndian(intFlags | context::CommonFlags::kCorrelationId, binMessage.data() + kCommonFlagsOffset, sizeof(uint32_t));
+
     return Status::NoError;
 }
 
+constexpr uint64_t ContextProcessor::readLittleEndian(const uint8_t* p, size_t size) noexcept
+{
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < size; ++i)
+        value |= static_cast<uint64_t>(p[i]) << (i * 8);
+
+    return value;
+}
+
+constexpr void ContextProcessor::writeLittleEndian(uint64_t value, uint8_t* p, size_t size) noexcept
+{
+    for (size_t i = 0; i < size; ++i)
+        p[i] = static_cast<uint8_t>(value >> (i * 8));
+}
+
 } // namespace common_serialization::csp::processing::common
@@ -65,6 +65,17 @@ public:
     template<typename T>
     static constexpr Status deserialize(context::DData& ctx, T& value);
 
+    /// @brief Deserializes array of objects that are already constructed
+    /// @note In contrast to deserialize(ctx, n, p) objects are not constructed again,
+    ///     so storage that they own may be reused. Binary format is the same.
+    /// @tparam T Type of array elements
+    /// @param ctx CSP Full Data Context
+    /// @param n Number of elements
+    /// @param p Pointer to first element
+    /// @return Status of operation
+    template<typename T>
+    static constexpr Status deserializeInPlace(context::DData& ctx, csp_size_t n, T* p);
+
     template<typename T>
     static AGS_CS_ALWAYS_INLINE constexpr Status deserializeSizeT(context::DData& ctx, T& value);
 
@@ -77,6 +88,15 @@ public:
     template<typename T>
     static AGS_CS_ALWAYS_INLINE constexpr Status deserializeFromAnotherSize(csp_size_t originalTypeSize, context::DData& ctx, T& value);
 
+    /// @brief Test that array of T would be processed as raw data with current context settings
+    /// @note Arrays of integers that are not fixed sized are still prepended by size of integer
+    ///     when sizeOfIntegersMayBeNotEqual() is set.
+    /// @tparam T Type of array elements
+    /// @param ctx CSP Full Data Context
+    /// @return Flag indicating that array would be copied as is
+    template<typename T, bool serializing>
+    static AGS_CS_ALWAYS_INLINE constexpr [[nodiscard]] bool isRawDataProcessingApplicable(const context::Data<serializing>& ctx) noexcept;
+
 protected:
     template<csp_size_t targetTypeSize, typename T>
     static constexpr Status serializeToAnotherSizeInternal(T value, context::SData& ctx);
@@ -98,6 +118,10 @@ protected:
     static AGS_CS_ALWAYS_INLINE Status templateProcessorSerializationWrapper(const T<Ts...>& value, context::SData& ctx);
     template<template<typename...> typename T, typename... Ts>
     static AGS_CS_ALWAYS_INLINE Status templateProcessorDeserializationWrapper(context::DData& ctx, T<Ts...>& value);
+    template<template<typename, size_t> typename T, typename U, size_t N>
+    static AGS_CS_ALWAYS_INLINE Status templateProcessorSerializationWrapper(const T<U, N>& value, context::SData& ctx);
+    template<template<typename, size_t> typename T, typename U, size_t N>
+    static AGS_CS_ALWAYS_INLINE Status templateProcessorDeserializationWrapper(context::DData& ctx, T<U, N>& value);
 
 private:
     static constexpr size_t kMaxSizeOfIntegral = 8;   // maximum allowed size of integral type
@@ -151,6 +175,21 @@ consteval interface_version_t getLatestInterfaceVersion()
         return 0;
 }
 
+template<typename T, bool serializing>
+constexpr bool BodyProcessor::isRawDataProcessingApplicable(const context::Data<serializing>& ctx) noexcept
+{
+    return (!ctx.endiannessDifference() || EndiannessTolerant<T>)
+        && (   std::is_arithmetic_v<T>
+            || std::is_enum_v<T>
+            || !ctx.simplyAssignableTagsOptimizationsAreTurnedOff()
+                && (!ISerializableImpl<T> || getLatestInterfaceVersion<T>() <= ctx.getInterfaceVersion())
+                && (   AlwaysSimplyAssignable<T>
+                    || SimplyAssignableFixedSize<T> && !ctx.alignmentMayBeNotEqual()
+                    || SimplyAssignableAlignedToOne<T> && !ctx.sizeOfIntegersMayBeNotEqual()
+                    || SimplyAssignable<T> && !ctx.alignmentMayBeNotEqual() && !ctx.sizeOfIntegersMayBeNotEqual())
+            );
+}
+
 template<typename T>
 constexpr Status BodyProcessor::serialize(const T* p, csp_size_t n, context::SData& ctx)
 {
@@ -165,18 +204,7 @@ constexpr Status BodyProcessor::serialize(const T* p, csp_size_t n, context::SDa
     if constexpr (EmptyType<T>)
         return Status::NoError;
 
-    if (
-           (!ctx.endiannessDifference() || EndiannessTolerant<T>)
-        && (   std::is_arithmetic_v<T>
-            || std::is_enum_v<T>
-            || !ctx.simplyAssignableTagsOptimizationsAreTurnedOff()
-                && (!ISerializableImpl<T> || getLatestInterfaceVersion<T>() <= ctx.getInterfaceVersion())
-                && (   AlwaysSimplyAssignable<T>
-                    || SimplyAssignableFixedSize<T> && !ctx.alignmentMayBeNotEqual()
-                    || SimplyAssignableAlignedToOne<T> && !ctx.sizeOfIntegersMayBeNotEqual()
-                    || SimplyAssignable<T> && !ctx.alignmentMayBeNotEqual() && !ctx.sizeOfIntegersMayBeNotEqual())
-            )
-    )
+    if (isRawDataProcessingApplicable<T>(ctx))
     {   
         if constexpr ((std::is_integral_v<T> || std::is_enum_v<T>) && !FixSizedArithmeticOrEnumType<T>)
             if (ctx.sizeOfIntegersMayBeNotEqual())
@@ -249,7 +277,7 @@ constexpr Status BodyProcessor::serialize(const T& value, context::SData& ctx)
         return serializeSimplyAssignable(value, ctx);
     else if constexpr (EmptyType<T>)
         return Status::NoError;
-    else if constexpr (!ISerializableImpl<T> && is_template_v<T>)
+    else if constexpr (!ISerializableImpl<T> && (is_template_v<T> || is_sized_template_v<T>))
         return templateProcessorSerializationWrapper(value, ctx);
     else
         static_assert("Type has no applicable function for serialization");
@@ -312,18 +340,7 @@ constexpr Status BodyProcessor::deserialize(context::DData& ctx, csp_size_t n, T
     if constexpr (EmptyType<T>)
         return Status::NoError;
 
-    if (
-           (!ctx.endiannessDifference() || EndiannessTolerant<T>)
-        && (   std::is_arithmetic_v<T>
-            || std::is_enum_v<T>
-            || !ctx.simplyAssignableTagsOptimizationsAreTurnedOff()
-                && (!ISerializableImpl<T> || getLatestInterfaceVersion<T>() <= ctx.getInterfaceVersion())
-                && (   AlwaysSimplyAssignable<T>
-                    || SimplyAssignableFixedSize<T> && !ctx.alignmentMayBeNotEqual()
-                    || SimplyAssignableAlignedToOne<T> && !ctx.sizeOfIntegersMayBeNotEqual()
-                    || SimplyAssignable<T> && !ctx.alignmentMayBeNotEqual() && !ctx.sizeOfIntegersMayBeNotEqual())
-            )
-    )
+    if (isRawDataProcessingApplicable<T>(ctx))
     {
         // In fact ctx.sizeOfIntegersMayBeNotEqual() can be true only if (std::is_arithmetic_v<T> || std::is_enum_v<T>) is true,
         // but if we do not wrap this in constexpr statement, all SimplyAssignable types would be forced to have deserialize functions
@@ -361,6 +378,26 @@ constexpr Status BodyProcessor::deserialize(context::DData& ctx, csp_size_t n, T
     }
 }
 
+template<typename T>
+constexpr Status BodyProcessor::deserializeInPlace(context::DData& ctx, csp_size_t n, T* p)
+{
+    assert(p && n > 0 || n == 0);
+
+    // Raw data path does not construct objects
+    if (isRawDataProcessingApplicable<T>(ctx))
+        return deserialize(ctx, n, p);
+
+    for (csp_size_t i = 0; i < n; ++i)
+    {
+        if (ctx.checkRecursivePointers())
+            (*ctx.getPointersMap())[ctx.getBinaryData().tell()] = const_cast<from_ptr_to_const_to_ptr_t<T*>>(&p[i]);
+
+        AGS_CS_RUN(deserialize(ctx, p[i]));
+    }
+
+    return Status::NoError;
+}
+
 // common function for arrays
 template<typename T, csp_size_t N>
 constexpr Status BodyProcessor::deserialize(context::DData& ctx, T(&arr)[N])
@@ -428,7 +465,7 @@ constexpr Status BodyProcessor::deserialize(context::DData& ctx, T& value)
         return deserializeSimplyAssignable(ctx, value);
     else if constexpr (EmptyType<T>)
         return Status::NoError;
-    else if constexpr (!ISerializableImpl<T> && is_template_v<T>)
+    else if constexpr (!ISerializableImpl<T> && (is_template_v<T> || is_sized_template_v<T>))
         return templateProcessorDeserializationWrapper(ctx, value);
     else
         static_assert("Type has no applicable function for deserialization");
@@ -622,6 +659,18 @@ AGS_CS_ALWAYS_INLINE Status BodyProcessor::templateProcessorDeserializationWrapp
     return TemplateProcessor<T<Ts...>, Ts...>::deserialize(ctx, value);
 }
 
+template<template<typename, size_t> typename T, typename U, size_t N>
+AGS_CS_ALWAYS_INLINE Status BodyProcessor::templateProcessorSerializationWrapper(const T<U, N>& value, context::SData& ctx)
+{
+    return TemplateProcessor<T<U, N>, U>::serialize(value, ctx);
+}
+
+template<template<typename, size_t> typename T, typename U, size_t N>
+AGS_CS_ALWAYS_INLINE Status BodyProcessor::templateProcessorDeserializationWrapper(context::DData& ctx, T<U, N>& value)
+{
+    return TemplateProcessor<T<U, N>, U>::deserialize(ctx, value);
+}
+
 } // namespace common_serialization::csp::processing::data
 
 #define CSP_SERIALIZE_ANY_SIMPLY_ASSIGNABLE(value, ctx)                                 \
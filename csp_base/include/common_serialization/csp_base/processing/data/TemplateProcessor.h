@@ -42,6 +42,9 @@ public:
 
     static Status deserialize(context::DData& ctx, VectorT<T, Ts...>& value)
     {
+        if (ctx.isExistingElementsReused() && !BodyProcessor::isRawDataProcessingApplicable<T>(ctx))
+            return deserializeReusingElements(ctx, value);
+
         value.clear();
 
         typename VectorT<T, Ts...>::size_type size = 0;
@@ -50,6 +53,26 @@ public:
         AGS_CS_RUN(BodyProcessor::deserialize(ctx, size, value.data()));
         value.m_dataSize = size;
 
+        return Status::NoError;
+    }
+
+private:
+    /// @brief Deserializes into elements that are already alive and constructs only missing ones
+    static Status deserializeReusingElements(context::DData& ctx, VectorT<T, Ts...>& value)
+    {
+        typename VectorT<T, Ts...>::size_type size = 0;
+        AGS_CS_RUN(BodyProcessor::deserializeSizeT(ctx, size));
+
+        if (value.size() > size)
+            AGS_CS_RUN(value.erase(size, value.size() - size));
+
+        AGS_CS_RUN(value.reserve(size));
+
+        typename VectorT<T, Ts...>::size_type reused = value.size();
+        AGS_CS_RUN(BodyProcessor::deserializeInPlace(ctx, reused, value.data()));
+        AGS_CS_RUN(BodyProcessor::deserialize(ctx, size - reused, value.data() + reused));
+        value.m_dataSize = size;
+
         return Status::NoError;
     }
 };
@@ -93,4 +93,42 @@ TEST(BasicModeTests, DiamondT)
     mainTest<Diamond<>>();
 }
 
+TEST(BasicModeTests, ReuseExistingElements)
+{
+    VectorT<VectorT<uint32_t>> input;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        VectorT<uint32_t> item;
+        EXPECT_EQ(item.pushBack(i), Status::NoError);
+        EXPECT_EQ(item.pushBack(i * 10), Status::NoError);
+        EXPECT_EQ(input.pushBack(std::move(item)), Status::NoError);
+    }
+
+    BinWalkerT bin;
+    csp::context::SData ctxIn(bin.getVector());
+    EXPECT_EQ(csp::processing::data::BodyProcessor::serialize(input, ctxIn), Status::NoError);
+
+    VectorT<VectorT<uint32_t>> output;
+    csp::context::DData ctxOut(bin);
+    ctxOut.setExistingElementsReuse(true);
+    EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, output), Status::NoError);
+    EXPECT_EQ(input, output);
+
+    const uint32_t* pItemData = output[0].data();
+
+    bin.seek(0);
+    EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, output), Status::NoError);
+    EXPECT_EQ(input, output);
+    EXPECT_EQ(output[0].data(), pItemData);
+
+    // Extra elements must be destroyed
+    EXPECT_EQ(input.erase(1), Status::NoError);
+    bin.clear();
+    EXPECT_EQ(csp::processing::data::BodyProcessor::serialize(input, ctxIn), Status::NoError);
+
+    EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, output), Status::NoError);
+    EXPECT_EQ(input, output);
+    EXPECT_EQ(output[0].data(), pItemData);
+}
+
 } // namespace
@@ -0,0 +1,210 @@
+/**
+ * @file common_serialization/csp_messaging/AdmissionController.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <common_serialization/csp_base/types.h>
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
+
+namespace common_serialization::csp::messaging
+{
+
+/// @brief Limits number of data messages that Server handles at the same time
+/// @details Message is admitted only when it fits in all limits that apply to it:
+///     global one, limit of its priority lane and limit of its handler (by input type Id).
+///     Priority lane of message is defined by Id of interface of its input type.
+///     Every lane has its own limit, so to keep capacity for latency-critical interfaces
+///     lanes of the rest ones must be limited below global limit.
+///     Messages that are not admitted are rejected with ErrorBusy.
+///     Admission is lock-free.
+/// @note Limits must be set before Server starts handling messages
+class AdmissionController
+{
+public:
+    enum class Priority : uint8_t
+    {
+        High,
+        Normal,
+        Low
+    };
+
+    static constexpr size_t kPrioritiesCount = 3;
+
+    /// @brief Limit value that means no limit
+    static constexpr uint32_t kUnlimited = 0;
+
+    /// @brief Global, priority lane and handler limits
+    static constexpr size_t kLimitsPerMessage = 3;
+
+    /// @brief Admission of message that holds its places in limits until it is destroyed
+    class Ticket
+    {
+    public:
+        Ticket() = default;
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+        ~Ticket() noexcept { release(); }
+
+        void release() noexcept;
+
+    private:
+        friend class AdmissionController;
+
+        AtomicUint32T* m_pCounters[kLimitsPerMessage]{};
+    };
+
+    /// @brief Set limit of messages handled at the same time
+    /// @param maxConcurrent Maximum number of messages or kUnlimited
+    void setGlobalLimit(uint32_t maxConcurrent) noexcept;
+
+    /// @brief Set limit of messages of priority lane handled at the same time
+    /// @param priority Priority lane
+    /// @param maxConcurrent Maximum number of messages or kUnlimited
+    void setPriorityLimit(Priority priority, uint32_t maxConcurrent) noexcept;
+
+    /// @brief Set limit of messages of handler handled at the same time
+    /// @param inputTypeId Id of handler input type
+    /// @param maxConcurrent Maximum number of messages or kUnlimited
+    void setHandlerLimit(const Id& inputTypeId, uint32_t maxConcurrent) noexcept;
+
+    /// @brief Put all messages with inputs of interface in priority lane
+    /// @note Messages of interfaces that are not set here are in Normal lane
+    /// @param interfaceId Interface Id
+    /// @param priority Priority lane
+    void setInterfacePriority(const Id& interfaceId, Priority priority) noexcept;
+
+    /// @brief Get priority lane of interface
+    /// @param interfaceId Interface Id
+    /// @return Priority lane
+    [[nodiscard]] Priority getInterfacePriority(const Id& interfaceId) const noexcept;
+
+    /// @brief Admit message for handling
+    /// @param interfaceId Id of interface of message input type
+    /// @param inputTypeId Id of message input type
+    /// @param ticket Admission that must be kept until message is handled
+    /// @return Status of operation. If any of limits is reached ErrorBusy is returned.
+    Status admit(const Id& interfaceId, const Id& inputTypeId, Ticket& ticket) noexcept;
+
+    /// @brief Get number of messages that are handled now
+    /// @return Number of messages
+    [[nodiscard]] uint32_t getInFlightCount() const noexcept;
+
+private:
+    struct Limit
+    {
+        uint32_t maxConcurrent{ kUnlimited };
+        AtomicUint32T inFlight{ 0 };
+    };
+
+    static bool tryAcquire(Limit& limit) noexcept;
+
+    Limit m_global;
+    Limit m_priorities[kPrioritiesCount];
+    HashMapT<Id, Limit> m_handlers;
+    HashMapT<Id, Priority> m_interfacePriorities;
+};
+
+inline void AdmissionController::Ticket::release() noexcept
+{
+    for (auto& pCounter : m_pCounters)
+        if (pCounter)
+        {
+            pCounter->fetch_sub(1, std::memory_order_release);
+            pCounter = nullptr;
+        }
+}
+
+inline void AdmissionController::setGlobalLimit(uint32_t maxConcurrent) noexcept
+{
+    m_global.maxConcurrent = maxConcurrent;
+}
+
+inline void AdmissionController::setPriorityLimit(Priority priority, uint32_t maxConcurrent) noexcept
+{
+    m_priorities[static_cast<size_t>(priority)].maxConcurrent = maxConcurrent;
+}
+
+inline void AdmissionController::setHandlerLimit(const Id& inputTypeId, uint32_t maxConcurrent) noexcept
+{
+    m_handlers[inputTypeId].maxConcurrent = maxConcurrent;
+}
+
+inline void AdmissionController::setInterfacePriority(const Id& interfaceId, Priority priority) noexcept
+{
+    m_interfacePriorities[interfaceId] = priority;
+}
+
+inline AdmissionController::Priority AdmissionController::getInterfacePriority(const Id& interfaceId) const noexcept
+{
+    auto it = m_interfacePriorities.find(interfaceId);
+
+    return it != m_interfacePriorities.end() ? it->second : Priority::Normal;
+}
+
+inline Status AdmissionController::admit(const Id& interfaceId, const Id& inputTypeId, Ticket& ticket) noexcept
+{
+    ticket.release();
+
+    Limit* limits[kLimitsPerMessage]{ &m_global, &m_priorities[static_cast<size_t>(getInterfacePriority(interfaceId))], nullptr };
+
+    if (auto it = m_handlers.find(inputTypeId); it != m_handlers.end())
+        limits[2] = &it->second;
+
+    for (size_t i = 0; i < kLimitsPerMessage; ++i)
+    {
+        if (!limits[i])
+            continue;
+
+        // Places that are already taken are returned by ticket
+        if (!tryAcquire(*limits[i]))
+        {
+            ticket.release();
+            return Status::ErrorBusy;
+        }
+
+        ticket.m_pCounters[i] = &limits[i]->inFlight;
+    }
+
+    return Status::NoError;
+}
+
+inline uint32_t AdmissionController::getInFlightCount() const noexcept
+{
+    return m_global.inFlight.load(std::memory_order_relaxed);
+}
+
+inline bool AdmissionController::tryAcquire(Limit& limit) noexcept
+{
+    // Counter may exceed limit for a moment, but message is admitted only when it is in limit
+    uint32_t inFlight = limit.inFlight.fetch_add(1, std::memory_order_acquire);
+
+    if (limit.maxConcurrent != kUnlimited && inFlight >= limit.maxConcurrent)
+    {
+        limit.inFlight.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace common_serialization::csp::messaging
@@ -23,18 +23,25 @@
 
 #pragma once
 
+#include <common_serialization/concurrency_interfaces/GuardRW.h>
+#include <common_serialization/csp_base/processing/batch/ContextProcessor.h>
 #include <common_serialization/csp_base/processing/common/ContextProcessor.h>
 #include <common_serialization/csp_base/processing/data/BodyProcessor.h>
 #include <common_serialization/csp_base/processing/data/ContextProcessor.h>
 #include <common_serialization/csp_base/processing/status/Helpers.h>
+#include <common_serialization/csp_messaging/ClientSettingsCache.h>
 #include <common_serialization/csp_messaging/IClientDataHandlerTraits.h>
+#include <common_serialization/csp_messaging/ThreadLocalLease.h>
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
 #include <common_serialization/csp_messaging/service_structs/structs.h>
 
+#include <coroutine>
 
 namespace common_serialization::csp::messaging
 {
 
 using IClientToServerCommunicator = IIoProcessor<BinVectorT, BinVectorT>;
+using IAsyncClientToServerCommunicator = IAsyncIoProcessor<BinVectorT, BinVectorT>;
 
 /// @brief Common CSP Client
 /// @details See documentation of CSP
@@ -68,6 +75,22 @@ public:
     /// @note Once valid settings are installed Client can't be reinited anymore
     Status init(const service_structs::CspPartySettings<>& clientSettings, service_structs::CspPartySettings<>& serverSettings) noexcept;
 
+    /// @brief Init by settings that were negotiated with the same server before, without round-trips to it
+    /// @details If cache has settings negotiated for clientSettings with server, they are installed
+    ///     and data requests are sent immediately. Otherwise settings are negotiated
+    ///     as by init(clientSettings, serverSettings) and are put in cache.
+    ///     If server rejects handleData() request of Client inited by cached settings with
+    ///     ErrorNotSupportedProtocolVersion or ErrorNotSupportedInterfaceVersion,
+    ///     settings are renegotiated, cache is updated and request is sent once again.
+    ///     Until first successful handleData() requests of such Client are processed one at a time.
+    /// @param clientSettings Client settings
+    /// @param serverId Identity of server (see ClientSettingsCache)
+    /// @param cache Cache of negotiated settings
+    /// @return Status of operation
+    /// @note Cache must be valid all the time when Client is used.
+    ///     Once valid settings are installed Client can't be reinited anymore.
+    Status init(const service_structs::CspPartySettings<>& clientSettings, const Id& serverId, ClientSettingsCache& cache) noexcept;
+
     /// @brief Is Client valid for operations with Server
     /// @return True if valid, false otherwise
     /// @note Client is valid as long as installed settings are valid.
@@ -91,16 +114,25 @@ public:
     Status getServerSettings(protocol_version_t serverCspVersion, service_structs::CspPartySettings<>& serverSettings) const noexcept;
 
     /// @brief Get server handler minimum supported interface version and ID of its output type
+    /// @details Settings received from server are cached by input type,
+    ///     so only first call for every input type makes request to server
     /// @param minimumInterfaceVersion Minimum supported interface version
     /// @param outputTypeId Handler output type
     /// @return Status of operation
     template<ISerializableImpl InputType>
     Status getServerHandlerSettings(interface_version_t& minimumInterfaceVersion, Id& outputTypeId) const noexcept;
 
+    /// @brief Drop all server handler settings that were cached by getServerHandlerSettings()
+    /// @note Use it when server handlers may be changed
+    void clearServerHandlerSettingsCache() noexcept;
+
     /// @brief Get settings installed in current Client instance
     /// @return Client settings
     constexpr const service_structs::CspPartySettings<>& getSettings() const noexcept;
 
+    /// @brief Get negotiated version of interface
+    /// @param id Interface ID
+    /// @return Interface version or traits::kInterfaceVersionUndefined if interface is not supported
     constexpr interface_version_t getInterfaceVersion(const Id& id) const noexcept;
 
     /// @brief Send input data to server(s) and get output data on response
@@ -146,12 +178,258 @@ public:
     Status handleData(const typename Cht::InputType& input, typename Cht::OutputType& output, context::CommonFlags additionalCommonFlags
         , context::DataFlags additionalDataFlags, VectorT<GenericPointerKeeperT>* pUnmanagedPointers = nullptr);
 
+    /// @brief Set communicator that is used by asynchronous handleData versions
+    /// @note Must be set before asynchronous requests are made and must be valid all the time when Client is used.
+    ///     If it is not set, asynchronous requests are processed by IClientToServerCommunicator
+    ///     and completed before return from starting function.
+    /// @param pCommunicator Asynchronous communicator
+    AGS_CS_ALWAYS_INLINE void setAsyncClientToServerCommunicator(IAsyncClientToServerCommunicator* pCommunicator) noexcept;
+    AGS_CS_ALWAYS_INLINE IAsyncClientToServerCommunicator* getAsyncClientToServerCommunicator() const noexcept;
+
+    template<IClientDataHandlerTraitsImpl Cht>
+    class DataAwaitable;
+
+    /// @brief Asynchronous version of handleData() with callback
+    /// @details Input is serialized before return, and callback is called with operation status
+    ///     when response from server is deserialized into output
+    /// @note Output and pUnmanagedPointers must stay valid until callback is called
+    /// @param input Struct that must be sent to server
+    /// @param output Struct that is returned from server
+    /// @param callback Function that is called with Status of operation
+    /// @param additionalCommonFlags Common flags that must be applied to current operation
+    /// @param additionalDataFlags Data flags that must be applied to current operation
+    /// @param pUnmanagedPointers Pointer on unmanaged pointers that were received on output struct deserialization
+    /// @return Status of request start. If it is not successful callback will not be called.
+    template<IClientDataHandlerTraitsImpl Cht, typename Callback>
+        requires std::is_invocable_v<Callback, Status>
+    Status handleDataAsync(const typename Cht::InputType& input, typename Cht::OutputType& output, Callback&& callback
+        , context::CommonFlags additionalCommonFlags = {}, context::DataFlags additionalDataFlags = {}, VectorT<GenericPointerKeeperT>* pUnmanagedPointers = nullptr);
+
+    /// @brief Asynchronous version of handleData() for coroutines
+    /// @details Usage: Status status = co_await client.handleDataAwaitable<Cht>(input, output);
+    /// @note Output and pUnmanagedPointers must stay valid until awaiting is done
+    /// @param input Struct that must be sent to server
+    /// @param output Struct that is returned from server
+    /// @param additionalCommonFlags Common flags that must be applied to current operation
+    /// @param additionalDataFlags Data flags that must be applied to current operation
+    /// @param pUnmanagedPointers Pointer on unmanaged pointers that were received on output struct deserialization
+    /// @return Awaitable object which result is Status of operation
+    template<IClientDataHandlerTraitsImpl Cht>
+    DataAwaitable<Cht> handleDataAwaitable(const typename Cht::InputType& input, typename Cht::OutputType& output
+        , context::CommonFlags additionalCommonFlags = {}, context::DataFlags additionalDataFlags = {}, VectorT<GenericPointerKeeperT>* pUnmanagedPointers = nullptr);
+
+    class DataBatch;
+
+    /// @brief Serialize input data into batch that will be sent to server by handleBatch()
+    /// @details All inputs of batch share the same Common Context and are sent in one Batch message,
+    ///     which saves on per-message overhead when there are many small requests
+    /// @param batch Batch of requests
+    /// @param input Struct that must be sent to server
+    /// @param additionalDataFlags Data flags that must be applied to current input
+    /// @return Status of operation
+    template<IClientDataHandlerTraitsImpl Cht>
+    Status addToBatch(DataBatch& batch, const typename Cht::InputType& input, context::DataFlags additionalDataFlags = {}) const;
+
+    /// @brief Send all inputs of batch to server in one message and receive responses on them
+    /// @param batch Batch of requests
+    /// @return Status of operation. Statuses of every single request are returned by getBatchOutput().
+    Status handleBatch(DataBatch& batch);
+
+    /// @brief Get output on request from batch which response was received by handleBatch()
+    /// @param batch Batch of requests
+    /// @param index Index of request in order of addToBatch() calls
+    /// @param output Struct that is returned from server
+    ///     (use ISerializableDummy<> if no output data is expected)
+    /// @param pUnmanagedPointers Pointer on unmanaged pointers that were received on output struct deserialization
+    /// @return Status of request handling
+    template<IClientDataHandlerTraitsImpl Cht>
+    Status getBatchOutput(DataBatch& batch, csp_size_t index, typename Cht::OutputType& output, VectorT<GenericPointerKeeperT>* pUnmanagedPointers = nullptr) const;
+
 private:
+    /// @brief State of data request that is shared by its serialization and response deserialization
+    template<IClientDataHandlerTraitsImpl Cht>
+    struct DataRequest
+    {
+        DataRequest(typename Cht::OutputType& output, VectorT<GenericPointerKeeperT>* pUnmanagedPointers) noexcept
+            : output(output), pUnmanagedPointers(pUnmanagedPointers)
+        { }
+
+        BinVectorT binInput;
+        BinWalkerT binOutput;
+        context::CommonFlags commonFlags;
+        uint64_t correlationId{ 0 };
+        context::DataFlags dataFlags;
+        interface_version_t targetInterfaceVersion{ traits::kInterfaceVersionUndefined };
+        typename Cht::OutputType& output;
+        VectorT<GenericPointerKeeperT>* pUnmanagedPointers{ nullptr };
+    };
+
+    /// @brief Check that data request can be sent and get interface version of it
+    template<IClientDataHandlerTraitsImpl Cht>
+    Status getDataRequestInterfaceVersion(interface_version_t& targetInterfaceVersion) const noexcept;
+
+    /// @brief Serialize Data Context and body of data request
+    template<IClientDataHandlerTraitsImpl Cht>
+    Status serializeDataRequestPrivateParts(const typename Cht::InputType& input, context::SData& ctxIn) const;
+
+    class DataBuffersLease;
+
+    /// @brief Serialize data request input into request.binInput
+    template<IClientDataHandlerTraitsImpl Cht>
+    Status serializeDataRequest(const typename Cht::InputType& input, context::CommonFlags additionalCommonFlags
+        , context::DataFlags additionalDataFlags, DataRequest<Cht>& request) const;
+
+    /// @brief Deserialize server response from request.binOutput into request.output
+    template<IClientDataHandlerTraitsImpl Cht>
+    Status deserializeDataResponse(DataRequest<Cht>& request) const;
+
+    /// @brief Deserialize private parts of server response on data request
+    template<IClientDataHandlerTraitsImpl Cht>
+    Status deserializeDataResponsePrivateParts(context::DCommon& ctxOutCommon, context::DataFlags dataFlags, interface_version_t targetInterfaceVersion
+        , typename Cht::OutputType& output, VectorT<GenericPointerKeeperT>* pUnmanagedPointers) const;
+
+    /// @brief Serialize data request, send it to server and deserialize response
+    template<IClientDataHandlerTraitsImpl Cht>
+    Status processDataRequest(const typename Cht::InputType& input, typename Cht::OutputType& output, context::CommonFlags additionalCommonFlags
+        , context::DataFlags additionalDataFlags, VectorT<GenericPointerKeeperT>* pUnmanagedPointers);
+
+    /// @brief Process data request of Client which cached settings are not confirmed by server yet
+    template<IClientDataHandlerTraitsImpl Cht>
+    Status processUnconfirmedDataRequest(const typename Cht::InputType& input, typename Cht::OutputType& output, context::CommonFlags additionalCommonFlags
+        , context::DataFlags additionalDataFlags, VectorT<GenericPointerKeeperT>* pUnmanagedPointers);
+
+    /// @brief Check that settings are confirmed by server
+    /// @note Settings which are not confirmed must be locked by m_unconfirmedSettingsMutex while used,
+    ///     so that they are not renegotiated meanwhile
+    /// @return True if settings are confirmed
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] bool isSettingsConfirmed() const noexcept;
+
+    /// @brief Replace cached settings by ones negotiated with server
+    /// @note If negotiation fails, previous settings are kept
+    Status renegotiateSettings() noexcept;
+
+    /// @brief Send request using asynchronous communicator if it is set or synchronous one otherwise
+    Status processAsync(const BinVectorT& binInput, BinVectorT& binOutput, IAsyncClientToServerCommunicator::ICompletion& completion);
+
+    struct InterfaceVersionEntry
+    {
+        Id id;
+        interface_version_t version{ traits::kInterfaceVersionUndefined };
+    };
+
+    struct ServerHandlerSettingsEntry
+    {
+        Id inputTypeId;
+        interface_version_t minimumInterfaceVersion{ traits::kInterfaceVersionUndefined };
+        Id outputTypeId;
+    };
+
+    /// @brief Fill lookup table of negotiated interfaces versions sorted by ID
+    Status initInterfaceVersions() noexcept;
+
+    /// @brief Find cached server handler settings
+    /// @return True if settings were found
+    bool findServerHandlerSettings(const Id& inputTypeId, interface_version_t& minimumInterfaceVersion, Id& outputTypeId) const noexcept;
+    void addServerHandlerSettings(const Id& inputTypeId, interface_version_t minimumInterfaceVersion, const Id& outputTypeId) const noexcept;
+
+    IAsyncClientToServerCommunicator* m_pAsyncClientToServerCommunicator{ nullptr };
+    mutable AtomicUint64T m_nextCorrelationId{ 1 };
     service_structs::CspPartySettings<> m_settings;
+    RawVectorT<InterfaceVersionEntry> m_interfaceVersions;
+    mutable RawVectorT<ServerHandlerSettingsEntry> m_serverHandlerSettingsCache;
+    mutable SharedMutexT m_serverHandlerSettingsCacheMutex;
     IClientToServerCommunicator& m_clientToServerCommunicator;
+
+    // Set only when Client is inited by cached settings
+    ClientSettingsCache* m_pSettingsCache{ nullptr };
+    Id m_serverId;
+    uint64_t m_clientSettingsHash{ 0 };
+    service_structs::CspPartySettings<> m_clientSettings;
+    AtomicBoolT m_isSettingsConfirmed{ true };
+    mutable MutexT m_unconfirmedSettingsMutex;
+
     bool m_isValid{ false };
 };
 
+/// @brief Lends buffers of current thread to synchronous data request for the time of its processing
+/// @details Buffers are taken from ThreadLocalLease, so their capacity persists between requests
+///     of the same thread and steady-state requests are not allocating memory for them.
+///     To not hold memory after rare big requests, every kShrinkPeriod requests buffers
+///     which capacity is more than twice of the largest size used in that period are shrunk to it.
+/// @note When request is made from inside of another one on the same thread,
+///     the nested request uses its own buffers.
+class Client::DataBuffersLease
+{
+public:
+    static constexpr uint32_t kShrinkPeriod = 1024;
+    static constexpr size_t kMinShrinkCapacity = 4096;
+
+    DataBuffersLease(BinVectorT& binInput, BinWalkerT& binOutput) noexcept
+        : m_binInput(binInput), m_binOutput(binOutput)
+    {
+        ThreadBuffers& buffers = m_lease.get();
+
+        m_binInput = std::move(buffers.binInput);
+        m_binOutput.init(std::move(buffers.binOutput));
+    }
+
+    DataBuffersLease(const DataBuffersLease&) = delete;
+    DataBuffersLease& operator=(const DataBuffersLease&) = delete;
+
+    ~DataBuffersLease()
+    {
+        // Buffers are cleared by lease when it ends
+        ThreadBuffers& buffers = m_lease.get();
+
+        buffers.binInput = std::move(m_binInput);
+        buffers.binOutput = std::move(m_binOutput.getVector());
+    }
+
+private:
+    struct ThreadBuffers
+    {
+        BinVectorT binInput;
+        BinVectorT binOutput;
+        size_t inputHighWaterMark{ 0 };
+        size_t outputHighWaterMark{ 0 };
+        uint32_t requestsCount{ 0 };
+
+        void clear() noexcept
+        {
+            inputHighWaterMark = std::max(inputHighWaterMark, binInput.size());
+            outputHighWaterMark = std::max(outputHighWaterMark, binOutput.size());
+
+            binInput.clear();
+            binOutput.clear();
+
+            if (++requestsCount == kShrinkPeriod)
+            {
+                shrink(binInput, inputHighWaterMark);
+                shrink(binOutput, outputHighWaterMark);
+
+                inputHighWaterMark = 0;
+                outputHighWaterMark = 0;
+                requestsCount = 0;
+            }
+        }
+    };
+
+    static void shrink(BinVectorT& buffer, size_t highWaterMark) noexcept
+    {
+        if (buffer.capacity() <= kMinShrinkCapacity || buffer.capacity() <= 2 * highWaterMark)
+            return;
+
+        buffer.invalidate();
+
+        // If there is no memory now, buffer will grow on next request
+        buffer.reserve(highWaterMark);
+    }
+
+    BinVectorT& m_binInput;
+    BinWalkerT& m_binOutput;
+    ThreadLocalLease<ThreadBuffers> m_lease;
+};
+
 inline Client::Client(IClientToServerCommunicator& communicator)
     : m_clientToServerCommunicator(communicator)
 {
@@ -172,8 +450,10 @@ inline Status Client::init(const service_structs::CspPartySettings<>& settings)
         return Status::ErrorInvalidArgument;
 
     m_settings.clear();
+    clearServerHandlerSettingsCache();
 
     AGS_CS_RUN(m_settings.init(settings));
+    AGS_CS_RUN(initInterfaceVersions());
 
     m_isValid = m_settings.isValid();
 
@@ -189,6 +469,7 @@ inline Status Client::init(const service_structs::CspPartySettings<>& clientSett
         return Status::ErrorInvalidArgument;
 
     m_settings.clear();
+    clearServerHandlerSettingsCache();
 
     RawVectorT<protocol_version_t> serverCspVersions;
     AGS_CS_RUN(getServerProtocolVersions(serverCspVersions));
@@ -220,12 +501,48 @@ inline Status Client::init(const service_structs::CspPartySettings<>& clientSett
 
     AGS_CS_RUN(getServerSettings(tempServerProtocolVersion, serverSettings));
     AGS_CS_RUN(m_settings.getCompatibleSettings(clientSettings, serverSettings));
+    AGS_CS_RUN(initInterfaceVersions());
 
     m_isValid = m_settings.isValid();
 
     return m_isValid ? Status::NoError : Status::ErrorNotInited;
 }
 
+inline Status Client::init(const service_structs::CspPartySettings<>& clientSettings, const Id& serverId, ClientSettingsCache& cache) noexcept
+{
+    if (isValid())
+        return Status::ErrorAlreadyInited;
+
+    if (!clientSettings.isValid())
+        return Status::ErrorInvalidArgument;
+
+    uint64_t clientSettingsHash = 0;
+    AGS_CS_RUN(ClientSettingsCache::getSettingsHash(clientSettings, clientSettingsHash));
+
+    service_structs::CspPartySettings<> cachedSettings;
+
+    if (!cache.find(serverId, clientSettingsHash, cachedSettings))
+    {
+        service_structs::CspPartySettings<> serverSettings;
+        AGS_CS_RUN(init(clientSettings, serverSettings));
+
+        // Cache is only an optimization, so failure to add settings to it is not an error
+        cache.insert(serverId, clientSettingsHash, m_settings);
+
+        return Status::NoError;
+    }
+
+    AGS_CS_RUN(m_clientSettings.init(clientSettings));
+    AGS_CS_RUN(init(cachedSettings));
+
+    m_pSettingsCache = &cache;
+    m_serverId = serverId;
+    m_clientSettingsHash = clientSettingsHash;
+    m_isSettingsConfirmed.store(false, std::memory_order_release);
+
+    return Status::NoError;
+}
+
 AGS_CS_ALWAYS_INLINE bool Client::isValid() const noexcept
 {
     return m_isValid;
@@ -280,6 +597,8 @@ inline Status Client::getServerSettings(protocol_version_t serverCspVersion, ser
 template<ISerializableImpl InputType>
 Status Client::getServerHandlerSettings(interface_version_t& minimumInterfaceVersion, Id& outputTypeId) const noexcept
 {
+    WGuard settingsGuard(m_unconfirmedSettingsMutex, isSettingsConfirmed());
+
     if (!isValid())
         return Status::ErrorNotInited;
 
@@ -288,6 +607,9 @@ Status Client::getServerHandlerSettings(interface_version_t& minimumInterfaceVer
     if (getInterfaceVersion(interface_.m_id) == traits::kInterfaceVersionUndefined)
         return Status::ErrorNotSupportedInterface;
 
+    if (findServerHandlerSettings(InputType::getId(), minimumInterfaceVersion, outputTypeId))
+        return Status::NoError;
+
     BinVectorT binInput;
     context::SData ctxIn(binInput, m_settings.getLatestProtocolVersion(), m_settings.getMandatoryCommonFlags());
 
@@ -311,7 +633,17 @@ Status Client::getServerHandlerSettings(interface_version_t& minimumInterfaceVer
     else if (statusOut != Status::ErrorNotSupportedInterfaceVersion)
         return statusOut;
     
-    return processing::status::BodyProcessor::deserializeErrorNotSupportedInterfaceVersion(ctxOut, minimumInterfaceVersion, outputTypeId);
+    AGS_CS_RUN(processing::status::BodyProcessor::deserializeErrorNotSupportedInterfaceVersion(ctxOut, minimumInterfaceVersion, outputTypeId));
+
+    addServerHandlerSettings(InputType::getId(), minimumInterfaceVersion, outputTypeId);
+
+    return Status::NoError;
+}
+
+inline void Client::clearServerHandlerSettingsCache() noexcept
+{
+    WGuard guard(m_serverHandlerSettingsCacheMutex);
+    m_serverHandlerSettingsCache.clear();
 }
 
 AGS_CS_ALWAYS_INLINE constexpr const service_structs::CspPartySettings<>& Client::getSettings() const noexcept
@@ -321,11 +653,66 @@ AGS_CS_ALWAYS_INLINE constexpr const service_structs::CspPartySettings<>& Client
 
 constexpr interface_version_t Client::getInterfaceVersion(const Id& id) const noexcept
 {
+    const InterfaceVersionEntry* pBegin = m_interfaceVersions.data();
+    const InterfaceVersionEntry* pEnd = pBegin + m_interfaceVersions.size();
+
+    const InterfaceVersionEntry* pEntry = std::lower_bound(pBegin, pEnd, id, [](const InterfaceVersionEntry& entry, const Id& id) { return entry.id < id; });
+
+    return pEntry != pEnd && pEntry->id == id ? pEntry->version : traits::kInterfaceVersionUndefined;
+}
+
+inline Status Client::initInterfaceVersions() noexcept
+{
+    m_interfaceVersions.clear();
+    AGS_CS_RUN(m_interfaceVersions.reserve(m_settings.getInterfaces().size()));
+
     for (const auto& interface_ : m_settings.getInterfaces())
-        if (id == interface_.m_id)
-            return interface_.m_version;
+    {
+        InterfaceVersionEntry* pBegin = m_interfaceVersions.data();
+        InterfaceVersionEntry* pEnd = pBegin + m_interfaceVersions.size();
+        InterfaceVersionEntry* pPosition = std::lower_bound(pBegin, pEnd, interface_.m_id, [](const InterfaceVersionEntry& entry, const Id& id) { return entry.id < id; });
+
+        AGS_CS_RUN(m_interfaceVersions.insert({ interface_.m_id, interface_.m_version }, pPosition - pBegin));
+    }
 
-    return traits::kInterfaceVersionUndefined;
+    return Status::NoError;
+}
+
+inline bool Client::findServerHandlerSettings(const Id& inputTypeId, interface_version_t& minimumInterfaceVersion, Id& outputTypeId) const noexcept
+{
+    RGuard guard(m_serverHandlerSettingsCacheMutex);
+
+    const ServerHandlerSettingsEntry* pBegin = m_serverHandlerSettingsCache.data();
+    const ServerHandlerSettingsEntry* pEnd = pBegin + m_serverHandlerSettingsCache.size();
+
+    const ServerHandlerSettingsEntry* pEntry = std::lower_bound(pBegin, pEnd, inputTypeId
+        , [](const ServerHandlerSettingsEntry& entry, const Id& id) { return entry.inputTypeId < id; });
+
+    if (pEntry == pEnd || pEntry->inputTypeId != inputTypeId)
+        return false;
+
+    minimumInterfaceVersion = pEntry->minimumInterfaceVersion;
+    outputTypeId = pEntry->outputTypeId;
+
+    return true;
+}
+
+inline void Client::addServerHandlerSettings(const Id& inputTypeId, interface_version_t minimumInterfaceVersion, const Id& outputTypeId) const noexcept
+{
+    WGuard guard(m_serverHandlerSettingsCacheMutex);
+
+    ServerHandlerSettingsEntry* pBegin = m_serverHandlerSettingsCache.data();
+    ServerHandlerSettingsEntry* pEnd = pBegin + m_serverHandlerSettingsCache.size();
+
+    ServerHandlerSettingsEntry* pEntry = std::lower_bound(pBegin, pEnd, inputTypeId
+        , [](const ServerHandlerSettingsEntry& entry, const Id& id) { return entry.inputTypeId < id; });
+
+    // Another thread could already add the same settings
+    if (pEntry != pEnd && pEntry->inputTypeId == inputTypeId)
+        return;
+
+    // Cache is only an optimization, so failure to add settings to it is not an error
+    m_serverHandlerSettingsCache.insert({ inputTypeId, minimumInterfaceVersion, outputTypeId }, pEntry - pBegin);
 }
 
 template<IClientDataHandlerTraitsImpl Cht>
@@ -344,10 +731,220 @@ Status Client::handleData(const typename Cht::InputType& input, typename Cht::Ou
 template<IClientDataHandlerTraitsImpl Cht>
 Status Client::handleData(const typename Cht::InputType& input, typename Cht::OutputType& output, context::CommonFlags additionalCommonFlags
     , context::DataFlags additionalDataFlags, VectorT<GenericPointerKeeperT>* pUnmanagedPointers)
+{
+    if (!isSettingsConfirmed())
+        return processUnconfirmedDataRequest<Cht>(input, output, additionalCommonFlags, additionalDataFlags, pUnmanagedPointers);
+
+    return processDataRequest<Cht>(input, output, additionalCommonFlags, additionalDataFlags, pUnmanagedPointers);
+}
+
+template<IClientDataHandlerTraitsImpl Cht>
+Status Client::processDataRequest(const typename Cht::InputType& input, typename Cht::OutputType& output, context::CommonFlags additionalCommonFlags
+    , context::DataFlags additionalDataFlags, VectorT<GenericPointerKeeperT>* pUnmanagedPointers)
+{
+    DataRequest<Cht> request(output, pUnmanagedPointers);
+    DataBuffersLease buffersLease(request.binInput, request.binOutput);
+
+    AGS_CS_RUN(serializeDataRequest<Cht>(input, additionalCommonFlags, additionalDataFlags, request));
+    AGS_CS_RUN(m_clientToServerCommunicator.process(request.binInput, request.binOutput.getVector()));
+
+    return deserializeDataResponse<Cht>(request);
+}
+
+template<IClientDataHandlerTraitsImpl Cht>
+Status Client::processUnconfirmedDataRequest(const typename Cht::InputType& input, typename Cht::OutputType& output, context::CommonFlags additionalCommonFlags
+    , context::DataFlags additionalDataFlags, VectorT<GenericPointerKeeperT>* pUnmanagedPointers)
+{
+    WGuard guard(m_unconfirmedSettingsMutex);
+
+    // Settings could be confirmed while we were waiting for lock
+    if (m_isSettingsConfirmed.load(std::memory_order_relaxed))
+        return processDataRequest<Cht>(input, output, additionalCommonFlags, additionalDataFlags, pUnmanagedPointers);
+
+    Status status = processDataRequest<Cht>(input, output, additionalCommonFlags, additionalDataFlags, pUnmanagedPointers);
+
+    if (status == Status::ErrorNotSupportedProtocolVersion)
+    {
+        AGS_CS_RUN(renegotiateSettings());
+
+        status = processDataRequest<Cht>(input, output, additionalCommonFlags, additionalDataFlags, pUnmanagedPointers);
+    }
+    else if (status == Status::ErrorNotSupportedInterfaceVersion)
+    {
+        // Error may come from handler itself, so request is repeated only when cached interface version was stale
+        const Id& interfaceId = Cht::InputType::getInterface().m_id;
+        const interface_version_t cachedInterfaceVersion = getInterfaceVersion(interfaceId);
+
+        AGS_CS_RUN(renegotiateSettings());
+
+        if (getInterfaceVersion(interfaceId) != cachedInterfaceVersion)
+            status = processDataRequest<Cht>(input, output, additionalCommonFlags, additionalDataFlags, pUnmanagedPointers);
+    }
+    else if (statusSuccess(status))
+        m_isSettingsConfirmed.store(true, std::memory_order_release);
+
+    return status;
+}
+
+AGS_CS_ALWAYS_INLINE bool Client::isSettingsConfirmed() const noexcept
+{
+    return m_isSettingsConfirmed.load(std::memory_order_acquire);
+}
+
+inline Status Client::renegotiateSettings() noexcept
+{
+    m_pSettingsCache->erase(m_serverId, m_clientSettingsHash);
+
+    service_structs::CspPartySettings<> previousSettings;
+    AGS_CS_RUN(previousSettings.init(m_settings));
+
+    m_isValid = false;
+
+    service_structs::CspPartySettings<> serverSettings;
+
+    if (Status status = init(m_clientSettings, serverSettings); !statusSuccess(status))
+    {
+        // Client stays usable with previous settings and renegotiation is retried on next request
+        init(previousSettings);
+
+        return status;
+    }
+
+    // Settings are received from server, so they are confirmed now
+    m_isSettingsConfirmed.store(true, std::memory_order_release);
+
+    // Cache is only an optimization, so failure to add settings to it is not an error
+    m_pSettingsCache->insert(m_serverId, m_clientSettingsHash, m_settings);
+
+    return Status::NoError;
+}
+
+AGS_CS_ALWAYS_INLINE void Client::setAsyncClientToServerCommunicator(IAsyncClientToServerCommunicator* pCommunicator) noexcept
+{
+    m_pAsyncClientToServerCommunicator = pCommunicator;
+}
+
+AGS_CS_ALWAYS_INLINE IAsyncClientToServerCommunicator* Client::getAsyncClientToServerCommunicator() const noexcept
+{
+    return m_pAsyncClientToServerCommunicator;
+}
+
+/// @brief Awaitable that is returned by Client::handleDataAwaitable()
+/// @note All request state is kept inside of awaitable, that is in coroutine frame,
+///     so awaiting does not need any additional allocations
+template<IClientDataHandlerTraitsImpl Cht>
+class Client::DataAwaitable : private IAsyncClientToServerCommunicator::ICompletion
+{
+public:
+    DataAwaitable(Client& client, const typename Cht::InputType& input, typename Cht::OutputType& output
+        , context::CommonFlags additionalCommonFlags, context::DataFlags additionalDataFlags, VectorT<GenericPointerKeeperT>* pUnmanagedPointers) noexcept
+        : m_client(client), m_request(output, pUnmanagedPointers)
+    { 
+        WGuard settingsGuard(m_client.m_unconfirmedSettingsMutex, m_client.isSettingsConfirmed());
+        m_status = m_client.serializeDataRequest<Cht>(input, additionalCommonFlags, additionalDataFlags, m_request);
+    }
+
+    DataAwaitable(const DataAwaitable&) = delete;
+    DataAwaitable& operator=(const DataAwaitable&) = delete;
+
+    bool await_ready() const noexcept
+    {
+        return !statusSuccess(m_status);
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        m_handle = handle;
+
+        if (Status status = m_client.processAsync(m_request.binInput, m_request.binOutput.getVector(), *this); !statusSuccess(status))
+        {
+            m_status = status;
+            return false;
+        }
+
+        // If request is already completed we must not suspend, because no one will resume us
+        return !m_completed.exchange(true, std::memory_order_acq_rel);
+    }
+
+    Status await_resume() const noexcept
+    {
+        return m_status;
+    }
+
+private:
+    void complete(Status status) noexcept override
+    {
+        m_status = statusSuccess(status) ? m_client.deserializeDataResponse<Cht>(m_request) : status;
+
+        // If await_suspend is not finished yet it will see that request is completed and will not suspend
+        if (m_completed.exchange(true, std::memory_order_acq_rel))
+            m_handle.resume();
+    }
+
+    Client& m_client;
+    DataRequest<Cht> m_request;
+    std::coroutine_handle<> m_handle;
+    AtomicBoolT m_completed{ false };
+    Status m_status{ Status::NoError };
+};
+
+template<IClientDataHandlerTraitsImpl Cht, typename Callback>
+    requires std::is_invocable_v<Callback, Status>
+Status Client::handleDataAsync(const typename Cht::InputType& input, typename Cht::OutputType& output, Callback&& callback
+    , context::CommonFlags additionalCommonFlags, context::DataFlags additionalDataFlags, VectorT<GenericPointerKeeperT>* pUnmanagedPointers)
+{
+    // Request state must live until completion, so it is kept on heap and is destroyed by itself
+    class AsyncRequest : public IAsyncClientToServerCommunicator::ICompletion
+    {
+    public:
+        AsyncRequest(Client& client, typename Cht::OutputType& output, VectorT<GenericPointerKeeperT>* pUnmanagedPointers, Callback&& callback)
+            : m_client(client), m_request(output, pUnmanagedPointers), m_callback(std::forward<Callback>(callback))
+        { }
+
+        void complete(Status status) noexcept override
+        {
+            m_callback(statusSuccess(status) ? m_client.deserializeDataResponse<Cht>(m_request) : status);
+            delete this;
+        }
+
+        Client& m_client;
+        DataRequest<Cht> m_request;
+        std::decay_t<Callback> m_callback;
+    };
+
+    AsyncRequest* pRequest = new (std::nothrow) AsyncRequest(*this, output, pUnmanagedPointers, std::forward<Callback>(callback));
+    if (!pRequest)
+        return Status::ErrorNoMemory;
+
+    Status status = Status::NoError;
+
+    {
+        WGuard settingsGuard(m_unconfirmedSettingsMutex, isSettingsConfirmed());
+        status = serializeDataRequest<Cht>(input, additionalCommonFlags, additionalDataFlags, pRequest->m_request);
+    }
+
+    if (statusSuccess(status))
+        status = processAsync(pRequest->m_request.binInput, pRequest->m_request.binOutput.getVector(), *pRequest);
+
+    // On success request will be deleted on completion
+    if (!statusSuccess(status))
+        delete pRequest;
+
+    return status;
+}
+
+template<IClientDataHandlerTraitsImpl Cht>
+Client::DataAwaitable<Cht> Client::handleDataAwaitable(const typename Cht::InputType& input, typename Cht::OutputType& output
+    , context::CommonFlags additionalCommonFlags, context::DataFlags additionalDataFlags, VectorT<GenericPointerKeeperT>* pUnmanagedPointers)
+{
+    return DataAwaitable<Cht>(*this, input, output, additionalCommonFlags, additionalDataFlags, pUnmanagedPointers);
+}
+
+template<IClientDataHandlerTraitsImpl Cht>
+Status Client::getDataRequestInterfaceVersion(interface_version_t& targetInterfaceVersion) const noexcept
 {
     using InputType = typename Cht::InputType;
     using OutputType = typename Cht::OutputType;
-    constexpr bool kForTempUseHeap = Cht::kForTempUseHeap;
 
     static_assert(std::is_same_v<OutputType, service_structs::ISerializableDummy> || InputType::getInterface() == OutputType::getInterface(),
         "Input type and output type must have the same interface!");
@@ -356,19 +953,48 @@ Status Client::handleData(const typename Cht::InputType& input, typename Cht::Ou
         return Status::ErrorNotInited;
 
     const Interface& interface_ = InputType::getInterface();
-    interface_version_t targetInterfaceVersion = getInterfaceVersion(interface_.m_id);
+    targetInterfaceVersion = getInterfaceVersion(interface_.m_id);
 
     if (targetInterfaceVersion == traits::kInterfaceVersionUndefined)
         return Status::ErrorNotSupportedInterface;
     else if (InputType::getOriginPrivateVersion() > targetInterfaceVersion || OutputType::getOriginPrivateVersion() > targetInterfaceVersion)
         return Status::ErrorNotSupportedInterfaceVersion;
 
+    return Status::NoError;
+}
+
+template<IClientDataHandlerTraitsImpl Cht>
+Status Client::serializeDataRequestPrivateParts(const typename Cht::InputType& input, context::SData& ctxIn) const
+{
+    AGS_CS_RUN(processing::data::ContextProcessor::serialize<typename Cht::InputType>(ctxIn));
+
+    if (ctxIn.checkRecursivePointers())
+    {
+        context::SPointersMap pointersMap;
+        AGS_CS_RUN(processing::data::BodyProcessor::serialize(input, ctxIn.setPointersMap(&pointersMap)));
+        ctxIn.setPointersMap(nullptr);
+    }
+    else
+        AGS_CS_RUN(processing::data::BodyProcessor::serialize(input, ctxIn));
+
+    return Status::NoError;
+}
+
+template<IClientDataHandlerTraitsImpl Cht>
+Status Client::serializeDataRequest(const typename Cht::InputType& input, context::CommonFlags additionalCommonFlags
+    , context::DataFlags additionalDataFlags, DataRequest<Cht>& request) const
+{
+    using InputType = typename Cht::InputType;
+    constexpr bool kForTempUseHeap = Cht::kForTempUseHeap;
+
+    interface_version_t targetInterfaceVersion = traits::kInterfaceVersionUndefined;
+    AGS_CS_RUN(getDataRequestInterfaceVersion<Cht>(targetInterfaceVersion));
+
     if (additionalCommonFlags & m_settings.getForbiddenCommonFlags())
         return Status::ErrorNotCompatibleCommonFlagsSettings;
 
-    BinVectorT binInput;
     context::SData ctxIn(
-          binInput
+          request.binInput
         , m_settings.getLatestProtocolVersion()
         , m_settings.getMandatoryCommonFlags() | additionalCommonFlags
         , InputType::getEffectiveMandatoryDataFlags() | additionalDataFlags
@@ -376,29 +1002,46 @@ Status Client::handleData(const typename Cht::InputType& input, typename Cht::Ou
         , targetInterfaceVersion
         , nullptr);
 
+    if (ctxIn.withCorrelationId())
+        ctxIn.setCorrelationId(m_nextCorrelationId.fetch_add(1, std::memory_order_relaxed));
+
     AGS_CS_RUN(processing::common::ContextProcessor::serialize(ctxIn));
-    AGS_CS_RUN(processing::data::ContextProcessor::serialize<InputType>(ctxIn));
 
-    if (ctxIn.allowUnmanagedPointers() && pUnmanagedPointers == nullptr)
+    if (ctxIn.allowUnmanagedPointers() && request.pUnmanagedPointers == nullptr)
         return Status::ErrorInvalidArgument;
 
-    if (ctxIn.checkRecursivePointers())
-    {
-        context::SPointersMap pointersMap;
-        AGS_CS_RUN(processing::data::BodyProcessor::serialize(input, ctxIn.setPointersMap(&pointersMap)));
-    }
-    else
-        AGS_CS_RUN(processing::data::BodyProcessor::serialize(input, ctxIn));
+    AGS_CS_RUN(serializeDataRequestPrivateParts<Cht>(input, ctxIn));
 
-    BinWalkerT binOutput;
-    AGS_CS_RUN(m_clientToServerCommunicator.process(binInput, binOutput.getVector()));
+    request.commonFlags = ctxIn.getCommonFlags();
+    request.correlationId = ctxIn.getCorrelationId();
+    request.dataFlags = ctxIn.getDataFlags();
+    request.targetInterfaceVersion = targetInterfaceVersion;
 
-    context::DCommon ctxOutCommon(binOutput);
+    return Status::NoError;
+}
+
+template<IClientDataHandlerTraitsImpl Cht>
+Status Client::deserializeDataResponse(DataRequest<Cht>& request) const
+{
+    context::DCommon ctxOutCommon(request.binOutput);
     AGS_CS_RUN(processing::common::ContextProcessor::deserialize(ctxOutCommon));
 
-    if (ctxIn.getCommonFlags() != ctxOutCommon.getCommonFlags())
+    if (request.commonFlags != ctxOutCommon.getCommonFlags())
         return Status::ErrorNotCompatibleCommonFlagsSettings;
 
+    if (request.correlationId != ctxOutCommon.getCorrelationId())
+        return Status::ErrorDataCorrupted;
+
+    return deserializeDataResponsePrivateParts<Cht>(ctxOutCommon, request.dataFlags, request.targetInterfaceVersion, request.output, request.pUnmanagedPointers);
+}
+
+template<IClientDataHandlerTraitsImpl Cht>
+Status Client::deserializeDataResponsePrivateParts(context::DCommon& ctxOutCommon, context::DataFlags dataFlags, interface_version_t targetInterfaceVersion
+    , typename Cht::OutputType& output, VectorT<GenericPointerKeeperT>* pUnmanagedPointers) const
+{
+    using OutputType = typename Cht::OutputType;
+    constexpr bool kForTempUseHeap = Cht::kForTempUseHeap;
+
     switch (ctxOutCommon.getMessageType())
     {
     case context::Message::Data:
@@ -407,10 +1050,11 @@ Status Client::handleData(const typename Cht::InputType& input, typename Cht::Ou
         context::DData ctxOut(ctxOutCommon);
         AGS_CS_RUN(processing::data::ContextProcessor::deserializeNoChecks(ctxOut, outId));
 
-        if (ctxIn.getDataFlags() != ctxOut.getDataFlags())
+        if (dataFlags != ctxOut.getDataFlags())
             return Status::ErrorNotCompatibleDataFlagsSettings;
 
-        ctxIn.clear();
+        if (ctxOut.allowUnmanagedPointers() && pUnmanagedPointers == nullptr)
+            return Status::ErrorInvalidArgument;
 
         ctxOut.setAddedPointers(pUnmanagedPointers);
 
@@ -441,4 +1085,200 @@ Status Client::handleData(const typename Cht::InputType& input, typename Cht::Ou
     }
 }
 
+/// @brief Batch of data requests that are sent to server in one message by Client::handleBatch()
+/// @note Batch may be reused after Client::handleBatch() by calling clear(),
+///     which keeps allocated memory
+class Client::DataBatch
+{
+public:
+    /// @brief Constructor
+    /// @param additionalCommonFlags Common flags that must be applied to all requests of batch
+    explicit DataBatch(context::CommonFlags additionalCommonFlags = {}) noexcept
+        : m_additionalCommonFlags(additionalCommonFlags)
+    { }
+
+    /// @brief Remove all requests and responses from batch
+    void clear() noexcept
+    {
+        m_binInput.clear();
+        m_binOutput.clear();
+        m_items.clear();
+        m_isResponseReceived = false;
+    }
+
+    /// @brief Get number of requests in batch
+    /// @return Number of requests
+    [[nodiscard]] csp_size_t size() const noexcept
+    {
+        return m_items.size();
+    }
+
+private:
+    friend class Client;
+
+    struct Item
+    {
+        context::DataFlags dataFlags;
+        interface_version_t targetInterfaceVersion{ traits::kInterfaceVersionUndefined };
+        context::Message responseType{ context::Message::Status };
+        csp_size_t responseOffset{ 0 };
+    };
+
+    // Requests in batch share Common Context of Batch message, but correlation id belongs only to the whole message
+    [[nodiscard]] context::CommonFlags getItemCommonFlags() const noexcept
+    {
+        return context::CommonFlags{ static_cast<uint32_t>(m_commonFlags) & ~context::CommonFlags::kCorrelationId };
+    }
+
+    context::CommonFlags m_additionalCommonFlags;
+    context::CommonFlags m_commonFlags;
+    uint64_t m_correlationId{ 0 };
+    BinVectorT m_binInput;
+    BinWalkerT m_binOutput;
+    RawVectorT<Item> m_items;
+    bool m_isResponseReceived{ false };
+};
+
+template<IClientDataHandlerTraitsImpl Cht>
+Status Client::addToBatch(DataBatch& batch, const typename Cht::InputType& input, context::DataFlags additionalDataFlags) const
+{
+    using InputType = typename Cht::InputType;
+    constexpr bool kForTempUseHeap = Cht::kForTempUseHeap;
+
+    WGuard settingsGuard(m_unconfirmedSettingsMutex, isSettingsConfirmed());
+
+    interface_version_t targetInterfaceVersion = traits::kInterfaceVersionUndefined;
+    AGS_CS_RUN(getDataRequestInterfaceVersion<Cht>(targetInterfaceVersion));
+
+    if (batch.m_isResponseReceived)
+        return Status::ErrorInvalidArgument;
+
+    if (batch.m_items.size() == 0)
+    {
+        if (batch.m_additionalCommonFlags & m_settings.getForbiddenCommonFlags())
+            return Status::ErrorNotCompatibleCommonFlagsSettings;
+
+        batch.m_binInput.clear();
+
+        context::SCommon ctxBatch(batch.m_binInput, m_settings.getLatestProtocolVersion(), context::Message::Batch
+            , m_settings.getMandatoryCommonFlags() | batch.m_additionalCommonFlags);
+
+        if (ctxBatch.withCorrelationId())
+            ctxBatch.setCorrelationId(m_nextCorrelationId.fetch_add(1, std::memory_order_relaxed));
+
+        AGS_CS_RUN(processing::common::ContextProcessor::serialize(ctxBatch));
+
+        batch.m_commonFlags = ctxBatch.getCommonFlags();
+        batch.m_correlationId = ctxBatch.getCorrelationId();
+    }
+
+    const csp_size_t batchSize = batch.m_binInput.size();
+
+    context::SData ctxIn(
+          batch.m_binInput
+        , m_settings.getLatestProtocolVersion()
+        , batch.getItemCommonFlags()
+        , InputType::getEffectiveMandatoryDataFlags() | additionalDataFlags
+        , kForTempUseHeap
+        , targetInterfaceVersion
+        , nullptr);
+
+    csp_size_t sizeOffset = 0;
+    Status status = processing::batch::ContextProcessor::serializeItemBegin(ctxIn, context::Message::Data, sizeOffset);
+
+    if (statusSuccess(status))
+        status = serializeDataRequestPrivateParts<Cht>(input, ctxIn);
+    if (statusSuccess(status))
+        status = processing::batch::ContextProcessor::serializeItemEnd(ctxIn, sizeOffset);
+    if (statusSuccess(status))
+        status = batch.m_items.pushBack({ ctxIn.getDataFlags(), targetInterfaceVersion });
+
+    // Failed request must not stay in batch
+    if (!statusSuccess(status))
+        batch.m_binInput.setSize(batchSize);
+
+    return status;
+}
+
+inline Status Client::handleBatch(DataBatch& batch)
+{
+    if (batch.m_items.size() == 0 || batch.m_isResponseReceived)
+        return Status::ErrorInvalidArgument;
+
+    batch.m_binOutput.clear();
+    AGS_CS_RUN(m_clientToServerCommunicator.process(batch.m_binInput, batch.m_binOutput.getVector()));
+
+    context::DCommon ctxOutCommon(batch.m_binOutput);
+    AGS_CS_RUN(processing::common::ContextProcessor::deserialize(ctxOutCommon));
+
+    if (batch.m_commonFlags != ctxOutCommon.getCommonFlags())
+        return Status::ErrorNotCompatibleCommonFlagsSettings;
+
+    if (batch.m_correlationId != ctxOutCommon.getCorrelationId())
+        return Status::ErrorDataCorrupted;
+
+    if (ctxOutCommon.getMessageType() == context::Message::Status)
+    {
+        Status statusOut = Status::NoError;
+        AGS_CS_RUN(processing::status::ContextProcessor::deserialize(ctxOutCommon, statusOut));
+        return statusSuccess(statusOut) ? Status::ErrorDataCorrupted : statusOut;
+    }
+    else if (ctxOutCommon.getMessageType() != context::Message::Batch)
+        return Status::ErrorDataCorrupted;
+
+    // Only positions of responses are remembered here, they are deserialized by getBatchOutput()
+    BinWalkerT& binOutput = batch.m_binOutput;
+    csp_size_t index = 0;
+
+    while (binOutput.tell() < binOutput.size())
+    {
+        if (index == batch.m_items.size())
+            return Status::ErrorDataCorrupted;
+
+        context::Message itemType = context::Message::Status;
+        csp_size_t itemSize = 0;
+        AGS_CS_RUN(processing::batch::ContextProcessor::deserializeItem(ctxOutCommon, itemType, itemSize));
+
+        batch.m_items[index].responseType = itemType;
+        batch.m_items[index].responseOffset = binOutput.tell();
+
+        AGS_CS_RUN(binOutput.seek(binOutput.tell() + itemSize));
+        ++index;
+    }
+
+    if (index != batch.m_items.size())
+        return Status::ErrorDataCorrupted;
+
+    batch.m_isResponseReceived = true;
+
+    return Status::NoError;
+}
+
+template<IClientDataHandlerTraitsImpl Cht>
+Status Client::getBatchOutput(DataBatch& batch, csp_size_t index, typename Cht::OutputType& output, VectorT<GenericPointerKeeperT>* pUnmanagedPointers) const
+{
+    if (!batch.m_isResponseReceived || index >= batch.m_items.size())
+        return Status::ErrorInvalidArgument;
+
+    const typename DataBatch::Item& item = batch.m_items[index];
+
+    AGS_CS_RUN(batch.m_binOutput.seek(item.responseOffset));
+
+    WGuard settingsGuard(m_unconfirmedSettingsMutex, isSettingsConfirmed());
+
+    context::DCommon ctxOutCommon(batch.m_binOutput, m_settings.getLatestProtocolVersion(), item.responseType, batch.getItemCommonFlags());
+
+    return deserializeDataResponsePrivateParts<Cht>(ctxOutCommon, item.dataFlags, item.targetInterfaceVersion, output, pUnmanagedPointers);
+}
+
+inline Status Client::processAsync(const BinVectorT& binInput, BinVectorT& binOutput, IAsyncClientToServerCommunicator::ICompletion& completion)
+{
+    if (m_pAsyncClientToServerCommunicator)
+        return m_pAsyncClientToServerCommunicator->processAsync(binInput, binOutput, completion);
+
+    completion.complete(m_clientToServerCommunicator.process(binInput, binOutput));
+
+    return Status::NoError;
+}
+
 } // namespace common_serialization::csp::messaging
@@ -0,0 +1,219 @@
+/**
+ * @file common_serialization/csp_messaging/ClientSettingsCache.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <common_serialization/concurrency_interfaces/GuardRW.h>
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
+#include <common_serialization/csp_messaging/service_structs/structs.h>
+
+namespace common_serialization::csp::messaging
+{
+
+/// @brief Storage of settings negotiated by Client with servers
+/// @details Settings are keyed by server identity and hash of client settings,
+///     so changed client settings never get settings negotiated for old ones.
+///     Server identity is any Id that is stable for the same server (e.g. name-based UUID of its address).
+///     Cache may be saved to binary form and loaded back to outlive the process.
+///     Cache is thread-safe.
+class ClientSettingsCache
+{
+public:
+    /// @brief Get hash of client settings that is used as part of key
+    /// @param clientSettings Client settings
+    /// @param hash Hash of settings
+    /// @return Status of operation
+    static Status getSettingsHash(const service_structs::CspPartySettings<>& clientSettings, uint64_t& hash) noexcept;
+
+    /// @brief Find settings negotiated with server
+    /// @param serverId Server identity
+    /// @param settingsHash Hash of client settings
+    /// @param negotiatedSettings Negotiated settings
+    /// @return true if settings were found
+    bool find(const Id& serverId, uint64_t settingsHash, service_structs::CspPartySettings<>& negotiatedSettings) const noexcept;
+
+    /// @brief Put settings negotiated with server (existing ones are replaced)
+    /// @param serverId Server identity
+    /// @param settingsHash Hash of client settings
+    /// @param negotiatedSettings Negotiated settings
+    /// @return Status of operation
+    Status insert(const Id& serverId, uint64_t settingsHash, const service_structs::CspPartySettings<>& negotiatedSettings) noexcept;
+
+    /// @brief Remove settings negotiated with server
+    /// @param serverId Server identity
+    /// @param settingsHash Hash of client settings
+    void erase(const Id& serverId, uint64_t settingsHash) noexcept;
+
+    void clear() noexcept;
+
+    [[nodiscard]] size_t size() const noexcept;
+
+    /// @brief Save all cached settings to binary form
+    /// @note Binary form is in host byte order and is meant to be loaded on the same host.
+    ///     Data saved on host with other byte order is rejected by load() as having unknown format version.
+    /// @param output Output container
+    /// @return Status of operation
+    Status save(BinVectorT& output) const noexcept;
+
+    /// @brief Load settings saved by save()
+    /// @note Loaded settings are added to already cached ones
+    /// @param input Input container
+    /// @return Status of operation
+    Status load(BinWalkerT& input) noexcept;
+
+private:
+    static constexpr uint32_t kSavedFormatVersion = 1;
+
+    struct Entry
+    {
+        Id serverId;
+        uint64_t settingsHash{ 0 };
+        service_structs::CspPartySettings<> settings;
+    };
+
+    size_t findIndex(const Id& serverId, uint64_t settingsHash) const noexcept;
+
+    VectorT<Entry> m_entries;
+    mutable MutexT m_mutex;
+};
+
+inline Status ClientSettingsCache::getSettingsHash(const service_structs::CspPartySettings<>& clientSettings, uint64_t& hash) noexcept
+{
+    BinVectorT binSettings;
+    AGS_CS_RUN(clientSettings.serialize(binSettings));
+
+    hash = helpers::getFnv1aHash(binSettings.data(), binSettings.size());
+
+    return Status::NoError;
+}
+
+inline bool ClientSettingsCache::find(const Id& serverId, uint64_t settingsHash, service_structs::CspPartySettings<>& negotiatedSettings) const noexcept
+{
+    WGuard guard(m_mutex);
+
+    size_t index = findIndex(serverId, settingsHash);
+
+    return index != m_entries.size() && statusSuccess(negotiatedSettings.init(m_entries[index].settings));
+}
+
+inline Status ClientSettingsCache::insert(const Id& serverId, uint64_t settingsHash, const service_structs::CspPartySettings<>& negotiatedSettings) noexcept
+{
+    if (!negotiatedSettings.isValid())
+        return Status::ErrorInvalidArgument;
+
+    WGuard guard(m_mutex);
+
+    size_t index = findIndex(serverId, settingsHash);
+
+    if (index != m_entries.size())
+        return m_entries[index].settings.init(negotiatedSettings);
+
+    Entry entry{ serverId, settingsHash };
+    AGS_CS_RUN(entry.settings.init(negotiatedSettings));
+
+    return m_entries.pushBack(std::move(entry));
+}
+
+inline void ClientSettingsCache::erase(const Id& serverId, uint64_t settingsHash) noexcept
+{
+    WGuard guard(m_mutex);
+
+    if (size_t index = findIndex(serverId, settingsHash); index != m_entries.size())
+        m_entries.erase(index, 1);
+}
+
+inline void ClientSettingsCache::clear() noexcept
+{
+    WGuard guard(m_mutex);
+    m_entries.clear();
+}
+
+inline size_t ClientSettingsCache::size() const noexcept
+{
+    WGuard guard(m_mutex);
+    return m_entries.size();
+}
+
+inline Status ClientSettingsCache::save(BinVectorT& output) const noexcept
+{
+    WGuard guard(m_mutex);
+
+    AGS_CS_RUN(output.pushBackArithmeticValue(kSavedFormatVersion));
+    AGS_CS_RUN(output.pushBackArithmeticValue(static_cast<uint32_t>(m_entries.size())));
+
+    for (const Entry& entry : m_entries)
+    {
+        // Values are written in host byte order
+        AGS_CS_RUN(output.pushBackArithmeticValue(entry.serverId.m_high));
+        AGS_CS_RUN(output.pushBackArithmeticValue(entry.serverId.m_low));
+        AGS_CS_RUN(output.pushBackArithmeticValue(entry.settingsHash));
+        AGS_CS_RUN(entry.settings.serialize(output));
+    }
+
+    return Status::NoError;
+}
+
+inline Status ClientSettingsCache::load(BinWalkerT& input) noexcept
+{
+    uint32_t formatVersion = 0;
+    AGS_CS_RUN(input.readArithmeticValue(formatVersion));
+
+    if (formatVersion != kSavedFormatVersion)
+        return Status::ErrorNotSupportedInterfaceVersion;
+
+    uint32_t entriesCount = 0;
+    AGS_CS_RUN(input.readArithmeticValue(entriesCount));
+
+    for (uint32_t i = 0; i < entriesCount; ++i)
+    {
+        uint64_t serverIdHigh = 0;
+        uint64_t serverIdLow = 0;
+        uint64_t settingsHash = 0;
+        service_structs::CspPartySettings<> settings;
+
+        AGS_CS_RUN(input.readArithmeticValue(serverIdHigh));
+        AGS_CS_RUN(input.readArithmeticValue(serverIdLow));
+        AGS_CS_RUN(input.readArithmeticValue(settingsHash));
+        AGS_CS_RUN(settings.deserialize(input));
+
+        Id serverId;
+        serverId.m_high = serverIdHigh;
+        serverId.m_low = serverIdLow;
+
+        AGS_CS_RUN(insert(serverId, settingsHash, settings));
+    }
+
+    return Status::NoError;
+}
+
+inline size_t ClientSettingsCache::findIndex(const Id& serverId, uint64_t settingsHash) const noexcept
+{
+    // Client usually talks to a few servers, so linear search is the fastest here
+    for (size_t i = 0; i < m_entries.size(); ++i)
+        if (m_entries[i].settingsHash == settingsHash && m_entries[i].serverId == serverId)
+            return i;
+
+    return m_entries.size();
+}
+
+} // namespace common_serialization::csp::messaging
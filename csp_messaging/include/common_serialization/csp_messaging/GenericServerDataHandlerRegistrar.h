@@ -34,30 +34,71 @@ namespace common_serialization::csp::messaging
 class GenericServerDataHandlerRegistrar : public IServerDataHandlerRegistrar
 {
 public:
+    GenericServerDataHandlerRegistrar() = default;
+    GenericServerDataHandlerRegistrar(const GenericServerDataHandlerRegistrar&) = delete;
+    GenericServerDataHandlerRegistrar& operator=(const GenericServerDataHandlerRegistrar&) = delete;
+    ~GenericServerDataHandlerRegistrar() noexcept;
+
     Status registerHandler(const Id& id, bool kMulticast, Service* pService, IServerDataHandlerBase& handler) override;
     void unregisterHandler(const Id& id, IServerDataHandlerBase& handler) noexcept override;
     void unregisterService(Service* pService) noexcept override;
     Status aquireHandlers(const Id& id, RawVectorT<IServerDataHandlerBase*>& handlers) override;
     Status aquireHandler(const Id& id, IServerDataHandlerBase*& pHandler) noexcept override;
     void releaseHandler(IServerDataHandlerBase* pHandler) noexcept override;
+    Status getHandlersMetrics(VectorT<HandlerMetrics::Snapshot>& metrics) const override;
 
 private:
+    // In-use counter of every handler is split on shards that are placed on separate cache lines,
+    // so threads that simultaneously use the same handler are not contending on single atomic.
+    // Shard is chosen by thread, and handler may be released on other thread than it was aquired,
+    // therefore only sum of all shards (in modulo 2^32 arithmetic) is meaningful.
+    // Handler is released by decrementing of shard only, without registrar lock. Handler that is
+    // not active anymore can't be aquired, so its sum can only decrease, and unregistering
+    // routine sleeps until the sum is zero before handler removal. Releases wake it
+    // only while some unregistering routine is waiting.
+    struct alignas(64) InUseCounterShard
+    {
+        AtomicUint32T counter{ 0 };
+    };
+
+    static constexpr size_t kInUseCounterShardsCount = 16;
+
     struct SdhHandle : IServerDataHandlerBase
     {
         SdhHandle(Service* pService, IServerDataHandlerBase& handler)
             : pService(pService), handler(handler)
         { }
 
-        SdhHandle(SdhHandle&& rhs) noexcept
-            : pService(rhs.pService), handler(rhs.handler)
-            , inUseCounter(rhs.inUseCounter.load(std::memory_order_relaxed)), state(rhs.state)
-        { }
-
         Status handleDataCommon(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) override
         {
             return handler.handleDataCommon(ctx, clientId, binOutput);
         }
 
+        const Interface& getInputInterface() const noexcept override
+        {
+            return handler.getInputInterface();
+        }
+
+        Status checkSharedInputPolicies(const context::DData& ctx, const GenericPointerKeeperT& clientId) override
+        {
+            return handler.checkSharedInputPolicies(ctx, clientId);
+        }
+
+        Status deserializeSharedInput(context::DData& ctx, GenericPointerKeeperT& input, BinVectorT& binOutput) override
+        {
+            return handler.deserializeSharedInput(ctx, input, binOutput);
+        }
+
+        Status handleSharedInput(const GenericPointerKeeperT& input, context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) override
+        {
+            return handler.handleSharedInput(input, ctx, clientId, binOutput);
+        }
+
+        const HandlerMetrics& getMetrics() const noexcept override
+        {
+            return handler.getMetrics();
+        }
+
         enum class State
         {
             Active,
@@ -65,129 +106,207 @@ private:
             ServiceRemove
         };
 
+        AGS_CS_ALWAYS_INLINE void addUse() noexcept
+        {
+            inUseCounterShards[getInUseCounterShardIndex()].counter.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// @note Handle must not be touched after this call, because it may be already destroyed
+        AGS_CS_ALWAYS_INLINE void removeUse() noexcept
+        {
+            // Sequentially consistent, so either releaser sees waiting unregistering routine
+            // or unregistering routine sees this release
+            inUseCounterShards[getInUseCounterShardIndex()].counter.fetch_sub(1, std::memory_order_seq_cst);
+        }
+
+        /// @brief Get total number of handler users
+        /// @note Result may be not zero when handler is concurrently released,
+        ///     but it is never zero while handler is still in use, if handler is not active
+        ///     and so can't be aquired
+        /// @return Number of handler users
+        [[nodiscard]] uint32_t getInUseCount() const noexcept
+        {
+            uint32_t inUseCount = 0;
+
+            for (auto& shard : inUseCounterShards)
+                inUseCount += shard.counter.load(std::memory_order_seq_cst);
+
+            return inUseCount;
+        }
+
         Service* const pService{ nullptr };
         IServerDataHandlerBase& handler;
-        AtomicUint32T inUseCounter{ 0 };
+        InUseCounterShard inUseCounterShards[kInUseCounterShardsCount];
         State state{ State::Active };
     };
 
-    struct ToUnregisterHandler
-    {
-        ToUnregisterHandler(const Id& id, SdhHandle& handle)
-            : done(1), id(id), handle(handle)
-        { }
-       
-        mutable LatchT done{ 1 };
-        const Id& id;
-        SdhHandle& handle;
-    };
-
-    struct ToUnregisterService
+    // Handlers table is open addressing hash table with linear probing.
+    // Every bucket holds range of handles with the same id in m_handles,
+    // so all multicast handlers of id are placed contiguously.
+    // Handles itself are allocated separately, because pointers to them
+    // are given to users and must stay valid while table is changing.
+    struct Bucket
     {
-        ToUnregisterService(Service* pService, uint32_t inUseCounter)
-            : done(1), pService(pService), inUseCounter(inUseCounter)
-        { }
-
-        mutable LatchT done{ 1 };
-        Service* const pService{ nullptr };
-        AtomicUint32T inUseCounter{ 0 };
+        Id id;
+        uint32_t offset{ 0 };
+        uint32_t count{ 0 };    // empty bucket has zero count
     };
 
-    HashMultiMapT<Id, SdhHandle> m_handlerMap;
-    ListT<ToUnregisterService> m_unregisterServiceList;
-    ListT<ToUnregisterHandler> m_unregisterHandlerList;
-    mutable SharedMutexT m_handlerMapMutex;
+    static constexpr size_t kMinBucketsCount = 16;
+
+    static AGS_CS_ALWAYS_INLINE [[nodiscard]] size_t getInUseCounterShardIndex() noexcept;
+    static AGS_CS_ALWAYS_INLINE [[nodiscard]] size_t getBucketIndex(const Id& id, size_t bucketsCount) noexcept;
+
+    [[nodiscard]] const Bucket* findBucket(const Id& id) const noexcept;
+    [[nodiscard]] Bucket* findBucket(const Id& id) noexcept;
+    Status addBucket(const Id& id, uint32_t offset);
+    Status rehash(size_t bucketsCount);
+
+    /// @brief Remove handle from table and destroy it
+    /// @param bucketIndex Index of bucket which contains handle
+    /// @param handleIndex Index of handle in m_handles
+    /// @return True if bucket has been removed together with its last handle
+    bool removeHandle(size_t bucketIndex, uint32_t handleIndex) noexcept;
+
+    /// @brief Shift offsets of all buckets which ranges are placed after given offset
+    void shiftOffsets(uint32_t offset, int32_t shift) noexcept;
+
+    /// @brief Sleep without registrar lock until handles that are being removed are released
+    /// @param guard Guard of registrar lock, which is held on call and on return
+    /// @param isInUse Predicate that is checked under registrar lock
+    template<typename Pred>
+    void waitForRelease(WGuard<SharedMutexT>& guard, Pred isInUse) noexcept;
+
+    RawVectorT<Bucket> m_buckets;
+    RawVectorT<SdhHandle*> m_handles;
+    size_t m_idsCount{ 0 };
+    mutable SharedMutexT m_handlersMutex;
+
+    // Unregistering routines sleep on it until handlers are released
+    AtomicUint32T m_releaseWaitersCount{ 0 };
+    AtomicUint32T m_releasesCount{ 0 };
+    MutexT m_releaseMutex;
+    ConditionVariableT m_releaseCv;
 };
 
+inline GenericServerDataHandlerRegistrar::~GenericServerDataHandlerRegistrar() noexcept
+{
+    for (auto pHandle : m_handles)
+        delete pHandle;
+}
+
 inline Status GenericServerDataHandlerRegistrar::registerHandler(const Id& id, bool kMulticast, Service* pService, IServerDataHandlerBase& handler)
 {
-    WGuard guard(m_handlerMapMutex);
+    WGuard guard(m_handlersMutex);
+
+    Bucket* pBucket = findBucket(id);
 
-    if (!kMulticast && m_handlerMap.contains(id))
+    if (!kMulticast && pBucket)
     {
         assert(false);
         return Status::ErrorInvalidArgument;
     }
 
-    m_handlerMap.emplace(std::make_pair(id, SdhHandle{ pService, handler }));
+    UniquePtrT<SdhHandle> pHandle = makeUniqueNoThrow<SdhHandle>(pService, handler);
+    if (!pHandle)
+        return Status::ErrorNoMemory;
+
+    if (pBucket)
+    {
+        uint32_t handleIndex = pBucket->offset + pBucket->count;
+        AGS_CS_RUN(m_handles.insert(pHandle.get(), handleIndex));
+        shiftOffsets(pBucket->offset, 1);
+        ++pBucket->count;
+    }
+    else
+    {
+        AGS_CS_RUN(m_handles.pushBack(pHandle.get()));
+
+        if (Status status = addBucket(id, static_cast<uint32_t>(m_handles.size() - 1)); !statusSuccess(status))
+        {
+            m_handles.erase(m_handles.size() - 1);
+            return status;
+        }
+    }
+
+    (void)pHandle.release();
 
     return Status::NoError;
 }
 
 inline void GenericServerDataHandlerRegistrar::unregisterHandler(const Id& id, IServerDataHandlerBase& handler) noexcept
 {
-    WGuard guard(m_handlerMapMutex);
-    
-    auto range = m_handlerMap.equal_range(id);
-    while (range.first != range.second)
-        if (&range.first->second.handler == &handler)
+    WGuard guard(m_handlersMutex);
+
+    Bucket* pBucket = findBucket(id);
+    if (!pBucket)
+        return;
+
+    for (uint32_t i = pBucket->offset, end = pBucket->offset + pBucket->count; i < end; ++i)
+        if (SdhHandle& handle = *m_handles[i]; &handle.handler == &handler)
         {
-            bool deferred = false;
+            // Handler is already being removed by another unregister routine
+            if (handle.state != SdhHandle::State::Active)
+                break;
 
-            if (range.first->second.inUseCounter)
-            {
-                deferred = true;
-                range.first->second.state = SdhHandle::State::HandlerRemove;
-                m_unregisterHandlerList.emplace_front(range.first->first, range.first->second);
-                auto it = m_unregisterHandlerList.begin();
-                guard.unlock();
-                it->done.wait();
-                guard.lock();
-                m_unregisterHandlerList.erase(it);
-            }
-            
-            // If we've been waiting of releasing handler there can be possibility of map rehashing.
-            // If it is true, C++ standard say that all unordered_map iterators will be invalidated.
-            // So we can't just pass to erase function previously found iterator.
-            if (deferred)
+            // Once handler is not active it can't be aquired, so we only need to wait for its current users
+            if (handle.getInUseCount())
             {
-                auto newRange = m_handlerMap.equal_range(id);
-                while (newRange.first != newRange.second)
-                    if (&newRange.first->second.handler == &handler)
-                    {
-                        m_handlerMap.erase(newRange.first);
-                        break;
-                    }
-                    else
-                        ++newRange.first;
+                handle.state = SdhHandle::State::HandlerRemove;
+
+                waitForRelease(guard, [&handle]() noexcept { return handle.getInUseCount() != 0; });
+
+                // While we've been waiting, table could be changed, so we need to find handle again
+                pBucket = findBucket(id);
+                assert(pBucket);
+
+                for (i = pBucket->offset; m_handles[i] != &handle; ++i)
+                    assert(i + 1 < pBucket->offset + pBucket->count);
             }
-            else
-                m_handlerMap.erase(range.first);
+
+            removeHandle(pBucket - m_buckets.data(), i);
 
             break;
         }
-        else
-            ++range.first;
 }
 
 inline void GenericServerDataHandlerRegistrar::unregisterService(Service* pService) noexcept
 {
-    WGuard guard(m_handlerMapMutex);
+    WGuard guard(m_handlersMutex);
 
-    uint32_t totalInUseCounter = 0;
+    // Handlers which are already removing are left to their own unregister routine
+    for (auto pHandle : m_handles)
+        if (pHandle->pService == pService && pHandle->state == SdhHandle::State::Active)
+            pHandle->state = SdhHandle::State::ServiceRemove;
 
-    for (auto& pair : m_handlerMap)
-        if (pair.second.pService == pService)
-        {
-            pair.second.state = SdhHandle::State::ServiceRemove;
-            totalInUseCounter += pair.second.inUseCounter.load(std::memory_order_relaxed);
-        }
+    // Handles of service can't be removed by other routines, so they stay in table while we are waiting
+    auto isServiceInUse = [this, pService]() noexcept
+    {
+        for (auto pHandle : m_handles)
+            if (pHandle->pService == pService && pHandle->state == SdhHandle::State::ServiceRemove && pHandle->getInUseCount())
+                return true;
+
+        return false;
+    };
 
-    if (totalInUseCounter)
+    waitForRelease(guard, isServiceInUse);
+
+    // When bucket is removed, its place may be taken by the following one,
+    // so we must check the same bucket index again
+    for (size_t i = 0; i < m_buckets.size();)
     {
-        m_unregisterServiceList.emplace_front(pService, totalInUseCounter);
-        auto it = m_unregisterServiceList.begin();
-        guard.unlock();
-        it->done.wait();
-        guard.lock();
-        m_unregisterServiceList.erase(it);
-    }
+        bool bucketRemoved = false;
+
+        for (uint32_t j = m_buckets[i].count; j-- > 0 && !bucketRemoved;)
+            if (SdhHandle* pHandle = m_handles[m_buckets[i].offset + j]
+                ; pHandle->pService == pService && pHandle->state == SdhHandle::State::ServiceRemove)
+            {
+                bucketRemoved = removeHandle(i, m_buckets[i].offset + j);
+            }
 
-    for (auto it = m_handlerMap.begin(), itEnd = m_handlerMap.end(); it != itEnd;)
-        if (it->second.pService == pService)
-            it = m_handlerMap.erase(it);
-        else
-            ++it;
+        if (!bucketRemoved)
+            ++i;
+    }
 }
 
 inline Status GenericServerDataHandlerRegistrar::aquireHandlers(const Id& id, RawVectorT<IServerDataHandlerBase*>& handles)
@@ -197,28 +316,34 @@ inline Status GenericServerDataHandlerRegistrar::aquireHandlers(const Id& id, Ra
 
     handles.clear();
 
-    RGuard guard(m_handlerMapMutex);
+    RGuard guard(m_handlersMutex);
+
+    const Bucket* pBucket = findBucket(id);
+    if (!pBucket)
+        return Status::ErrorNoSuchHandler;
+
+    SdhHandle* const* pHandles = m_handles.data() + pBucket->offset;
 
-    for (auto range = m_handlerMap.equal_range(id); range.first != range.second; ++range.first)
+    for (uint32_t i = 0; i < pBucket->count; ++i)
     {
-        if (range.first->second.state != SdhHandle::State::Active)
+        if (pHandles[i]->state != SdhHandle::State::Active)
         {
             wasNotAvailable = true;
             continue;
         }
 
-        status = handles.pushBack(&range.first->second);
+        status = handles.pushBack(pHandles[i]);
         if (!statusSuccess(status))
         {
             for (auto& handle : handles)
-                reinterpret_cast<SdhHandle*>(handle)->inUseCounter.fetch_sub(1, std::memory_order_relaxed);;
+                static_cast<SdhHandle*>(handle)->removeUse();
 
             handles.clear();
 
             return status;
         }
 
-        range.first->second.inUseCounter.fetch_add(1, std::memory_order_relaxed);
+        pHandles[i]->addUse();
     }
 
     return handles.size() ? Status::NoError : wasNotAvailable ? Status::ErrorNotAvailible : Status::ErrorNoSuchHandler;
@@ -226,23 +351,23 @@ inline Status GenericServerDataHandlerRegistrar::aquireHandlers(const Id& id, Ra
 
 inline Status GenericServerDataHandlerRegistrar::aquireHandler(const Id& id, IServerDataHandlerBase*& pHandle) noexcept
 {
-    RGuard guard(m_handlerMapMutex);
+    RGuard guard(m_handlersMutex);
 
-    auto range = m_handlerMap.equal_range(id);
+    const Bucket* pBucket = findBucket(id);
 
-    if (range.first == range.second)
+    if (!pBucket)
         return Status::ErrorNoSuchHandler;
 
-    auto firstIt = range.first++;
-
-    if (range.first != range.second)
+    if (pBucket->count > 1)
         return Status::ErrorMoreEntires;
 
-    if (firstIt->second.state != SdhHandle::State::Active)
+    SdhHandle* pSdhHandle = m_handles[pBucket->offset];
+
+    if (pSdhHandle->state != SdhHandle::State::Active)
         return Status::ErrorNotAvailible;
 
-    pHandle = &firstIt->second;
-    reinterpret_cast<SdhHandle*>(pHandle)->inUseCounter.fetch_add(1, std::memory_order_relaxed);
+    pSdhHandle->addUse();
+    pHandle = pSdhHandle;
 
     return Status::NoError;
 }
@@ -251,43 +376,185 @@ inline void GenericServerDataHandlerRegistrar::releaseHandler(IServerDataHandler
 {
     assert(pHandle);
 
-    RGuard guard(m_handlerMapMutex);
+    static_cast<SdhHandle*>(pHandle)->removeUse();
 
-    SdhHandle& handle = *reinterpret_cast<SdhHandle*>(pHandle);
-    uint32_t prevUseCount = handle.inUseCounter.fetch_sub(1, std::memory_order_relaxed);
-
-    switch (handle.state)
-    {
-    case SdhHandle::State::ServiceRemove:
+    if (m_releaseWaitersCount.load(std::memory_order_seq_cst) != 0)
     {
-        for (auto& unregisterService : m_unregisterServiceList)
-            if (unregisterService.pService == handle.pService)
-            {
-                if (unregisterService.inUseCounter.fetch_sub(1, std::memory_order_acq_rel) == 1)
-                {
-                    guard.unlock();
-                    unregisterService.done.count_down();
-                }
-                break;
-            }
+        {
+            WGuard guard(m_releaseMutex);
+            m_releasesCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        m_releaseCv.notify_all();
     }
-    case SdhHandle::State::HandlerRemove:
+}
+
+inline Status GenericServerDataHandlerRegistrar::getHandlersMetrics(VectorT<HandlerMetrics::Snapshot>& metrics) const
+{
+    metrics.clear();
+
+    RGuard guard(m_handlersMutex);
+
+    AGS_CS_RUN(metrics.reserve(m_handles.size()));
+
+    for (const auto& bucket : m_buckets)
+        for (uint32_t i = bucket.offset; i < bucket.offset + bucket.count; ++i)
+        {
+            AGS_CS_RUN(metrics.pushBack(HandlerMetrics::Snapshot{}));
+
+            HandlerMetrics::Snapshot& snapshot = metrics[metrics.size() - 1];
+            snapshot.inputTypeId = bucket.id;
+            m_handles[i]->getMetrics().getSnapshot(snapshot);
+        }
+
+    return Status::NoError;
+}
+
+template<typename Pred>
+void GenericServerDataHandlerRegistrar::waitForRelease(WGuard<SharedMutexT>& guard, Pred isInUse) noexcept
+{
+    // Waiter is counted before handles are checked, so every release that happens after check wakes it
+    m_releaseWaitersCount.fetch_add(1, std::memory_order_seq_cst);
+
+    while (true)
     {
-        if (prevUseCount == 1)
+        const uint32_t releasesCount = m_releasesCount.load(std::memory_order_seq_cst);
+
+        if (!isInUse())
+            break;
+
+        guard.unlock();
+
         {
-            for (auto& unregisterHandler : m_unregisterHandlerList)
-                if (&unregisterHandler.handle.handler == &handle.handler)
-                {
-                    guard.unlock();
-                    unregisterHandler.done.count_down();
-                    break;
-                }
+            WGuard releaseGuard(m_releaseMutex);
+            m_releaseCv.wait(releaseGuard, [this, releasesCount] { return m_releasesCount.load(std::memory_order_relaxed) != releasesCount; });
         }
-        break;
+
+        guard.lock();
     }
-    default:
-        break;
+
+    m_releaseWaitersCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+AGS_CS_ALWAYS_INLINE size_t GenericServerDataHandlerRegistrar::getInUseCounterShardIndex() noexcept
+{
+    static AtomicUint32T nextShard{ 0 };
+    thread_local size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % kInUseCounterShardsCount;
+
+    return shard;
+}
+
+AGS_CS_ALWAYS_INLINE size_t GenericServerDataHandlerRegistrar::getBucketIndex(const Id& id, size_t bucketsCount) noexcept
+{
+    // Ids are UUIDv4, so their bits are already random and one multiplicative mix is enough
+    uint64_t hash = (id.m_high ^ id.m_low) * 0x9e3779b97f4a7c15;
+
+    return static_cast<size_t>(hash ^ hash >> 32) & (bucketsCount - 1);
+}
+
+inline const GenericServerDataHandlerRegistrar::Bucket* GenericServerDataHandlerRegistrar::findBucket(const Id& id) const noexcept
+{
+    size_t bucketsCount = m_buckets.size();
+    if (bucketsCount == 0)
+        return nullptr;
+
+    const Bucket* pBuckets = m_buckets.data();
+
+    for (size_t i = getBucketIndex(id, bucketsCount); pBuckets[i].count; i = (i + 1) & (bucketsCount - 1))
+        if (pBuckets[i].id == id)
+            return &pBuckets[i];
+
+    return nullptr;
+}
+
+inline GenericServerDataHandlerRegistrar::Bucket* GenericServerDataHandlerRegistrar::findBucket(const Id& id) noexcept
+{
+    return const_cast<Bucket*>(static_cast<const GenericServerDataHandlerRegistrar&>(*this).findBucket(id));
+}
+
+inline Status GenericServerDataHandlerRegistrar::addBucket(const Id& id, uint32_t offset)
+{
+    // Keep load factor no more than 1/2 for short probe sequences
+    if ((m_idsCount + 1) * 2 > m_buckets.size())
+        AGS_CS_RUN(rehash(m_buckets.size() ? m_buckets.size() * 2 : kMinBucketsCount));
+
+    size_t bucketsCount = m_buckets.size();
+    size_t i = getBucketIndex(id, bucketsCount);
+
+    while (m_buckets[i].count)
+        i = (i + 1) & (bucketsCount - 1);
+
+    m_buckets[i] = Bucket{ id, offset, 1 };
+    ++m_idsCount;
+
+    return Status::NoError;
+}
+
+inline Status GenericServerDataHandlerRegistrar::rehash(size_t bucketsCount)
+{
+    assert((bucketsCount & (bucketsCount - 1)) == 0);
+
+    RawVectorT<Bucket> newBuckets;
+    AGS_CS_RUN(newBuckets.reserve(bucketsCount));
+
+    for (size_t i = 0; i < bucketsCount; ++i)
+        AGS_CS_RUN(newBuckets.pushBack(Bucket{}));
+
+    for (const Bucket& bucket : m_buckets)
+        if (bucket.count)
+        {
+            size_t i = getBucketIndex(bucket.id, bucketsCount);
+
+            while (newBuckets[i].count)
+                i = (i + 1) & (bucketsCount - 1);
+
+            newBuckets[i] = bucket;
+        }
+
+    m_buckets = std::move(newBuckets);
+
+    return Status::NoError;
+}
+
+inline bool GenericServerDataHandlerRegistrar::removeHandle(size_t bucketIndex, uint32_t handleIndex) noexcept
+{
+    Bucket& bucket = m_buckets[bucketIndex];
+    assert(handleIndex >= bucket.offset && handleIndex < bucket.offset + bucket.count);
+
+    delete m_handles[handleIndex];
+    m_handles.erase(handleIndex);
+    shiftOffsets(bucket.offset, -1);
+
+    if (--bucket.count)
+        return false;
+
+    // Backward shift deletion, so that no tombstones are needed
+    size_t bucketsCount = m_buckets.size();
+    size_t hole = bucketIndex;
+
+    for (size_t i = (hole + 1) & (bucketsCount - 1); m_buckets[i].count; i = (i + 1) & (bucketsCount - 1))
+    {
+        size_t home = getBucketIndex(m_buckets[i].id, bucketsCount);
+
+        // Bucket may be moved to the hole only if its home is not in the cyclic range (hole, i]
+        if (((i - home) & (bucketsCount - 1)) >= ((i - hole) & (bucketsCount - 1)))
+        {
+            m_buckets[hole] = m_buckets[i];
+            hole = i;
+        }
     }
+
+    m_buckets[hole] = Bucket{};
+    --m_idsCount;
+
+    return true;
+}
+
+inline void GenericServerDataHandlerRegistrar::shiftOffsets(uint32_t offset, int32_t shift) noexcept
+{
+    for (Bucket& bucket : m_buckets)
+        if (bucket.count && bucket.offset > offset)
+            bucket.offset += shift;
 }
 
 } // namespace common_serialization::csp::messaging
@@ -0,0 +1,324 @@
+/**
+ * @file common_serialization/csp_messaging/HandlerMetrics.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <common_serialization/csp_base/types.h>
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+
+namespace common_serialization::csp::messaging
+{
+
+/// @brief Get number of current thread, by which metrics shard is chosen
+/// @details Threads are numbered in order of their first call, so while number of
+///     active threads is not greater than number of shards, every thread has its own one
+AGS_CS_ALWAYS_INLINE [[nodiscard]] size_t getMetricsThreadIndex() noexcept
+{
+    static AtomicUint32T nextIndex{ 0 };
+    thread_local size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+
+    return index;
+}
+
+/// @brief Lock-free histogram of latencies in nanoseconds
+/// @details Buckets are log-linear as in HDR histogram: every power of two range
+///     is split on kSubBucketsCount equal buckets, so relative error of value is within 1/kSubBucketsCount.
+///     Values from 2^kMaxValueBits are counted in the last bucket.
+///     Every thread records values in its own shard, so concurrent recording is not contending
+///     on the same cache lines. Snapshot is the merge of all shards.
+/// @note Histogram takes kShardsCount * kBucketsCount * 8 bytes (about 19 KB)
+class LatencyHistogram
+{
+public:
+    static constexpr uint32_t kSubBucketBits = 4;
+    static constexpr uint64_t kSubBucketsCount = 1 << kSubBucketBits;
+    static constexpr uint32_t kMaxValueBits = 40;
+    static constexpr size_t kBucketsCount = (kMaxValueBits - kSubBucketBits + 1) * kSubBucketsCount;
+    static constexpr size_t kShardsCount = 4;
+
+    /// @brief Copy of histogram state
+    struct Snapshot
+    {
+        uint64_t counts[kBucketsCount]{};
+        uint64_t count{ 0 };
+        uint64_t sum{ 0 };
+        uint64_t max{ 0 };
+
+        /// @brief Get value below which given part of values are
+        /// @param percentile Percentile in range [0, 100]
+        /// @return Upper bound of bucket of percentile
+        [[nodiscard]] uint64_t getPercentile(double percentile) const noexcept;
+
+        [[nodiscard]] uint64_t getMean() const noexcept;
+    };
+
+    /// @brief Get bucket of value
+    static constexpr [[nodiscard]] size_t getBucketIndex(uint64_t value) noexcept;
+
+    /// @brief Get the lowest value of bucket
+    static constexpr [[nodiscard]] uint64_t getBucketLowestValue(size_t index) noexcept;
+
+    AGS_CS_ALWAYS_INLINE void record(uint64_t value) noexcept;
+
+    /// @brief Copy current state of histogram
+    /// @note State is copied while values are recorded, so different fields
+    ///     may include slightly different sets of values
+    /// @param snapshot Snapshot of histogram
+    void getSnapshot(Snapshot& snapshot) const noexcept;
+
+private:
+    struct alignas(64) Shard
+    {
+        AtomicUint64T counts[kBucketsCount]{};
+        AtomicUint64T sum{ 0 };
+        AtomicUint64T max{ 0 };
+    };
+
+    Shard m_shards[kShardsCount];
+};
+
+/// @brief Lock-free counters of data handler
+/// @details Counted are requests, errors by Status, bytes of input and output messages
+///     and latencies of input deserialization, handling and output serialization.
+///     Responses that are taken from cache of idempotent handler have no latencies.
+///     Counters and latencies that are updated on every request are split on shards by threads.
+/// @note Metrics are kept in every handler and take about 60 KB, most of which are latency histograms
+class HandlerMetrics
+{
+public:
+    enum class Phase : uint8_t
+    {
+        Deserialize,
+        Handle,
+        Serialize
+    };
+
+    static constexpr size_t kPhasesCount = 3;
+
+    /// @brief Errors with codes out of this range are counted as ErrorInternal
+    static constexpr size_t kErrorsCount = 32;
+
+    /// @brief Copy of handler metrics
+    struct Snapshot
+    {
+        /// @brief Id of handler input type
+        Id inputTypeId;
+        uint64_t requests{ 0 };
+        uint64_t bytesIn{ 0 };
+        uint64_t bytesOut{ 0 };
+        uint64_t errors[kErrorsCount]{};
+        LatencyHistogram::Snapshot latencies[kPhasesCount];
+
+        [[nodiscard]] uint64_t getErrorsCount(Status status) const noexcept
+        {
+            return statusSuccess(status) ? 0 : errors[getErrorIndex(status)];
+        }
+
+        [[nodiscard]] uint64_t getErrorsCount() const noexcept
+        {
+            uint64_t count = 0;
+
+            for (auto errorsCount : errors)
+                count += errorsCount;
+
+            return count;
+        }
+
+        [[nodiscard]] const LatencyHistogram::Snapshot& getLatencies(Phase phase) const noexcept
+        {
+            return latencies[static_cast<size_t>(phase)];
+        }
+    };
+
+    /// @brief Get current time for latencies measurement
+    /// @return Time in nanoseconds
+    static AGS_CS_ALWAYS_INLINE [[nodiscard]] uint64_t now() noexcept;
+
+    AGS_CS_ALWAYS_INLINE void addRequest(size_t bytesIn) noexcept;
+    AGS_CS_ALWAYS_INLINE void addResponse(Status status, size_t bytesOut) noexcept;
+    AGS_CS_ALWAYS_INLINE void addLatency(Phase phase, uint64_t start) noexcept;
+
+    /// @brief Copy current metrics without stopping their update
+    /// @param snapshot Snapshot of metrics (inputTypeId is not changed)
+    void getSnapshot(Snapshot& snapshot) const noexcept;
+
+private:
+    static constexpr [[nodiscard]] size_t getErrorIndex(Status status) noexcept
+    {
+        size_t index = static_cast<size_t>(-static_cast<int64_t>(status));
+
+        return index < kErrorsCount ? index : static_cast<size_t>(-static_cast<int32_t>(Status::ErrorInternal));
+    }
+
+    // Every thread updates its own shard, so concurrent requests of handler are not
+    // contending on the same cache line. Snapshot is the sum of all shards.
+    struct alignas(64) CountersShard
+    {
+        AtomicUint64T requests{ 0 };
+        AtomicUint64T bytesIn{ 0 };
+        AtomicUint64T bytesOut{ 0 };
+    };
+
+    static constexpr size_t kCountersShardsCount = 16;
+
+    CountersShard m_counters[kCountersShardsCount];
+    AtomicUint64T m_errors[kErrorsCount]{};
+    LatencyHistogram m_latencies[kPhasesCount];
+};
+
+inline uint64_t LatencyHistogram::Snapshot::getPercentile(double percentile) const noexcept
+{
+    if (count == 0)
+        return 0;
+
+    // Nearest rank
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count)));
+    target = std::clamp<uint64_t>(target, 1, count);
+    uint64_t cumulative = 0;
+
+    for (size_t i = 0; i < kBucketsCount; ++i)
+    {
+        cumulative += counts[i];
+
+        if (cumulative >= target)
+            return i + 1 < kBucketsCount ? std::min(getBucketLowestValue(i + 1) - 1, max) : max;
+    }
+
+    return max;
+}
+
+inline uint64_t LatencyHistogram::Snapshot::getMean() const noexcept
+{
+    return count != 0 ? sum / count : 0;
+}
+
+constexpr size_t LatencyHistogram::getBucketIndex(uint64_t value) noexcept
+{
+    if (value < kSubBucketsCount)
+        return static_cast<size_t>(value);
+
+    const uint32_t highestBit = static_cast<uint32_t>(std::bit_width(value)) - 1;
+
+    if (highestBit >= kMaxValueBits)
+        return kBucketsCount - 1;
+
+    const uint32_t shift = highestBit - kSubBucketBits;
+
+    return (highestBit - kSubBucketBits + 1) * kSubBucketsCount + static_cast<size_t>((value >> shift) & (kSubBucketsCount - 1));
+}
+
+constexpr uint64_t LatencyHistogram::getBucketLowestValue(size_t index) noexcept
+{
+    if (index < kSubBucketsCount)
+        return index;
+
+    const uint32_t shift = static_cast<uint32_t>(index / kSubBucketsCount) - 1;
+
+    return (kSubBucketsCount + index % kSubBucketsCount) << shift;
+}
+
+AGS_CS_ALWAYS_INLINE void LatencyHistogram::record(uint64_t value) noexcept
+{
+    Shard& shard = m_shards[getMetricsThreadIndex() % kShardsCount];
+
+    shard.counts[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t max = shard.max.load(std::memory_order_relaxed);
+    while (value > max && !shard.max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        ;
+}
+
+inline void LatencyHistogram::getSnapshot(Snapshot& snapshot) const noexcept
+{
+    std::fill(std::begin(snapshot.counts), std::end(snapshot.counts), 0);
+    snapshot.count = 0;
+    snapshot.sum = 0;
+    snapshot.max = 0;
+
+    for (const auto& shard : m_shards)
+    {
+        for (size_t i = 0; i < kBucketsCount; ++i)
+            snapshot.counts[i] += shard.counts[i].load(std::memory_order_relaxed);
+
+        snapshot.sum += shard.sum.load(std::memory_order_relaxed);
+        snapshot.max = std::max(snapshot.max, shard.max.load(std::memory_order_relaxed));
+    }
+
+    for (auto count : snapshot.counts)
+        snapshot.count += count;
+}
+
+AGS_CS_ALWAYS_INLINE uint64_t HandlerMetrics::now() noexcept
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+AGS_CS_ALWAYS_INLINE void HandlerMetrics::addRequest(size_t bytesIn) noexcept
+{
+    CountersShard& counters = m_counters[getMetricsThreadIndex() % kCountersShardsCount];
+
+    counters.requests.fetch_add(1, std::memory_order_relaxed);
+    counters.bytesIn.fetch_add(bytesIn, std::memory_order_relaxed);
+}
+
+AGS_CS_ALWAYS_INLINE void HandlerMetrics::addResponse(Status status, size_t bytesOut) noexcept
+{
+    m_counters[getMetricsThreadIndex() % kCountersShardsCount].bytesOut.fetch_add(bytesOut, std::memory_order_relaxed);
+
+    if (!statusSuccess(status))
+        m_errors[getErrorIndex(status)].fetch_add(1, std::memory_order_relaxed);
+}
+
+AGS_CS_ALWAYS_INLINE void HandlerMetrics::addLatency(Phase phase, uint64_t start) noexcept
+{
+    m_latencies[static_cast<size_t>(phase)].record(now() - start);
+}
+
+inline void HandlerMetrics::getSnapshot(Snapshot& snapshot) const noexcept
+{
+    snapshot.requests = 0;
+    snapshot.bytesIn = 0;
+    snapshot.bytesOut = 0;
+
+    for (const auto& counters : m_counters)
+    {
+        snapshot.requests += counters.requests.load(std::memory_order_relaxed);
+        snapshot.bytesIn += counters.bytesIn.load(std::memory_order_relaxed);
+        snapshot.bytesOut += counters.bytesOut.load(std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < kErrorsCount; ++i)
+        snapshot.errors[i] = m_errors[i].load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < kPhasesCount; ++i)
+        m_latencies[i].getSnapshot(snapshot.latencies[i]);
+}
+
+} // namespace common_serialization::csp::messaging
@@ -0,0 +1,67 @@
+/**
+ * @file common_serialization/csp_messaging/IExecutor.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+namespace common_serialization::csp::messaging
+{
+
+/// @brief Interface of executor that runs tasks asynchronously
+///     (for example on thread pool)
+class IExecutor
+{
+public:
+    /// @brief Task that can be run by executor
+    /// @note Task object must stay alive until it is run
+    class ITask
+    {
+    public:
+        /// @brief Body of task
+        virtual void run() noexcept = 0;
+
+        /// @brief Link that executor may use for queuing tasks without allocations.
+        ///     Must not be used by anyone else.
+        ITask* pNextTask{ nullptr };
+
+    protected:
+        ~ITask() = default;
+    };
+
+    virtual ~IExecutor() = default;
+
+    /// @brief Schedule task for execution
+    /// @param task Task to run
+    /// @return Status of operation. If it is not successful task will not be run.
+    virtual Status execute(ITask& task) noexcept = 0;
+
+    /// @brief Remove task from schedule if it is not started yet
+    /// @note Default implementation can't cancel any task
+    /// @param task Task that was scheduled by execute()
+    /// @return True if task is removed and will not be run by executor
+    virtual bool cancel(ITask& task) noexcept
+    {
+        return false;
+    }
+};
+
+} // namespace common_serialization::csp::messaging
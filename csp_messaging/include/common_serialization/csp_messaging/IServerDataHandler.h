@@ -26,6 +26,8 @@
 #include <common_serialization/csp_messaging/IServerDataHandlerBase.h>
 #include <common_serialization/csp_messaging/IServerDataHandlerRegistrar.h>
 #include <common_serialization/csp_messaging/IServerDataHandlerTraits.h>
+#include <common_serialization/csp_messaging/ResponseCache.h>
+#include <common_serialization/csp_messaging/ThreadLocalLease.h>
 #include <common_serialization/csp_base/processing/data/ContextProcessor.h>
 #include <common_serialization/csp_base/processing/status/Helpers.h>
 
@@ -43,6 +45,8 @@ public:
     static constexpr bool kForTempUseHeap = T::kForTempUseHeap;
     static constexpr bool kMulticast = T::kMulticast;
     static constexpr interface_version_t kMinimumInterfaceVersion  = T::kMinimumInterfaceVersion;
+    static constexpr ObjectsPoolType kObjectsPoolType = T::kObjectsPoolType;
+    static constexpr bool kIdempotent = T::kIdempotent;
     
     /// @brief This method must be overriden in concrete class.
     /// @details It receives deserialized input data and returns output data
@@ -52,7 +56,9 @@ public:
     /// @remark It is not pure virtual to be as default implementation replacement for static handlers
     /// @param input Deserialized input data
     /// @param unmanagedPointers Pointer to container with unmanaged pointers
-    ///     received on input deserialization process
+    ///     received on input deserialization process. Input of multicast message
+    ///     is shared between its handlers together with this container,
+    ///     so multicast handlers must not change it.
     /// @param clientId Any ID info that is intended to client including security,
     ///     that may help in processing decisions
     /// @param output Data that should be returned to client
@@ -64,6 +70,15 @@ public:
     AGS_CS_ALWAYS_INLINE void unregisterHandler(IServerDataHandlerRegistrar& handlerRegistrar);
     [[nodiscard]] interface_version_t getMinimumInterfaceVersion();
 
+    /// @brief Get cache of serialized responses
+    /// @note Only idempotent handlers have cache
+    /// @return Response cache
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] ResponseCache& getResponseCache() noexcept requires kIdempotent;
+
+    /// @brief Get counters of handled messages
+    /// @return Handler metrics
+    const HandlerMetrics& getMetrics() const noexcept override;
+
 protected:
     IServerDataHandler() = default;
     IServerDataHandler(const IServerDataHandler&) = delete;
@@ -71,11 +86,34 @@ protected:
 
 private:
     Status handleDataCommon(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) override;
+    const Interface& getInputInterface() const noexcept override;
+    Status checkSharedInputPolicies(const context::DData& ctx, const GenericPointerKeeperT& clientId) override;
+    Status deserializeSharedInput(context::DData& ctx, GenericPointerKeeperT& input, BinVectorT& binOutput) override;
+    Status handleSharedInput(const GenericPointerKeeperT& input, context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) override;
+
+    // Input walker is positioned on body start when handler is called and, in Batch, is limited by item end
+    static AGS_CS_ALWAYS_INLINE [[nodiscard]] size_t getInputBodySize(const context::DData& ctx) noexcept;
+
+    // handleDataCommon and handleSharedInput only count messages in metrics and call these ones
+    AGS_CS_ALWAYS_INLINE Status processDataCommon(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput);
+    AGS_CS_ALWAYS_INLINE Status processSharedInput(const GenericPointerKeeperT& input, context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput);
 
+    // Returns cached response if there is one, or handles data and caches its response
+    Status handleDataCached(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput);
+    AGS_CS_ALWAYS_INLINE Status handleDataUncached(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput);
     AGS_CS_ALWAYS_INLINE Status handleDataOnStack(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput);
     AGS_CS_ALWAYS_INLINE Status handleDataOnHeap(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput);
     // This is the common code between handleDataOnStack and handleDataOnHeap
     AGS_CS_ALWAYS_INLINE Status handleDataMain(InputType& input, context::DData& ctx, const GenericPointerKeeperT& clientId, OutputType& output, BinVectorT& binOutput);
+    // This is the common code between handleDataMain and handleSharedInput
+    AGS_CS_ALWAYS_INLINE Status handleDeserializedData(const InputType& input, context::DData& ctx, const GenericPointerKeeperT& clientId, OutputType& output, BinVectorT& binOutput);
+
+    ObjectsPool<InputType, kObjectsPoolType> m_inputPool;
+    ObjectsPool<OutputType, kObjectsPoolType> m_outputPool;
+    struct NoResponseCache { };
+
+    [[no_unique_address]] std::conditional_t<kIdempotent, ResponseCache, NoResponseCache> m_responseCache;
+    HandlerMetrics m_metrics;
 };
 
 template<IServerDataHandlerTraitsImpl T>
@@ -102,8 +140,104 @@ interface_version_t IServerDataHandler<T>::getMinimumInterfaceVersion()
     return kMinimumInterfaceVersion;
 }
 
+template<IServerDataHandlerTraitsImpl T>
+AGS_CS_ALWAYS_INLINE ResponseCache& IServerDataHandler<T>::getResponseCache() noexcept requires kIdempotent
+{
+    return m_responseCache;
+}
+
+template<IServerDataHandlerTraitsImpl T>
+const HandlerMetrics& IServerDataHandler<T>::getMetrics() const noexcept
+{
+    return m_metrics;
+}
+
+template<IServerDataHandlerTraitsImpl T>
+const Interface& IServerDataHandler<T>::getInputInterface() const noexcept
+{
+    return InputType::getInterface();
+}
+
 template<IServerDataHandlerTraitsImpl T>
 Status IServerDataHandler<T>::handleDataCommon(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput)
+{
+    m_metrics.addRequest(getInputBodySize(ctx));
+
+    Status status = processDataCommon(ctx, clientId, binOutput);
+
+    m_metrics.addResponse(status, binOutput.size());
+
+    return status;
+}
+
+template<IServerDataHandlerTraitsImpl T>
+Status IServerDataHandler<T>::checkSharedInputPolicies(const context::DData& ctx, const GenericPointerKeeperT& clientId)
+{
+    Status status = this->checkPoliciesCompliance(static_cast<const InputType*>(nullptr), ctx, clientId);
+
+    // Rejected message is not handled, but it is counted as it would be on handleDataCommon
+    if (!statusSuccess(status))
+    {
+        m_metrics.addRequest(getInputBodySize(ctx));
+        m_metrics.addResponse(status, 0);
+    }
+
+    return status;
+}
+
+template<IServerDataHandlerTraitsImpl T>
+Status IServerDataHandler<T>::deserializeSharedInput(context::DData& ctx, GenericPointerKeeperT& input, BinVectorT& binOutput)
+{
+    // Every handler of multicast message may have its own minimum interface version,
+    // so here we only check that input can be deserialized at all, and the rest is checked in handleSharedInput
+    if (Status status = processing::data::ContextProcessor::deserializePostprocessRest<InputType>(ctx, InputType::getOriginPrivateVersion()); !statusSuccess(status))
+    {
+        if (status == Status::ErrorNotSupportedInterfaceVersion)
+            AGS_CS_RUN(processing::status::Helpers::serializeErrorNotSupportedInterfaceVersion(ctx.getProtocolVersion(), ctx.getCommonFlags()
+                , getMinimumInterfaceVersion(), OutputType::getId(), binOutput));
+
+        return status;
+    }
+
+    ctx.setHeapUseForTemp(kForTempUseHeap);
+
+    if (!input.allocateAndConstructOne<InputType>())
+        return Status::ErrorNoMemory;
+
+    uint64_t start = HandlerMetrics::now();
+    Status status = processing::data::BodyProcessor::deserialize(ctx, *input.get<InputType>());
+    m_metrics.addLatency(HandlerMetrics::Phase::Deserialize, start);
+
+    return status;
+}
+
+template<IServerDataHandlerTraitsImpl T>
+Status IServerDataHandler<T>::handleSharedInput(const GenericPointerKeeperT& input, context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput)
+{
+    m_metrics.addRequest(getInputBodySize(ctx));
+
+    [[maybe_unused]] const size_t addedPointersCount = ctx.getAddedPointers() ? ctx.getAddedPointers()->size() : 0;
+
+    Status status = processSharedInput(input, ctx, clientId, binOutput);
+
+    // Added pointers are shared between all handlers of multicast message
+    assert(!ctx.getAddedPointers() || ctx.getAddedPointers()->size() == addedPointersCount);
+
+    m_metrics.addResponse(status, binOutput.size());
+
+    return status;
+}
+
+template<IServerDataHandlerTraitsImpl T>
+AGS_CS_ALWAYS_INLINE size_t IServerDataHandler<T>::getInputBodySize(const context::DData& ctx) noexcept
+{
+    const BinWalkerT& binInput = ctx.getBinaryData();
+
+    return binInput.size() - binInput.tell();
+}
+
+template<IServerDataHandlerTraitsImpl T>
+AGS_CS_ALWAYS_INLINE Status IServerDataHandler<T>::processDataCommon(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput)
 {
     AGS_CS_RUN(this->checkPoliciesCompliance(static_cast<const InputType*>(nullptr), ctx, clientId));
 
@@ -122,7 +256,78 @@ Status IServerDataHandler<T>::handleDataCommon(context::DData& ctx, const Generi
 
     ctx.setHeapUseForTemp(kForTempUseHeap);
 
-    if constexpr (kForTempUseHeap)
+    if constexpr (kIdempotent)
+        return handleDataCached(ctx, clientId, binOutput);
+    else
+        return handleDataUncached(ctx, clientId, binOutput);
+}
+
+template<IServerDataHandlerTraitsImpl T>
+AGS_CS_ALWAYS_INLINE Status IServerDataHandler<T>::processSharedInput(const GenericPointerKeeperT& input, context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput)
+{
+    if (!traits::isInterfaceVersionSupported(ctx.getInterfaceVersion(), getMinimumInterfaceVersion(), InputType::getInterface().m_version))
+    {
+        AGS_CS_RUN(processing::status::Helpers::serializeErrorNotSupportedInterfaceVersion(ctx.getProtocolVersion(), ctx.getCommonFlags()
+            , getMinimumInterfaceVersion(), OutputType::getId(), binOutput));
+
+        return Status::ErrorNotSupportedInterfaceVersion;
+    }
+
+    const InputType& sharedInput = *input.get<InputType>();
+
+    if constexpr (std::is_same_v<OutputType, service_structs::ISerializableDummy>)
+    {
+        service_structs::ISerializableDummy output;
+        return handleDeserializedData(sharedInput, ctx, clientId, output, binOutput);
+    }
+    else if constexpr (kForTempUseHeap || kObjectsPoolType != ObjectsPoolType::None)
+    {
+        GenericPointerKeeperT output;
+        AGS_CS_RUN(m_outputPool.take(output));
+
+        Status status = handleDeserializedData(sharedInput, ctx, clientId, *output.get<OutputType>(), binOutput);
+
+        if constexpr (kObjectsPoolType != ObjectsPoolType::None)
+            m_outputPool.reset(*output.get<OutputType>());
+
+        m_outputPool.put(std::move(output));
+
+        return status;
+    }
+    else
+    {
+        OutputType output;
+        return handleDeserializedData(sharedInput, ctx, clientId, output, binOutput);
+    }
+}
+
+template<IServerDataHandlerTraitsImpl T>
+Status IServerDataHandler<T>::handleDataCached(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput)
+{
+    ThreadLocalLease<BinVectorT> key;
+
+    if (!statusSuccess(m_responseCache.makeKey(ctx, key.get())))
+        return handleDataUncached(ctx, clientId, binOutput);
+
+    if (m_responseCache.find(key.get(), binOutput))
+    {
+        // Input is considered read, as it would be after deserialization
+        BinWalkerT& binInput = ctx.getBinaryData();
+        return binInput.seek(binInput.size());
+    }
+
+    AGS_CS_RUN(handleDataUncached(ctx, clientId, binOutput));
+
+    m_responseCache.insert(key.get(), binOutput);
+
+    return Status::NoError;
+}
+
+template<IServerDataHandlerTraitsImpl T>
+AGS_CS_ALWAYS_INLINE Status IServerDataHandler<T>::handleDataUncached(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput)
+{
+    // Pooled objects are always kept on heap
+    if constexpr (kForTempUseHeap || kObjectsPoolType != ObjectsPoolType::None)
         return handleDataOnHeap(ctx, clientId, binOutput);
     else
         return handleDataOnStack(ctx, clientId, binOutput);
@@ -141,31 +346,71 @@ template<IServerDataHandlerTraitsImpl T>
 AGS_CS_ALWAYS_INLINE Status IServerDataHandler<T>::handleDataOnHeap(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput)
 {
     GenericPointerKeeperT input;
-    if (!input.allocateAndConstructOne<InputType>())
-        return Status::ErrorNoMemory;
+    AGS_CS_RUN(m_inputPool.take(input));
+
+    if constexpr (kObjectsPoolType != ObjectsPoolType::None)
+    {
+        // Input object is fully overwritten on deserialization, so we only need to keep
+        // storage of its elements. The exception is conversion from older interface version,
+        // which leaves newer fields untouched.
+        if (ctx.isInterfaceVersionsNotMatch())
+            m_inputPool.reset(*input.get<InputType>());
+
+        ctx.setExistingElementsReuse(true);
+    }
+
+    Status status = Status::NoError;
 
     if constexpr (std::is_same_v<OutputType, service_structs::ISerializableDummy>)
-        return handleDataMain(*input.get<InputType>(), ctx, clientId, service_structs::ISerializableDummy{}, binOutput);
+        status = handleDataMain(*input.get<InputType>(), ctx, clientId, service_structs::ISerializableDummy{}, binOutput);
     else
     {
         GenericPointerKeeperT output;
-        if (!output.allocateAndConstructOne<OutputType>())
-            return Status::ErrorNoMemory;
+        if (!statusSuccess(status = m_outputPool.take(output)))
+        {
+            m_inputPool.put(std::move(input));
+            return status;
+        }
 
-        return handleDataMain(*input.get<InputType>(), ctx, clientId, *output.get<OutputType>(), binOutput);
+        status = handleDataMain(*input.get<InputType>(), ctx, clientId, *output.get<OutputType>(), binOutput);
+
+        if constexpr (kObjectsPoolType != ObjectsPoolType::None)
+            m_outputPool.reset(*output.get<OutputType>());
+
+        m_outputPool.put(std::move(output));
     }
+
+    m_inputPool.put(std::move(input));
+
+    return status;
 }
 
 template<IServerDataHandlerTraitsImpl T>
 AGS_CS_ALWAYS_INLINE Status IServerDataHandler<T>::handleDataMain(InputType& input, context::DData& ctxIn, const GenericPointerKeeperT& clientId, OutputType& output, BinVectorT& binOutput)
 {
-    AGS_CS_RUN(processing::data::BodyProcessor::deserialize(ctxIn, input));
-    
-    AGS_CS_RUN(this->handleData(input, ctxIn.getAddedPointers(), clientId, output))
+    uint64_t start = HandlerMetrics::now();
+    Status status = processing::data::BodyProcessor::deserialize(ctxIn, input);
+    m_metrics.addLatency(HandlerMetrics::Phase::Deserialize, start);
+
+    if (!statusSuccess(status))
+        return status;
+
+    return handleDeserializedData(input, ctxIn, clientId, output, binOutput);
+}
+
+template<IServerDataHandlerTraitsImpl T>
+AGS_CS_ALWAYS_INLINE Status IServerDataHandler<T>::handleDeserializedData(const InputType& input, context::DData& ctxIn, const GenericPointerKeeperT& clientId, OutputType& output, BinVectorT& binOutput)
+{
+    uint64_t start = HandlerMetrics::now();
+    Status status = this->handleData(input, ctxIn.getAddedPointers(), clientId, output);
+    m_metrics.addLatency(HandlerMetrics::Phase::Handle, start);
+
+    if (!statusSuccess(status))
+        return status;
 
     if constexpr (!std::is_same_v<OutputType, service_structs::ISerializableDummy>)
     {
-        context::SPointersMap pointersMapOut;
+        ThreadLocalLease<context::SPointersMap> pointersMapOut;
 
         binOutput.clear();
 
@@ -179,9 +424,13 @@ AGS_CS_ALWAYS_INLINE Status IServerDataHandler<T>::handleDataMain(InputType& inp
             , nullptr);
 
         if (ctxOut.checkRecursivePointers())
-            ctxOut.setPointersMap(&pointersMapOut);
+            ctxOut.setPointersMap(&pointersMapOut.get());
 
-        return output.serialize(ctxOut);
+        start = HandlerMetrics::now();
+        status = output.serialize(ctxOut);
+        m_metrics.addLatency(HandlerMetrics::Phase::Serialize, start);
+
+        return status;
     }
     else
         return Status::NoError;
@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <common_serialization/csp_messaging/HandlerMetrics.h>
+
 namespace common_serialization::csp::messaging
 {
 
@@ -34,6 +36,39 @@ protected:
 
 public:
     virtual Status handleDataCommon(context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) = 0;
+
+    /// @brief Get interface of handler input type
+    /// @return Interface properties
+    virtual const Interface& getInputInterface() const noexcept = 0;
+
+    /// @brief Get counters and latencies of messages handled by handler
+    /// @return Handler metrics
+    virtual const HandlerMetrics& getMetrics() const noexcept = 0;
+
+    /// @brief Check policies of multicast message before its input is deserialized
+    /// @param ctx Data context positioned on data flags and interface version
+    /// @param clientId Client ID
+    /// @return Status of operation
+    virtual Status checkSharedInputPolicies(const context::DData& ctx, const GenericPointerKeeperT& clientId) = 0;
+
+    /// @brief Deserialize input of multicast message, so it can be shared between all handlers of its id
+    /// @param ctx Data context positioned on data flags and interface version
+    /// @param input Keeper of deserialized input
+    /// @param binOutput Binary data output, which is filled only on error
+    /// @return Status of operation
+    virtual Status deserializeSharedInput(context::DData& ctx, GenericPointerKeeperT& input, BinVectorT& binOutput) = 0;
+
+    /// @brief Handle input that was deserialized by deserializeSharedInput
+    /// @note Neither input nor ctx are changed here, so the same objects
+    ///     may be passed to all handlers of multicast message.
+    ///     Policies must be already checked by checkSharedInputPolicies.
+    /// @param input Keeper of deserialized input
+    /// @param ctx Data context that was used on input deserialization,
+    ///     with input positioned back on body start as on separate handling
+    /// @param clientId Client ID
+    /// @param binOutput Binary data output
+    /// @return Status of operation
+    virtual Status handleSharedInput(const GenericPointerKeeperT& input, context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) = 0;
 };
 
 } // namespace common_serialization::csp::messaging
@@ -77,6 +77,12 @@ public:
     /// @return Status of operation
     /// @note Called by Server after handleData processing
     virtual void releaseHandler(IServerDataHandlerBase* pHandler) noexcept = 0;
+
+    /// @brief Get metrics of all registered handlers
+    /// @details Metrics are copied while handlers keep handling messages
+    /// @param metrics Container that would be filled with metrics of handlers
+    /// @return Status of operation
+    virtual Status getHandlersMetrics(VectorT<HandlerMetrics::Snapshot>& metrics) const = 0;
 };
 
 } // namespace common_serialization::csp::messaging
@@ -24,17 +24,22 @@
 #pragma once
 
 #include <common_serialization/csp_base/types.h>
+#include <common_serialization/csp_messaging/ObjectsPool.h>
 
 namespace common_serialization::csp::messaging
 {
 
 /// @brief traits_ of CSP Server data handler
+/// @note Handler is idempotent when its output depends only on input (not on client or any state),
+///     so its serialized responses may be cached and returned without handler call
 template<
       ISerializableImpl InputType_
     , ISerializableImpl OutputType_
     , bool forTempUseHeap_
     , bool multicast_
     , interface_version_t minimumInterfaceVersion_
+    , ObjectsPoolType objectsPoolType_ = ObjectsPoolType::None
+    , bool idempotent_ = false
 >
 struct IServerDataHandlerTraits
 {
@@ -44,10 +49,12 @@ struct IServerDataHandlerTraits
     static constexpr bool kForTempUseHeap = forTempUseHeap_;
     static constexpr bool kMulticast = multicast_;
     static constexpr interface_version_t kMinimumInterfaceVersion = minimumInterfaceVersion_;
+    static constexpr ObjectsPoolType kObjectsPoolType = objectsPoolType_;
+    static constexpr bool kIdempotent = idempotent_;
 };
 
 template<typename T>
-concept IServerDataHandlerTraitsImpl = std::is_base_of_v<IServerDataHandlerTraits<typename T::InputType, typename T::OutputType, T::kForTempUseHeap, T::kMulticast, T::kMinimumInterfaceVersion>, normalize_t<T>>;
+concept IServerDataHandlerTraitsImpl = std::is_base_of_v<IServerDataHandlerTraits<typename T::InputType, typename T::OutputType, T::kForTempUseHeap, T::kMulticast, T::kMinimumInterfaceVersion, T::kObjectsPoolType, T::kIdempotent>, normalize_t<T>>;
 
 template<ISerializableImpl InputType, ISerializableImpl OutputType>
 struct MinimumInterfaceVersion
@@ -86,4 +93,27 @@ template<
 >
 using ServerHeapMultiHandler = IServerDataHandlerTraits<InputType, OutputType, true, true, minimumInterfaceVersion>;
 
+template<
+      ISerializableImpl InputType
+    , ISerializableImpl OutputType
+    , ObjectsPoolType objectsPoolType = ObjectsPoolType::PerHandler
+    , interface_version_t minimumInterfaceVersion = MinimumInterfaceVersion< InputType, OutputType>::value
+>
+using ServerPooledHandler = IServerDataHandlerTraits<InputType, OutputType, true, false, minimumInterfaceVersion, objectsPoolType>;
+
+template<
+      ISerializableImpl InputType
+    , ISerializableImpl OutputType
+    , ObjectsPoolType objectsPoolType = ObjectsPoolType::PerHandler
+    , interface_version_t minimumInterfaceVersion = MinimumInterfaceVersion< InputType, OutputType>::value
+>
+using ServerPooledMultiHandler = IServerDataHandlerTraits<InputType, OutputType, true, true, minimumInterfaceVersion, objectsPoolType>;
+
+template<
+      ISerializableImpl InputType
+    , ISerializableImpl OutputType
+    , interface_version_t minimumInterfaceVersion = MinimumInterfaceVersion< InputType, OutputType>::value
+>
+using ServerIdempotentHandler = IServerDataHandlerTraits<InputType, OutputType, false, false, minimumInterfaceVersion, ObjectsPoolType::None, true>;
+
 } // namespace common_serialization::csp::messaging
@@ -0,0 +1,203 @@
+/**
+ * @file common_serialization/csp_messaging/MpmcQueue.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
+
+namespace common_serialization::csp::messaging
+{
+
+/// @brief Bounded lock-free queue for multiple producers and multiple consumers
+/// @details Every cell has sequence number that tells whether it is ready
+///     for writing or for reading on current lap, so producers and consumers
+///     synchronize only on cells and on their own positions.
+/// @tparam T Trivially copyable type of elements
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+class MpmcQueue
+{
+public:
+    MpmcQueue() = default;
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+    ~MpmcQueue() noexcept;
+
+    /// @brief Allocate cells of queue
+    /// @param capacity Maximum number of elements (must be power of two)
+    /// @return Status of operation
+    Status init(size_t capacity) noexcept;
+
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] bool isValid() const noexcept;
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] size_t capacity() const noexcept;
+
+    /// @brief Get approximate number of elements in queue
+    /// @return Number of elements
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] size_t size() const noexcept;
+
+    /// @brief Add element to queue
+    /// @param value Element
+    /// @return Status of operation. If queue is full ErrorOverflow is returned.
+    Status tryPush(const T& value) noexcept;
+
+    /// @brief Take element from queue
+    /// @param value Element
+    /// @return true if element was taken, false if queue is empty
+    bool tryPop(T& value) noexcept;
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    struct alignas(kCacheLineSize) Cell
+    {
+        AtomicT<size_t> sequence{ 0 };
+        T value{};
+    };
+
+    Cell* m_pCells{ nullptr };
+    size_t m_mask{ 0 };
+    alignas(kCacheLineSize) AtomicT<size_t> m_pushPosition{ 0 };
+    alignas(kCacheLineSize) AtomicT<size_t> m_popPosition{ 0 };
+};
+
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+MpmcQueue<T>::~MpmcQueue() noexcept
+{
+    delete[] m_pCells;
+}
+
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+Status MpmcQueue<T>::init(size_t capacity) noexcept
+{
+    if (isValid())
+        return Status::ErrorAlreadyInited;
+
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+        return Status::ErrorInvalidArgument;
+
+    m_pCells = new (std::nothrow) Cell[capacity];
+    if (!m_pCells)
+        return Status::ErrorNoMemory;
+
+    for (size_t i = 0; i < capacity; ++i)
+        m_pCells[i].sequence.store(i, std::memory_order_relaxed);
+
+    m_mask = capacity - 1;
+
+    return Status::NoError;
+}
+
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+AGS_CS_ALWAYS_INLINE bool MpmcQueue<T>::isValid() const noexcept
+{
+    return m_pCells != nullptr;
+}
+
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+AGS_CS_ALWAYS_INLINE size_t MpmcQueue<T>::capacity() const noexcept
+{
+    return isValid() ? m_mask + 1 : 0;
+}
+
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+AGS_CS_ALWAYS_INLINE size_t MpmcQueue<T>::size() const noexcept
+{
+    const size_t popPosition = m_popPosition.load(std::memory_order_relaxed);
+    const size_t pushPosition = m_pushPosition.load(std::memory_order_relaxed);
+
+    return pushPosition > popPosition ? pushPosition - popPosition : 0;
+}
+
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+Status MpmcQueue<T>::tryPush(const T& value) noexcept
+{
+    if (!isValid())
+        return Status::ErrorNotInited;
+
+    size_t position = m_pushPosition.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        Cell& cell = m_pCells[position & m_mask];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+        if (difference == 0)
+        {
+            if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                cell.value = value;
+                cell.sequence.store(position + 1, std::memory_order_release);
+
+                return Status::NoError;
+            }
+        }
+        // Cell is not yet read on previous lap
+        else if (difference < 0)
+            return Status::ErrorOverflow;
+        else
+            position = m_pushPosition.load(std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+bool MpmcQueue<T>::tryPop(T& value) noexcept
+{
+    if (!isValid())
+        return false;
+
+    size_t position = m_popPosition.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        Cell& cell = m_pCells[position & m_mask];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+        if (difference == 0)
+        {
+            if (m_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                value = cell.value;
+                cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+
+                return true;
+            }
+        }
+        // Cell is not yet written on current lap
+        else if (difference < 0)
+            return false;
+        else
+            position = m_popPosition.load(std::memory_order_relaxed);
+    }
+}
+
+} // namespace common_serialization::csp::messaging
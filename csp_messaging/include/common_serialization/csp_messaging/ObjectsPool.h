@@ -0,0 +1,147 @@
+/**
+ * @file common_serialization/csp_messaging/ObjectsPool.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <common_serialization/concurrency_interfaces/GuardRW.h>
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
+
+namespace common_serialization::csp::messaging
+{
+
+/// @brief Strategy of obtaining input and output objects of server data handler
+enum class ObjectsPoolType
+{
+    None,           // objects are constructed for every request and destroyed after it
+    PerHandler,     // objects are taken from pool that is shared by all threads calling handler
+    PerThread       // every thread keeps its own objects (shared by handlers of the same type)
+};
+
+template<typename T>
+concept ResettableObject = requires(T t)
+{
+    { t.reset() };
+};
+
+/// @brief Pool of objects that are constructed once and then reused
+/// @tparam T Type of objects
+/// @tparam type Pool strategy
+template<typename T, ObjectsPoolType type>
+class ObjectsPool
+{
+public:
+    /// @brief Get object for use
+    /// @param object Keeper that will own object until it put back
+    /// @return Status of operation
+    Status take(GenericPointerKeeperT& object) noexcept
+    {
+        return object.allocateAndConstructOne<T>() ? Status::NoError : Status::ErrorNoMemory;
+    }
+
+    /// @brief Return object after use
+    /// @param object Keeper of object that was taken before
+    void put(GenericPointerKeeperT&& object) noexcept
+    {
+        object.destroyAndDeallocate();
+    }
+
+    /// @brief Bring object that was used before to state in which it may be used again.
+    ///     If T has reset() method it is called, otherwise default constructed object is assigned to it.
+    /// @param object Object to reset
+    static void reset(T& object)
+    {
+        if constexpr (ResettableObject<T>)
+            object.reset();
+        else
+            object = T{};
+    }
+};
+
+template<typename T>
+class ObjectsPool<T, ObjectsPoolType::PerHandler> : public ObjectsPool<T, ObjectsPoolType::None>
+{
+public:
+    Status take(GenericPointerKeeperT& object) noexcept
+    {
+        {
+            WGuard guard(m_freeObjectsMutex);
+
+            if (m_freeObjects.size() > 0)
+            {
+                object = std::move(m_freeObjects[m_freeObjects.size() - 1]);
+                m_freeObjects.erase(m_freeObjects.size() - 1);
+
+                return Status::NoError;
+            }
+        }
+
+        return ObjectsPool<T, ObjectsPoolType::None>::take(object);
+    }
+
+    void put(GenericPointerKeeperT&& object) noexcept
+    {
+        WGuard guard(m_freeObjectsMutex);
+
+        // If we can't keep object it will be destroyed by its keeper
+        m_freeObjects.pushBack(std::move(object));
+    }
+
+private:
+    VectorT<GenericPointerKeeperT> m_freeObjects;
+    SharedMutexT m_freeObjectsMutex;
+};
+
+template<typename T>
+class ObjectsPool<T, ObjectsPoolType::PerThread> : public ObjectsPool<T, ObjectsPoolType::None>
+{
+public:
+    Status take(GenericPointerKeeperT& object) noexcept
+    {
+        VectorT<GenericPointerKeeperT>& freeObjects = getFreeObjects();
+
+        // More than one object is needed only when handler is reentered on the same thread
+        if (freeObjects.size() > 0)
+        {
+            object = std::move(freeObjects[freeObjects.size() - 1]);
+            freeObjects.erase(freeObjects.size() - 1);
+
+            return Status::NoError;
+        }
+
+        return ObjectsPool<T, ObjectsPoolType::None>::take(object);
+    }
+
+    void put(GenericPointerKeeperT&& object) noexcept
+    {
+        getFreeObjects().pushBack(std::move(object));
+    }
+
+private:
+    static VectorT<GenericPointerKeeperT>& getFreeObjects() noexcept
+    {
+        thread_local VectorT<GenericPointerKeeperT> freeObjects;
+        return freeObjects;
+    }
+};
+
+} // namespace common_serialization::csp::messaging
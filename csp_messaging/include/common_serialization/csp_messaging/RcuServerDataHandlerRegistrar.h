@@ -0,0 +1,458 @@
+/**
+ * @file common_serialization/csp_messaging/RcuServerDataHandlerRegistrar.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <common_serialization/concurrency_interfaces/GuardRW.h>
+#include <common_serialization/csp_base/context/Data.h>
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
+#include <common_serialization/csp_messaging/IServerDataHandlerRegistrar.h>
+
+namespace common_serialization::csp::messaging
+{
+
+/// @brief Registrar in which handlers lookup is a lock-free read of immutable snapshot of handlers table
+/// @details Every change of registered handlers builds new snapshot and publishes it atomically.
+///     Readers are counted in one of two grace period phases in one of reader slots,
+///     and unregistration frees previous snapshots (and returns) only after readers
+///     of both phases that could see them have released their handlers.
+///     New readers are counted in other phase than the one writer waits for,
+///     so writer is not starved by steady stream of readers.
+///     Registration removes no handlers, so it doesn't wait for readers: previous snapshot
+///     is kept until next unregistration or registrar destruction.
+///     Unregistration builds new snapshot in spare one, which is prepared on registration,
+///     so it never fails on lack of memory.
+///     Registration changes are expected to be rare in comparison with lookups.
+/// @note Handler must be released on the same thread on which it was aquired.
+///     Handlers must not unregister themselves or their services while they are in use,
+///     but they may register other handlers.
+///     Nested aquisitions on the same thread are counted in phase of the outer one,
+///     so writer waits until thread releases all its handlers.
+class RcuServerDataHandlerRegistrar : public IServerDataHandlerRegistrar
+{
+public:
+    RcuServerDataHandlerRegistrar() = default;
+    RcuServerDataHandlerRegistrar(const RcuServerDataHandlerRegistrar&) = delete;
+    RcuServerDataHandlerRegistrar& operator=(const RcuServerDataHandlerRegistrar&) = delete;
+    ~RcuServerDataHandlerRegistrar() override;
+
+    Status registerHandler(const Id& id, bool kMulticast, Service* pService, IServerDataHandlerBase& handler) override;
+    void unregisterHandler(const Id& id, IServerDataHandlerBase& handler) noexcept override;
+    void unregisterService(Service* pService) noexcept override;
+    Status aquireHandlers(const Id& id, RawVectorT<IServerDataHandlerBase*>& handlers) override;
+    Status aquireHandler(const Id& id, IServerDataHandlerBase*& pHandler) noexcept override;
+    void releaseHandler(IServerDataHandlerBase* pHandler) noexcept override;
+    Status getHandlersMetrics(VectorT<HandlerMetrics::Snapshot>& metrics) const override;
+
+private:
+    struct Entry
+    {
+        Id id;
+        Service* pService{ nullptr };
+        IServerDataHandlerBase* pHandler{ nullptr };
+    };
+
+    struct Snapshot
+    {
+        // Sorted by id, so all handlers of multicast id are placed contiguously
+        RawVectorT<Entry> entries;
+        // Next snapshot in list of replaced snapshots that are waiting to be freed
+        Snapshot* pNextRetired{ nullptr };
+    };
+
+    static constexpr size_t kPhasesCount = 2;
+
+    // Number of readers of every phase. Slot may be shared by a few threads.
+    struct alignas(64) ReaderSlot
+    {
+        AtomicUint32T readers[kPhasesCount]{};
+    };
+
+    static constexpr size_t kReaderSlotsCount = 64;
+
+    // Read sections of thread in one registrar.
+    // Thread may be in read sections of a few registrars at the same time (e.g. on nested in-process call).
+    struct ReaderState
+    {
+        const RcuServerDataHandlerRegistrar* pRegistrar{ nullptr };
+        uint32_t depth{ 0 };
+        uint32_t phase{ 0 };
+    };
+
+    static constexpr size_t kReaderStatesCount = 8;
+
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] ReaderSlot& getReaderSlot() noexcept;
+
+    /// @brief Get read sections state of current thread in this registrar
+    /// @param create Take free state if thread is not in read section of this registrar
+    /// @return State or nullptr if there is none
+    [[nodiscard]] ReaderState* getReaderState(bool create) noexcept;
+
+    /// @brief Enter read section of current thread
+    /// @param pSnapshot Current snapshot, which stays alive until read section is left
+    /// @return Status of operation. If there is no snapshot ErrorNoSuchHandler is returned
+    ///     and read section is not entered.
+    Status enterReadSection(const Snapshot*& pSnapshot) noexcept;
+
+    /// @brief Count more readers in read section of current thread
+    AGS_CS_ALWAYS_INLINE void addReaders(uint32_t readers) noexcept;
+
+    AGS_CS_ALWAYS_INLINE void leaveReadSection(uint32_t readers = 1) noexcept;
+
+    /// @brief Wait until all readers of phase have left their read sections
+    void waitForReaders(uint32_t phase) noexcept;
+
+    /// @brief Find entries of given id
+    /// @return Pointer to first entry with given id, or to place where it would be
+    static const Entry* findEntries(const Snapshot& snapshot, const Id& id, size_t& count) noexcept;
+
+    /// @brief Wait until all readers that could see replaced snapshots have left their read sections
+    /// @note Must be called under m_writeMutex
+    void waitForGracePeriod() noexcept;
+
+    /// @brief Free snapshots that were replaced on registrations
+    /// @note Must be called under m_writeMutex after grace period
+    void freeRetiredSnapshots() noexcept;
+
+    /// @brief Builds and publishes snapshot without entries for which predicate returns true
+    ///     and waits until removed handlers are not used anymore
+    template<typename Pred>
+    void publishWithout(Pred pred) noexcept;
+
+    AtomicT<Snapshot*> m_pSnapshot{ nullptr };
+    // Snapshot that has room for all entries of current one
+    UniquePtrT<Snapshot> m_pSpareSnapshot;
+    Snapshot* m_pRetiredSnapshots{ nullptr };
+    // Phase in which new readers are counted. It is kept apart from snapshot,
+    // so readers never touch snapshot before they are counted.
+    AtomicUint32T m_readerPhase{ 0 };
+    ReaderSlot m_readerSlots[kReaderSlotsCount];
+    mutable SharedMutexT m_writeMutex;
+};
+
+inline RcuServerDataHandlerRegistrar::~RcuServerDataHandlerRegistrar()
+{
+    UniquePtrT<Snapshot> pSnapshot(m_pSnapshot.exchange(nullptr, std::memory_order_acq_rel));
+    freeRetiredSnapshots();
+}
+
+inline Status RcuServerDataHandlerRegistrar::registerHandler(const Id& id, bool kMulticast, Service* pService, IServerDataHandlerBase& handler)
+{
+    WGuard guard(m_writeMutex);
+
+    const Snapshot* pSnapshot = m_pSnapshot.load(std::memory_order_relaxed);
+    size_t count = 0;
+    size_t position = 0;
+
+    if (pSnapshot)
+    {
+        // New entry goes right after all existing entries with the same id
+        position = findEntries(*pSnapshot, id, count) - pSnapshot->entries.data() + count;
+    }
+
+    if (!kMulticast && count)
+    {
+        assert(false);
+        return Status::ErrorInvalidArgument;
+    }
+
+    UniquePtrT<Snapshot> pNewSnapshot = makeUniqueNoThrow<Snapshot>();
+    if (!pNewSnapshot)
+        return Status::ErrorNoMemory;
+
+    if (pSnapshot)
+    {
+        AGS_CS_RUN(pNewSnapshot->entries.reserve(pSnapshot->entries.size() + 1));
+        AGS_CS_RUN(pNewSnapshot->entries.pushBackN(pSnapshot->entries.data(), position));
+        AGS_CS_RUN(pNewSnapshot->entries.pushBack(Entry{ id, pService, &handler }));
+        AGS_CS_RUN(pNewSnapshot->entries.pushBackN(pSnapshot->entries.data() + position, pSnapshot->entries.size() - position));
+    }
+    else
+        AGS_CS_RUN(pNewSnapshot->entries.pushBack(Entry{ id, pService, &handler }));
+
+    if (!m_pSpareSnapshot && !(m_pSpareSnapshot = makeUniqueNoThrow<Snapshot>()))
+        return Status::ErrorNoMemory;
+
+    AGS_CS_RUN(m_pSpareSnapshot->entries.reserve(pNewSnapshot->entries.size()));
+
+    // No handler is removed, so readers of previous snapshot are not waited for
+    Snapshot* pOldSnapshot = m_pSnapshot.exchange(pNewSnapshot.release(), std::memory_order_seq_cst);
+
+    if (pOldSnapshot)
+    {
+        pOldSnapshot->pNextRetired = m_pRetiredSnapshots;
+        m_pRetiredSnapshots = pOldSnapshot;
+    }
+
+    return Status::NoError;
+}
+
+inline void RcuServerDataHandlerRegistrar::unregisterHandler(const Id& id, IServerDataHandlerBase& handler) noexcept
+{
+    publishWithout([&id, &handler](const Entry& entry) { return entry.id == id && entry.pHandler == &handler; });
+}
+
+inline void RcuServerDataHandlerRegistrar::unregisterService(Service* pService) noexcept
+{
+    publishWithout([pService](const Entry& entry) { return entry.pService == pService; });
+}
+
+inline Status RcuServerDataHandlerRegistrar::aquireHandlers(const Id& id, RawVectorT<IServerDataHandlerBase*>& handlers)
+{
+    handlers.clear();
+
+    const Snapshot* pSnapshot = nullptr;
+    AGS_CS_RUN(enterReadSection(pSnapshot));
+
+    size_t count = 0;
+    const Entry* pEntries = findEntries(*pSnapshot, id, count);
+
+    for (size_t i = 0; i < count; ++i)
+        if (Status status = handlers.pushBack(pEntries[i].pHandler); !statusSuccess(status))
+        {
+            handlers.clear();
+            leaveReadSection();
+
+            return status;
+        }
+
+    if (count == 0)
+    {
+        leaveReadSection();
+        return Status::ErrorNoSuchHandler;
+    }
+
+    // Every handler is released separately
+    addReaders(static_cast<uint32_t>(count - 1));
+
+    return Status::NoError;
+}
+
+inline Status RcuServerDataHandlerRegistrar::aquireHandler(const Id& id, IServerDataHandlerBase*& pHandler) noexcept
+{
+    const Snapshot* pSnapshot = nullptr;
+    AGS_CS_RUN(enterReadSection(pSnapshot));
+
+    size_t count = 0;
+    const Entry* pEntries = findEntries(*pSnapshot, id, count);
+
+    if (count != 1)
+    {
+        leaveReadSection();
+        return count == 0 ? Status::ErrorNoSuchHandler : Status::ErrorMoreEntires;
+    }
+
+    pHandler = pEntries->pHandler;
+
+    return Status::NoError;
+}
+
+inline void RcuServerDataHandlerRegistrar::releaseHandler(IServerDataHandlerBase* pHandler) noexcept
+{
+    assert(pHandler);
+
+    leaveReadSection();
+}
+
+inline Status RcuServerDataHandlerRegistrar::getHandlersMetrics(VectorT<HandlerMetrics::Snapshot>& metrics) const
+{
+    metrics.clear();
+
+    // Holding write mutex keeps handlers of current snapshot from being unregistered,
+    // while readers are not blocked at all
+    RGuard guard(m_writeMutex);
+
+    const Snapshot* pSnapshot = m_pSnapshot.load(std::memory_order_acquire);
+    if (!pSnapshot)
+        return Status::NoError;
+
+    AGS_CS_RUN(metrics.reserve(pSnapshot->entries.size()));
+
+    for (const auto& entry : pSnapshot->entries)
+    {
+        AGS_CS_RUN(metrics.pushBack(HandlerMetrics::Snapshot{}));
+
+        HandlerMetrics::Snapshot& snapshot = metrics[metrics.size() - 1];
+        snapshot.inputTypeId = entry.id;
+        entry.pHandler->getMetrics().getSnapshot(snapshot);
+    }
+
+    return Status::NoError;
+}
+
+AGS_CS_ALWAYS_INLINE RcuServerDataHandlerRegistrar::ReaderSlot& RcuServerDataHandlerRegistrar::getReaderSlot() noexcept
+{
+    // Threads are spread over slots in round-robin order, so while number of
+    // active threads is not greater than number of slots, every thread has its own one
+    static AtomicUint32T nextSlot{ 0 };
+    thread_local size_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % kReaderSlotsCount;
+
+    return m_readerSlots[slot];
+}
+
+inline RcuServerDataHandlerRegistrar::ReaderState* RcuServerDataHandlerRegistrar::getReaderState(bool create) noexcept
+{
+    thread_local ReaderState states[kReaderStatesCount];
+
+    ReaderState* pFree = nullptr;
+
+    for (auto& state : states)
+        if (state.pRegistrar == this)
+            return &state;
+        else if (!pFree && !state.pRegistrar)
+            pFree = &state;
+
+    if (!create)
+        return nullptr;
+
+    // Thread shall not be in read sections of so many registrars at the same time
+    assert(pFree);
+
+    return pFree;
+}
+
+inline Status RcuServerDataHandlerRegistrar::enterReadSection(const Snapshot*& pSnapshot) noexcept
+{
+    ReaderState* pState = getReaderState(true);
+    if (!pState)
+        return Status::ErrorNotAvailible;
+
+    ReaderSlot& slot = getReaderSlot();
+    uint32_t phase = pState->depth ? pState->phase : m_readerPhase.load(std::memory_order_seq_cst);
+
+    // Reader is counted before snapshot is loaded, so writer that has replaced snapshot
+    // either sees this reader or this reader sees new snapshot
+    slot.readers[phase].fetch_add(1, std::memory_order_seq_cst);
+
+    pSnapshot = m_pSnapshot.load(std::memory_order_seq_cst);
+    if (!pSnapshot)
+    {
+        slot.readers[phase].fetch_sub(1, std::memory_order_release);
+        return Status::ErrorNoSuchHandler;
+    }
+
+    pState->pRegistrar = this;
+    pState->phase = phase;
+    ++pState->depth;
+
+    return Status::NoError;
+}
+
+AGS_CS_ALWAYS_INLINE void RcuServerDataHandlerRegistrar::addReaders(uint32_t readers) noexcept
+{
+    ReaderState* pState = getReaderState(false);
+    assert(pState && pState->depth);
+
+    getReaderSlot().readers[pState->phase].fetch_add(readers, std::memory_order_relaxed);
+    pState->depth += readers;
+}
+
+AGS_CS_ALWAYS_INLINE void RcuServerDataHandlerRegistrar::leaveReadSection(uint32_t readers) noexcept
+{
+    ReaderState* pState = getReaderState(false);
+    assert(pState && pState->depth >= readers);
+
+    getReaderSlot().readers[pState->phase].fetch_sub(readers, std::memory_order_release);
+
+    if ((pState->depth -= readers) == 0)
+        pState->pRegistrar = nullptr;
+}
+
+inline void RcuServerDataHandlerRegistrar::waitForReaders(uint32_t phase) noexcept
+{
+    for (auto& slot : m_readerSlots)
+        while (slot.readers[phase].load(std::memory_order_seq_cst) != 0)
+            std::this_thread::yield();
+}
+
+inline const RcuServerDataHandlerRegistrar::Entry* RcuServerDataHandlerRegistrar::findEntries(const Snapshot& snapshot, const Id& id, size_t& count) noexcept
+{
+    const Entry* pBegin = snapshot.entries.data();
+    const Entry* pEnd = pBegin + snapshot.entries.size();
+
+    const Entry* pFirst = std::lower_bound(pBegin, pEnd, id, [](const Entry& entry, const Id& id) { return entry.id < id; });
+    const Entry* pLast = pFirst;
+
+    while (pLast != pEnd && pLast->id == id)
+        ++pLast;
+
+    count = pLast - pFirst;
+
+    return pFirst;
+}
+
+inline void RcuServerDataHandlerRegistrar::waitForGracePeriod() noexcept
+{
+    // Readers that could get older snapshot are counted in any of phases.
+    // Before waiting for readers of phase, new readers are directed to other one,
+    // so only readers that had already been counted in it are waited for.
+    for (size_t i = 0; i < kPhasesCount; ++i)
+    {
+        uint32_t phase = m_readerPhase.load(std::memory_order_relaxed);
+        m_readerPhase.store(phase ^ 1, std::memory_order_seq_cst);
+
+        waitForReaders(phase);
+    }
+}
+
+inline void RcuServerDataHandlerRegistrar::freeRetiredSnapshots() noexcept
+{
+    while (m_pRetiredSnapshots)
+    {
+        UniquePtrT<Snapshot> pSnapshot(m_pRetiredSnapshots);
+        m_pRetiredSnapshots = pSnapshot->pNextRetired;
+    }
+}
+
+template<typename Pred>
+void RcuServerDataHandlerRegistrar::publishWithout(Pred pred) noexcept
+{
+    WGuard guard(m_writeMutex);
+
+    const Snapshot* pSnapshot = m_pSnapshot.load(std::memory_order_relaxed);
+    if (!pSnapshot || std::none_of(pSnapshot->entries.data(), pSnapshot->entries.data() + pSnapshot->entries.size(), pred))
+        return;
+
+    // Spare snapshot has room for all current entries, so nothing here can fail
+    assert(m_pSpareSnapshot && m_pSpareSnapshot->entries.capacity() >= pSnapshot->entries.size());
+
+    Snapshot* pNewSnapshot = m_pSpareSnapshot.release();
+    pNewSnapshot->entries.clear();
+    pNewSnapshot->pNextRetired = nullptr;
+
+    for (const auto& entry : pSnapshot->entries)
+        if (!pred(entry))
+            pNewSnapshot->entries.pushBack(entry);
+
+    Snapshot* pOldSnapshot = m_pSnapshot.exchange(pNewSnapshot, std::memory_order_seq_cst);
+
+    waitForGracePeriod();
+
+    // Previous snapshot has room for all entries of new one, so it becomes spare
+    m_pSpareSnapshot.reset(pOldSnapshot);
+    freeRetiredSnapshots();
+}
+
+} // namespace common_serialization::csp::messaging
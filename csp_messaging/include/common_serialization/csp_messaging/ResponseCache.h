@@ -0,0 +1,292 @@
+/**
+ * @file common_serialization/csp_messaging/ResponseCache.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <common_serialization/concurrency_interfaces/GuardRW.h>
+#include <common_serialization/csp_base/context/Data.h>
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
+
+namespace common_serialization::csp::messaging
+{
+
+/// @brief Bounded cache of serialized responses with eviction of least recently used ones
+/// @details Key is made of negotiated protocol version, flags, interface version
+///     and raw bytes of input body, so response is returned only for exactly the same request.
+///     Requests that allow unmanaged pointers are not cached, because their body holds
+///     raw pointer values, data behind which may change between requests.
+///     Cache is thread-safe.
+class ResponseCache
+{
+public:
+    static constexpr size_t kDefaultCapacity = 256;
+
+    /// @brief Requests with bigger body are not cached
+    static constexpr size_t kDefaultMaxInputSize = 4096;
+
+    /// @brief Constructor
+    /// @param capacity Maximum number of cached responses
+    /// @param maxInputSize Maximum size of input body of cached requests
+    explicit ResponseCache(size_t capacity = kDefaultCapacity, size_t maxInputSize = kDefaultMaxInputSize) noexcept;
+
+    /// @brief Set limits of cache
+    /// @note All cached responses are dropped
+    /// @param capacity Maximum number of cached responses (0 disables caching)
+    /// @param maxInputSize Maximum size of input body of cached requests
+    void setLimits(size_t capacity, size_t maxInputSize) noexcept;
+
+    /// @brief Make cache key of request
+    /// @param ctx Context of request, which binary data is positioned on start of body
+    /// @param key Key
+    /// @return Status of operation. If request can't be cached ErrorNotAvailible is returned.
+    Status makeKey(context::DData& ctx, BinVectorT& key) const noexcept;
+
+    /// @brief Find response and copy it to output
+    /// @param key Key of request
+    /// @param binOutput Output container
+    /// @return true if response was found
+    bool find(const BinVectorT& key, BinVectorT& binOutput) noexcept;
+
+    /// @brief Put response in cache (least recently used response is evicted if cache is full)
+    /// @note Index of cache may throw when it can't allocate memory, in that case cache is not changed
+    /// @param key Key of request
+    /// @param binOutput Response
+    void insert(const BinVectorT& key, const BinVectorT& binOutput);
+
+    void clear() noexcept;
+
+private:
+    static constexpr uint32_t kNoEntry = UINT32_MAX;
+
+    struct Entry
+    {
+        uint64_t hash{ 0 };
+        BinVectorT key;
+        BinVectorT response;
+        uint32_t prev{ kNoEntry };
+        uint32_t next{ kNoEntry };
+    };
+
+    static uint64_t getHash(const BinVectorT& key) noexcept;
+
+    void unlink(uint32_t index) noexcept;
+    void linkAsHead(uint32_t index) noexcept;
+    void linkAsTail(uint32_t index) noexcept;
+
+    size_t m_capacity{ kDefaultCapacity };
+    size_t m_maxInputSize{ kDefaultMaxInputSize };
+    VectorT<Entry> m_entries;
+    HashMapT<uint64_t, uint32_t> m_index;
+    uint32_t m_head{ kNoEntry };
+    uint32_t m_tail{ kNoEntry };
+    MutexT m_mutex;
+};
+
+inline ResponseCache::ResponseCache(size_t capacity, size_t maxInputSize) noexcept
+    : m_capacity(capacity < kNoEntry ? capacity : kNoEntry - 1), m_maxInputSize(maxInputSize)
+{
+}
+
+inline void ResponseCache::setLimits(size_t capacity, size_t maxInputSize) noexcept
+{
+    WGuard guard(m_mutex);
+
+    m_capacity = capacity < kNoEntry ? capacity : kNoEntry - 1;
+    m_maxInputSize = maxInputSize;
+
+    m_entries.invalidate();
+    m_index.clear();
+    m_head = m_tail = kNoEntry;
+}
+
+inline Status ResponseCache::makeKey(context::DData& ctx, BinVectorT& key) const noexcept
+{
+    const BinWalkerT& binInput = ctx.getBinaryData();
+    // Walker of Batch item is limited to item bounds, so this is the size of request body only
+    const size_t bodySize = binInput.size() - binInput.tell();
+
+    if (m_capacity == 0 || bodySize > m_maxInputSize || ctx.allowUnmanagedPointers())
+        return Status::ErrorNotAvailible;
+
+    key.clear();
+    AGS_CS_RUN(key.reserve(sizeof(uint16_t) + 3 * sizeof(uint32_t) + bodySize));
+    AGS_CS_RUN(key.pushBackArithmeticValue(static_cast<uint16_t>(ctx.getProtocolVersion())));
+    AGS_CS_RUN(key.pushBackArithmeticValue(static_cast<uint32_t>(ctx.getCommonFlags())));
+    AGS_CS_RUN(key.pushBackArithmeticValue(static_cast<uint32_t>(ctx.getDataFlags())));
+    AGS_CS_RUN(key.pushBackArithmeticValue(static_cast<uint32_t>(ctx.getInterfaceVersion())));
+
+    return key.pushBackN(binInput.data() + binInput.tell(), bodySize);
+}
+
+inline bool ResponseCache::find(const BinVectorT& key, BinVectorT& binOutput) noexcept
+{
+    const uint64_t hash = getHash(key);
+
+    WGuard guard(m_mutex);
+
+    auto it = m_index.find(hash);
+    if (it == m_index.end())
+        return false;
+
+    Entry& entry = m_entries[it->second];
+
+    if (entry.key.size() != key.size() || memcmp(entry.key.data(), key.data(), key.size()) != 0)
+        return false;
+
+    binOutput.clear();
+    if (!statusSuccess(binOutput.pushBackN(entry.response.data(), entry.response.size())))
+        return false;
+
+    unlink(it->second);
+    linkAsHead(it->second);
+
+    return true;
+}
+
+inline void ResponseCache::insert(const BinVectorT& key, const BinVectorT& binOutput)
+{
+    const uint64_t hash = getHash(key);
+
+    WGuard guard(m_mutex);
+
+    if (m_capacity == 0)
+        return;
+
+    uint32_t index = kNoEntry;
+
+    if (auto it = m_index.find(hash); it != m_index.end())
+    {
+        // Response of the same request that was added concurrently or key with the same hash
+        index = it->second;
+        unlink(index);
+    }
+    else if (m_entries.size() < m_capacity)
+    {
+        // Index is changed first, because only it may throw
+        index = static_cast<uint32_t>(m_entries.size());
+        auto it = m_index.emplace(hash, index).first;
+
+        if (!statusSuccess(m_entries.pushBack(Entry{})))
+        {
+            m_index.erase(it);
+            return;
+        }
+    }
+    else
+    {
+        // Storage of evicted entry is reused
+        index = m_tail;
+        m_index.emplace(hash, index);
+
+        // Evicted entry may be one which insertion had failed, and its hash may be the same as new one
+        unlink(index);
+        if (auto evicted = m_index.find(m_entries[index].hash)
+            ; m_entries[index].hash != hash && evicted != m_index.end() && evicted->second == index)
+        {
+            m_index.erase(evicted);
+        }
+    }
+
+    Entry& entry = m_entries[index];
+    entry.hash = hash;
+    entry.key.clear();
+    entry.response.clear();
+
+    if (!statusSuccess(entry.key.pushBackN(key.data(), key.size()))
+        || !statusSuccess(entry.response.pushBackN(binOutput.data(), binOutput.size())))
+    {
+        // Entry with empty key is never matched and is reused first
+        entry.key.clear();
+        entry.response.clear();
+        m_index.erase(hash);
+        linkAsTail(index);
+
+        return;
+    }
+
+    linkAsHead(index);
+}
+
+inline void ResponseCache::clear() noexcept
+{
+    WGuard guard(m_mutex);
+
+    m_entries.clear();
+    m_index.clear();
+    m_head = m_tail = kNoEntry;
+}
+
+inline uint64_t ResponseCache::getHash(const BinVectorT& key) noexcept
+{
+    return helpers::getFnv1aHash(key.data(), key.size());
+}
+
+inline void ResponseCache::unlink(uint32_t index) noexcept
+{
+    Entry& entry = m_entries[index];
+
+    if (entry.prev != kNoEntry)
+        m_entries[entry.prev].next = entry.next;
+    else
+        m_head = entry.next;
+
+    if (entry.next != kNoEntry)
+        m_entries[entry.next].prev = entry.prev;
+    else
+        m_tail = entry.prev;
+
+    entry.prev = entry.next = kNoEntry;
+}
+
+inline void ResponseCache::linkAsHead(uint32_t index) noexcept
+{
+    Entry& entry = m_entries[index];
+
+    entry.prev = kNoEntry;
+    entry.next = m_head;
+
+    if (m_head != kNoEntry)
+        m_entries[m_head].prev = index;
+    else
+        m_tail = index;
+
+    m_head = index;
+}
+
+inline void ResponseCache::linkAsTail(uint32_t index) noexcept
+{
+    Entry& entry = m_entries[index];
+
+    entry.prev = m_tail;
+    entry.next = kNoEntry;
+
+    if (m_tail != kNoEntry)
+        m_entries[m_tail].next = index;
+    else
+        m_head = index;
+
+    m_tail = index;
+}
+
+} // namespace common_serialization::csp::messaging
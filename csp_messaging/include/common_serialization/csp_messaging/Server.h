@@ -23,12 +23,18 @@
 
 #pragma once
 
+#include <common_serialization/concurrency_interfaces/GuardRW.h>
+#include <common_serialization/csp_base/processing/batch/ContextProcessor.h>
 #include <common_serialization/csp_base/processing/common/ContextProcessor.h>
 #include <common_serialization/csp_base/processing/data/BodyProcessor.h>
 #include <common_serialization/csp_base/processing/data/ContextProcessor.h>
 #include <common_serialization/csp_base/processing/status/Helpers.h>
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
+#include <common_serialization/csp_messaging/AdmissionController.h>
+#include <common_serialization/csp_messaging/IExecutor.h>
 #include <common_serialization/csp_messaging/IServerDataHandlerRegistrar.h>
 #include <common_serialization/csp_messaging/IServerDataHandlerBase.h>
+#include <common_serialization/csp_messaging/ThreadLocalLease.h>
 #include <common_serialization/csp_messaging/service_structs/structs.h>
 
 namespace common_serialization::csp::messaging
@@ -70,6 +76,40 @@ public:
     /// @return Server settings
     constexpr const service_structs::CspPartySettings<>& getSettings() const noexcept;
 
+    /// @brief Set executor on which multicast handlers are run concurrently
+    /// @note Must be set before server is used and must outlive its usage.
+    ///     When executor is set, all handlers of multicast message are sharing the same
+    ///     deserialized input and unmanaged pointers container at the same time,
+    ///     so they must not change them.
+    ///     If messages may be handled on threads of executor itself, executor must support
+    ///     cancellation of tasks, otherwise they may wait for each other forever.
+    /// @param pExecutor Executor or nullptr to run multicast handlers sequentially
+    AGS_CS_ALWAYS_INLINE void setExecutor(IExecutor* pExecutor) noexcept;
+    AGS_CS_ALWAYS_INLINE IExecutor* getExecutor() const noexcept;
+
+    /// @brief Set controller that limits number of data messages handled at the same time
+    /// @note Must be set before server is used and must outlive its usage.
+    ///     Messages that are not admitted are answered with ErrorBusy.
+    /// @param pAdmissionController Admission controller or nullptr to handle all messages
+    AGS_CS_ALWAYS_INLINE void setAdmissionController(AdmissionController* pAdmissionController) noexcept;
+    AGS_CS_ALWAYS_INLINE AdmissionController* getAdmissionController() const noexcept;
+
+    /// @brief Get priority lane of message without its handling
+    /// @details Lane is defined by admission controller by interface of message input type.
+    ///     Messages that are not data ones or can't be parsed are in Normal lane.
+    ///     Interface of input type is taken from its handler only on first message with it,
+    ///     so registrar is not used here in steady state and only message header is parsed.
+    /// @param binInput Binary data received from client (its position is not changed)
+    /// @return Priority lane
+    AdmissionController::Priority getMessagePriority(BinWalkerT& binInput) const noexcept;
+
+    /// @brief Get metrics of all registered data handlers
+    /// @details Requests, errors, bytes and latencies are counted by handlers without locks,
+    ///     so metrics may be read at any time without stopping message handling
+    /// @param metrics Container that would be filled with metrics of handlers
+    /// @return Status of operation
+    Status getHandlersMetrics(VectorT<HandlerMetrics::Snapshot>& metrics) const;
+
     /// @brief Entry point for all CSP client requests
     /// @param binInput Binary data received from client
     /// @param binOutput Binary data that should be send back to client
@@ -77,7 +117,20 @@ public:
     Status handleMessage(BinWalkerT& binInput, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) const;
 
 private:
+    /// @brief Serialize responses that depend only on settings, so they are copied on request
+    ///     instead of being serialized every time
+    /// @return Status of operation
+    Status initPrecomputedResponses() noexcept;
+
     AGS_CS_ALWAYS_INLINE Status handleGetSettings(protocol_version_t cspVersion, BinVectorT& binOutput) const noexcept;
+    Status serializeGetSettingsResponse(protocol_version_t cspVersion, BinVectorT& binOutput) const noexcept;
+
+    /// @brief Read Id of input type of data message
+    static Status getDataMessageId(context::DCommon& ctxCommon, Id& id) noexcept;
+
+    /// @brief Get Id of interface of input type from cache or from its registered handler
+    /// @return True if interface was found
+    bool getInputTypeInterface(const Id& inputTypeId, Id& interfaceId) const noexcept;
 
     /// @brief Common entry point on data messages handling
     /// @param ctxCommon Deserialized from input common context
@@ -85,9 +138,36 @@ private:
     /// @return Status of operation
     AGS_CS_ALWAYS_INLINE Status handleData(context::DCommon& ctxCommon, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) const;
 
+    /// @brief Handle every Data item of Batch message and pack responses on them in one Batch message
+    /// @param ctxCommon Deserialized from input common context
+    /// @param binOutput Binary data output
+    /// @return Status of operation. Statuses of items handling are sent in their responses.
+    Status handleBatch(context::DCommon& ctxCommon, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) const;
+    Status handleBatchItems(context::DCommon& ctxCommon, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) const;
+
+    /// @brief Run all multicast handlers on shared input concurrently and wait for them
+    /// @return Status of first (in handlers order) failed handler or NoError
+    Status handleSharedInputConcurrently(IServerDataHandlerBase* const* pHandlers, size_t handlersCount, const GenericPointerKeeperT& sharedInput
+        , context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) const;
+
     service_structs::CspPartySettings<> m_settings;
+    // Responses on GetSettings in the same order as protocol versions in settings
+    VectorT<BinVectorT> m_getSettingsResponses;
+    BinVectorT m_errorNotSupportedProtocolVersionResponse;
     UniquePtrT<IServerDataHandlerRegistrar> m_dataHandlersRegistrar;
+    IExecutor* m_pExecutor{ nullptr };
+    AdmissionController* m_pAdmissionController{ nullptr };
     bool m_isInited{ false };
+
+    struct InputTypeInterfaceEntry
+    {
+        Id inputTypeId;
+        Id interfaceId;
+    };
+
+    // Sorted by input type Id. Type never changes its interface, so entries are never invalidated.
+    mutable VectorT<InputTypeInterfaceEntry> m_inputTypeInterfaces;
+    mutable SharedMutexT m_inputTypeInterfacesMutex;
 };
 
 inline Server::Server(const service_structs::CspPartySettings<>& settings, UniquePtrT<IServerDataHandlerRegistrar>&& dataHandlersRegistrar) noexcept
@@ -97,7 +177,7 @@ inline Server::Server(const service_structs::CspPartySettings<>& settings, Uniqu
 
     m_dataHandlersRegistrar = std::move(dataHandlersRegistrar);
 
-    m_isInited = statusSuccess(m_settings.init(settings));
+    m_isInited = statusSuccess(m_settings.init(settings)) && statusSuccess(initPrecomputedResponses());
 }
 
 template<typename T, typename... Ts>
@@ -115,6 +195,7 @@ inline Status Server::init(const service_structs::CspPartySettings<>& settings,
         return Status::ErrorInvalidArgument;
 
     AGS_CS_RUN(m_settings.init(settings));
+    AGS_CS_RUN(initPrecomputedResponses());
 
     m_isInited = true;
 
@@ -136,6 +217,115 @@ AGS_CS_ALWAYS_INLINE constexpr const service_structs::CspPartySettings<>& Server
     return m_settings;
 }
 
+AGS_CS_ALWAYS_INLINE void Server::setExecutor(IExecutor* pExecutor) noexcept
+{
+    m_pExecutor = pExecutor;
+}
+
+AGS_CS_ALWAYS_INLINE IExecutor* Server::getExecutor() const noexcept
+{
+    return m_pExecutor;
+}
+
+AGS_CS_ALWAYS_INLINE void Server::setAdmissionController(AdmissionController* pAdmissionController) noexcept
+{
+    m_pAdmissionController = pAdmissionController;
+}
+
+AGS_CS_ALWAYS_INLINE AdmissionController* Server::getAdmissionController() const noexcept
+{
+    return m_pAdmissionController;
+}
+
+inline AdmissionController::Priority Server::getMessagePriority(BinWalkerT& binInput) const noexcept
+{
+    AdmissionController::Priority priority = AdmissionController::Priority::Normal;
+
+    if (!m_pAdmissionController || !isValid())
+        return priority;
+
+    const csp_size_t start = binInput.tell();
+
+    context::DCommon ctxCommon(binInput, m_settings.getOldestProtocolVersion());
+    Id id;
+    Id interfaceId;
+
+    if (statusSuccess(processing::common::ContextProcessor::deserialize(ctxCommon)) && ctxCommon.getMessageType() == context::Message::Data
+        && statusSuccess(getDataMessageId(ctxCommon, id)) && getInputTypeInterface(id, interfaceId))
+    {
+        priority = m_pAdmissionController->getInterfacePriority(interfaceId);
+    }
+
+    binInput.seek(start);
+
+    return priority;
+}
+
+inline bool Server::getInputTypeInterface(const Id& inputTypeId, Id& interfaceId) const noexcept
+{
+    {
+        RGuard guard(m_inputTypeInterfacesMutex);
+
+        const InputTypeInterfaceEntry* pBegin = m_inputTypeInterfaces.data();
+        const InputTypeInterfaceEntry* pEnd = pBegin + m_inputTypeInterfaces.size();
+
+        const InputTypeInterfaceEntry* pEntry = std::lower_bound(pBegin, pEnd, inputTypeId
+            , [](const InputTypeInterfaceEntry& entry, const Id& id) { return entry.inputTypeId < id; });
+
+        if (pEntry != pEnd && pEntry->inputTypeId == inputTypeId)
+        {
+            interfaceId = pEntry->interfaceId;
+            return true;
+        }
+    }
+
+    IServerDataHandlerBase* pHandler{ nullptr };
+    Status status = m_dataHandlersRegistrar->aquireHandler(inputTypeId, pHandler);
+
+    if (statusSuccess(status))
+    {
+        interfaceId = pHandler->getInputInterface().m_id;
+        m_dataHandlersRegistrar->releaseHandler(pHandler);
+    }
+    else if (status == Status::ErrorMoreEntires)
+    {
+        RawVectorT<IServerDataHandlerBase*> handlers;
+
+        if (!statusSuccess(m_dataHandlersRegistrar->aquireHandlers(inputTypeId, handlers)))
+            return false;
+
+        interfaceId = handlers[0]->getInputInterface().m_id;
+
+        for (auto pHandlerM : handlers)
+            m_dataHandlersRegistrar->releaseHandler(pHandlerM);
+    }
+    else
+        return false;
+
+    WGuard guard(m_inputTypeInterfacesMutex);
+
+    InputTypeInterfaceEntry* pBegin = m_inputTypeInterfaces.data();
+    InputTypeInterfaceEntry* pEnd = pBegin + m_inputTypeInterfaces.size();
+
+    InputTypeInterfaceEntry* pEntry = std::lower_bound(pBegin, pEnd, inputTypeId
+        , [](const InputTypeInterfaceEntry& entry, const Id& id) { return entry.inputTypeId < id; });
+
+    // Cache is only an optimization, so failure to add entry to it is not an error.
+    // Another thread could already add the same entry.
+    if (pEntry == pEnd || pEntry->inputTypeId != inputTypeId)
+        m_inputTypeInterfaces.insert({ inputTypeId, interfaceId }, pEntry - pBegin);
+
+    return true;
+}
+
+inline Status Server::getHandlersMetrics(VectorT<HandlerMetrics::Snapshot>& metrics) const
+{
+    if (!isValid())
+        return Status::ErrorNotInited;
+
+    return m_dataHandlersRegistrar->getHandlersMetrics(metrics);
+}
+
 inline Status Server::handleMessage(BinWalkerT& binInput, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) const
 {
     if (!isValid())
@@ -157,26 +347,74 @@ inline Status Server::handleMessage(BinWalkerT& binInput, const GenericPointerKe
             if (statusSuccess(status))
                 status = handleData(ctx, clientId, binOutput);
             break;
+        case context::Message::Batch:
+            status = processing::common::ContextProcessor::testCommonFlagsCompatibility(ctx.getCommonFlags(), m_settings.getForbiddenCommonFlags(), m_settings.getMandatoryCommonFlags());
+            if (statusSuccess(status))
+                status = handleBatch(ctx, clientId, binOutput);
+            break;
         default:
             status = Status::ErrorDataCorrupted;
             break;
         }
     else if (status == Status::ErrorNotSupportedProtocolVersion)
-        status = processing::status::Helpers::serializeErrorNotSupportedProtocolVersion(binOutput, m_settings.getProtocolVersions(), m_settings.getMandatoryCommonFlags());
+        status = binOutput.pushBackN(m_errorNotSupportedProtocolVersionResponse.data(), m_errorNotSupportedProtocolVersionResponse.size());
 
     if (binOutput.size() == 0)
         AGS_CS_SET_NEW_ERROR(processing::status::Helpers::serializeFullContext(binOutput, ctx.getProtocolVersion(), ctx.getCommonFlags(), status));
 
+    // Response must carry the same correlation id as request for client could match them
+    if (ctx.withCorrelationId())
+        AGS_CS_SET_NEW_ERROR(processing::common::ContextProcessor::setCorrelationId(binOutput, ctx.getCorrelationId()));
+
     return status;
 }
 
+inline Status Server::initPrecomputedResponses() noexcept
+{
+    const RawVectorT<protocol_version_t>& protocolVersions = m_settings.getProtocolVersions();
+
+    m_getSettingsResponses.clear();
+    AGS_CS_RUN(m_getSettingsResponses.reserve(protocolVersions.size()));
+
+    for (protocol_version_t protocolVersion : protocolVersions)
+    {
+        BinVectorT response;
+        AGS_CS_RUN(serializeGetSettingsResponse(protocolVersion, response));
+        AGS_CS_RUN(m_getSettingsResponses.pushBack(std::move(response)));
+    }
+
+    m_errorNotSupportedProtocolVersionResponse.clear();
+
+    return processing::status::Helpers::serializeErrorNotSupportedProtocolVersion(m_errorNotSupportedProtocolVersionResponse
+        , protocolVersions, m_settings.getMandatoryCommonFlags());
+}
+
 AGS_CS_ALWAYS_INLINE Status Server::handleGetSettings(protocol_version_t cspVersion, BinVectorT& binOutput) const noexcept
+{
+    const RawVectorT<protocol_version_t>& protocolVersions = m_settings.getProtocolVersions();
+
+    for (size_t i = 0; i < protocolVersions.size() && i < m_getSettingsResponses.size(); ++i)
+        if (protocolVersions[i] == cspVersion)
+            return binOutput.pushBackN(m_getSettingsResponses[i].data(), m_getSettingsResponses[i].size());
+
+    // Version is in range of supported ones but is not in the list
+    return serializeGetSettingsResponse(cspVersion, binOutput);
+}
+
+inline Status Server::serializeGetSettingsResponse(protocol_version_t cspVersion, BinVectorT& binOutput) const noexcept
 {
     context::SData ctxOut(binOutput, cspVersion, m_settings.getMandatoryCommonFlags(), {}, true, cspVersion);
 
     return m_settings.serialize(ctxOut);
 }
 
+inline Status Server::getDataMessageId(context::DCommon& ctxCommon, Id& id) noexcept
+{
+    context::DData ctx(ctxCommon);
+
+    return processing::data::ContextProcessor::deserializeNoChecks(ctx, id);
+}
+
 AGS_CS_ALWAYS_INLINE Status Server::handleData(context::DCommon& ctxCommon, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) const
 {
     context::DData ctx(ctxCommon);
@@ -184,20 +422,29 @@ AGS_CS_ALWAYS_INLINE Status Server::handleData(context::DCommon& ctxCommon, cons
 
     AGS_CS_RUN(processing::data::ContextProcessor::deserializeNoChecks(ctx, id));
 
-    VectorT<GenericPointerKeeperT> addedPointers;
+    // Containers are taken from cache of current thread and are cleared when request is done
+    ThreadLocalLease<VectorT<GenericPointerKeeperT>> addedPointers;
     if (ctx.allowUnmanagedPointers())
-        ctx.setAddedPointers(&addedPointers);
+        ctx.setAddedPointers(&addedPointers.get());
 
-    context::DPointersMap pointersMap;
+    ThreadLocalLease<context::DPointersMap> pointersMap;
     if (ctx.checkRecursivePointers())
-        ctx.setPointersMap(&pointersMap);
+        ctx.setPointersMap(&pointersMap.get());
 
     IServerDataHandlerBase* pHandler{ nullptr };
     Status status = m_dataHandlersRegistrar->aquireHandler(id, pHandler);
 
+    // Admission lasts until handling is done
+    AdmissionController::Ticket admission;
+
     if (statusSuccess(status))
     {
-        status = pHandler->handleDataCommon(ctx, clientId, binOutput);
+        if (m_pAdmissionController)
+            status = m_pAdmissionController->admit(pHandler->getInputInterface().m_id, id, admission);
+
+        if (statusSuccess(status))
+            status = pHandler->handleDataCommon(ctx, clientId, binOutput);
+
         m_dataHandlersRegistrar->releaseHandler(pHandler);
     }
     else if (status == Status::ErrorMoreEntires) // if we have more than one DataHandler
@@ -205,18 +452,213 @@ AGS_CS_ALWAYS_INLINE Status Server::handleData(context::DCommon& ctxCommon, cons
         RawVectorT<IServerDataHandlerBase*> handlers;
         AGS_CS_RUN(m_dataHandlersRegistrar->aquireHandlers(id, handlers));
 
-        status = Status::NoError;
+        // Multicast message is admitted as one message
+        status = m_pAdmissionController ? m_pAdmissionController->admit(handlers[0]->getInputInterface().m_id, id, admission) : Status::NoError;
 
-        typename BinVectorT::size_type bodyPosition = ctx.getBinaryData().tell();
+        // Policies are checked before deserialization, so that rejected messages don't cost it.
+        // Handlers that comply are moved to the front, the rest are skipped as on separate handling.
+        size_t compliantCount = 0;
 
-        for (auto pHandlerM : handlers)
+        if (statusSuccess(status))
+            for (size_t i = 0; i < handlers.size(); ++i)
+                if (Status policiesStatus = handlers[i]->checkSharedInputPolicies(ctx, clientId); statusSuccess(policiesStatus))
+                    std::swap(handlers[compliantCount++], handlers[i]);
+                else
+                    AGS_CS_SET_NEW_ERROR(policiesStatus);
+
+        // All handlers of the same id have the same input type, so input is deserialized only once
+        // and then is passed to every handler as shared read-only object
+        if (compliantCount)
         {
-            AGS_CS_SET_NEW_ERROR(pHandlerM->handleDataCommon(ctx, clientId, binOutput));
+            GenericPointerKeeperT sharedInput;
+            BinWalkerT& binInput = ctx.getBinaryData();
+            const csp_size_t bodyStart = binInput.tell();
+
+            if (Status inputStatus = handlers[0]->deserializeSharedInput(ctx, sharedInput, binOutput); !statusSuccess(inputStatus))
+            {
+                AGS_CS_SET_NEW_ERROR(inputStatus);
+            }
+            else
+            {
+                // Handlers see input as on separate handling, and after them it is considered read
+                const csp_size_t bodyEnd = binInput.tell();
+                binInput.seek(bodyStart);
+
+                if (m_pExecutor && compliantCount > 1)
+                {
+                    AGS_CS_SET_NEW_ERROR(handleSharedInputConcurrently(handlers.data(), compliantCount, sharedInput, ctx, clientId, binOutput));
+                }
+                else
+                    for (size_t i = 0; i < compliantCount; ++i)
+                        AGS_CS_SET_NEW_ERROR(handlers[i]->handleSharedInput(sharedInput, ctx, clientId, binOutput));
+
+                binInput.seek(bodyEnd);
+            }
+        }
+
+        // Handlers are released on the same thread where they were aquired,
+        // as some registrars are requiring this
+        for (auto pHandlerM : handlers)
             m_dataHandlersRegistrar->releaseHandler(pHandlerM);
-            ctx.getBinaryData().seek(bodyPosition);
+    }
+
+    return status;
+}
+
+inline Status Server::handleBatch(context::DCommon& ctxCommon, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) const
+{
+    Status status = handleBatchItems(ctxCommon, clientId, binOutput);
+
+    // Batch message can't be answered partially, so Status message is sent instead
+    if (!statusSuccess(status))
+        binOutput.clear();
+
+    return status;
+}
+
+inline Status Server::handleBatchItems(context::DCommon& ctxCommon, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) const
+{
+    BinWalkerT& binInput = ctxCommon.getBinaryData();
+
+    // Items share Common Context of Batch message, but correlation id belongs only to the whole message
+    const context::CommonFlags itemCommonFlags{ static_cast<uint32_t>(ctxCommon.getCommonFlags()) & ~context::CommonFlags::kCorrelationId };
+
+    context::SCommon ctxOut(binOutput, ctxCommon.getProtocolVersion(), context::Message::Batch, ctxCommon.getCommonFlags());
+    AGS_CS_RUN(processing::common::ContextProcessor::serializeNoChecks(ctxOut));
+
+    // Input and output of every item are reused to not allocate memory on each of them
+    BinWalkerT itemInput;
+    BinWalkerT itemOutput;
+
+    while (binInput.tell() < binInput.size())
+    {
+        context::Message itemType = context::Message::Data;
+        csp_size_t itemSize = 0;
+        AGS_CS_RUN(processing::batch::ContextProcessor::deserializeItem(ctxCommon, itemType, itemSize));
+
+        if (itemType != context::Message::Data)
+            return Status::ErrorDataCorrupted;
+
+        // Handler sees only its own item, so it can't read past it
+        itemInput.clear();
+        AGS_CS_RUN(itemInput.pushBackN(binInput.data() + binInput.tell(), itemSize));
+        AGS_CS_RUN(itemInput.seek(0));
+        AGS_CS_RUN(binInput.seek(binInput.tell() + itemSize));
+
+        context::DCommon ctxItem(itemInput, ctxCommon.getProtocolVersion(), context::Message::Data, itemCommonFlags);
+        itemOutput.clear();
+
+        Status itemStatus = handleData(ctxItem, clientId, itemOutput.getVector());
+
+        if (itemOutput.size() == 0)
+            AGS_CS_RUN(processing::status::Helpers::serializeFullContext(itemOutput.getVector(), ctxCommon.getProtocolVersion(), itemCommonFlags, itemStatus));
+
+        // Item response is packed without its own Common Context
+        context::DCommon ctxItemOut(itemOutput);
+        AGS_CS_RUN(processing::common::ContextProcessor::deserializeNoChecks(ctxItemOut));
+
+        csp_size_t sizeOffset = 0;
+        AGS_CS_RUN(processing::batch::ContextProcessor::serializeItemBegin(ctxOut, ctxItemOut.getMessageType(), sizeOffset));
+        AGS_CS_RUN(binOutput.pushBackN(itemOutput.data() + itemOutput.tell(), itemOutput.size() - itemOutput.tell()));
+        AGS_CS_RUN(processing::batch::ContextProcessor::serializeItemEnd(ctxOut, sizeOffset));
+    }
+
+    return Status::NoError;
+}
+
+inline Status Server::handleSharedInputConcurrently(IServerDataHandlerBase* const* pHandlers, size_t handlersCount, const GenericPointerKeeperT& sharedInput
+    , context::DData& ctx, const GenericPointerKeeperT& clientId, BinVectorT& binOutput) const
+{
+    class MulticastTask : public IExecutor::ITask
+    {
+    public:
+        MulticastTask(IServerDataHandlerBase* pHandler, const GenericPointerKeeperT& sharedInput, context::DData& ctx
+            , const GenericPointerKeeperT& clientId, LatchT& done) noexcept
+            : m_pHandler(pHandler), m_sharedInput(sharedInput), m_ctx(ctx), m_clientId(clientId), m_done(done)
+        { }
+
+        void run() noexcept override
+        {
+            m_status = m_pHandler->handleSharedInput(m_sharedInput, m_ctx, m_clientId, m_binOutput);
+            m_done.count_down();
+        }
+
+        Status getStatus() const noexcept { return m_status; }
+        const BinVectorT& getBinOutput() const noexcept { return m_binOutput; }
+
+    private:
+        IServerDataHandlerBase* m_pHandler{ nullptr };
+        const GenericPointerKeeperT& m_sharedInput;
+        context::DData& m_ctx;
+        const GenericPointerKeeperT& m_clientId;
+        LatchT& m_done;
+        BinVectorT m_binOutput;
+        Status m_status{ Status::NoError };
+    };
+
+    Status status{ Status::NoError };
+    RawVectorT<MulticastTask*> tasks;
+    LatchT done(static_cast<std::ptrdiff_t>(handlersCount));
+
+    // If there is no memory even for tasks, handlers are just run sequentially
+    if (!statusSuccess(tasks.reserve(handlersCount)))
+    {
+        for (size_t i = 0; i < handlersCount; ++i)
+            AGS_CS_SET_NEW_ERROR(pHandlers[i]->handleSharedInput(sharedInput, ctx, clientId, binOutput));
+
+        return status;
+    }
+
+    for (size_t i = 0; i < handlersCount; ++i)
+    {
+        IServerDataHandlerBase* pHandler = pHandlers[i];
+        MulticastTask* pTask = new (std::nothrow) MulticastTask(pHandler, sharedInput, ctx, clientId, done);
+        if (!pTask)
+        {
+            AGS_CS_SET_NEW_ERROR(pHandler->handleSharedInput(sharedInput, ctx, clientId, binOutput));
+            done.count_down();
+            continue;
         }
+
+        tasks.pushBack(pTask);
+    }
+
+    // The first task is run on current thread, because it would be idle anyway
+    for (size_t i = 1; i < tasks.size(); ++i)
+        if (!statusSuccess(m_pExecutor->execute(*tasks[i])))
+            tasks[i]->run();
+
+    if (tasks.size())
+        tasks[0]->run();
+
+    // Current thread may be one of executor threads, and then tasks that are still queued
+    // could wait for it forever. So tasks that are not started yet are taken back and run here.
+    for (size_t i = tasks.size(); i-- > 1;)
+        if (m_pExecutor->cancel(*tasks[i]))
+            tasks[i]->run();
+
+    done.wait();
+
+    // Output of the last handler that produced any output is used, as it would be on sequential run
+    const BinVectorT* pBinOutput{ nullptr };
+
+    for (auto pTask : tasks)
+    {
+        AGS_CS_SET_NEW_ERROR(pTask->getStatus());
+
+        if (pTask->getBinOutput().size())
+            pBinOutput = &pTask->getBinOutput();
     }
 
+    if (pBinOutput)
+    {
+        binOutput.clear();
+        AGS_CS_SET_NEW_ERROR(binOutput.pushBackN(pBinOutput->data(), pBinOutput->size()));
+    }
+
+    for (auto pTask : tasks)
+        delete pTask;
+
     return status;
 }
 
@@ -0,0 +1,313 @@
+/**
+ * @file common_serialization/csp_messaging/ServerExecutor.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <common_serialization/concurrency_interfaces/GuardRW.h>
+#include <common_serialization/csp_messaging/MpmcQueue.h>
+#include <common_serialization/csp_messaging/Server.h>
+
+#include <thread>
+
+namespace common_serialization::csp::messaging
+{
+
+/// @brief Front-end of Server that handles incoming messages on pool of workers
+/// @details Messages are put in lock-free queues and taken from them by workers.
+///     Every priority lane of Server admission controller has its own queue
+///     and workers take messages of higher lanes first. To not starve lower lanes
+///     under sustained traffic of higher ones, every kLaneTurnPeriod-th message is taken
+///     starting from the next lane in turn, so every non-empty lane gets at least
+///     1 / (kLaneTurnPeriod * kPrioritiesCount) of messages.
+///     Every worker has its own output buffer that is reused between messages
+///     and Server reuses its per-thread deserialization scratch on worker threads.
+///     Workers that have nothing to do are sleeping, and producers wake them
+///     only when someone is actually sleeping.
+class ServerExecutor
+{
+public:
+    /// @brief Message that is handled by executor
+    /// @note Request object must stay alive until complete() is called
+    class IRequest
+    {
+    public:
+        /// @brief Get input message
+        /// @return Walker that is positioned on message start
+        virtual BinWalkerT& getInput() noexcept = 0;
+
+        /// @brief Get id of client that sent message
+        /// @return Client id
+        virtual const GenericPointerKeeperT& getClientId() noexcept = 0;
+
+        /// @brief Called once on worker thread when message is handled
+        /// @param status Status of handling
+        /// @param output Response message. Buffer belongs to worker and is valid only during call,
+        ///     but its content may be swapped or moved out.
+        virtual void complete(Status status, BinVectorT& output) noexcept = 0;
+
+    protected:
+        ~IRequest() = default;
+    };
+
+    /// @brief Default capacity of queue
+    static constexpr size_t kDefaultQueueCapacity = 1024;
+
+    /// @brief Constructor
+    /// @param server Server that handles messages (must outlive executor)
+    explicit ServerExecutor(const Server& server) noexcept;
+    ServerExecutor(const ServerExecutor&) = delete;
+    ServerExecutor& operator=(const ServerExecutor&) = delete;
+    ~ServerExecutor() noexcept;
+
+    /// @brief Start workers
+    /// @param workersCount Number of workers
+    /// @param queueCapacity Maximum number of messages of every priority lane waiting for handling (must be power of two)
+    /// @param maxQueueDepth Number of messages of priority lane waiting for handling
+    ///     starting from which new ones of it are rejected (0 means queue capacity)
+    /// @return Status of operation
+    /// @note Can be inited one time
+    Status init(uint32_t workersCount, size_t queueCapacity = kDefaultQueueCapacity, size_t maxQueueDepth = 0) noexcept;
+
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] bool isValid() const noexcept;
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] uint32_t getWorkersCount() const noexcept;
+
+    /// @brief Get approximate number of messages waiting for handling
+    /// @return Number of messages
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] size_t getQueueSize() const noexcept;
+
+    /// @brief Schedule message for handling
+    /// @param request Request with message
+    /// @return Status of operation. If queue of message priority lane is full ErrorBusy is returned.
+    ///     If it is not successful request will not be completed.
+    Status submit(IRequest& request) noexcept;
+
+    /// @brief Handle all scheduled messages and stop workers
+    /// @note Requests that are submitted concurrently with stop are either
+    ///     rejected or completed before workers exit
+    void stop() noexcept;
+
+private:
+    // Output buffers that grown bigger are freed after message handling
+    static constexpr size_t kMaxRetainedBufferSize = 1024 * 1024;
+    static constexpr uint32_t kSpinCount = 64;
+    static constexpr uint32_t kLaneTurnPeriod = 8;
+
+    void workerRoutine() noexcept;
+    bool waitForRequest(IRequest*& pRequest, uint32_t& popsCount) noexcept;
+    bool tryPopRequest(IRequest*& pRequest, uint32_t& popsCount) noexcept;
+
+    const Server& m_server;
+    MpmcQueue<IRequest*> m_queues[AdmissionController::kPrioritiesCount];
+    size_t m_maxQueueDepth{ 0 };
+    VectorT<ThreadT> m_threads;
+    AtomicUint32T m_sleepingWorkers{ 0 };
+    // Number of submit calls that passed stop check and not yet pushed request
+    AtomicUint32T m_submittingCount{ 0 };
+    // New requests are rejected
+    AtomicBoolT m_stop{ false };
+    // Workers exit when queues are empty
+    AtomicBoolT m_exit{ false };
+    MutexT m_sleepMutex;
+    ConditionVariableT m_sleepCv;
+};
+
+inline ServerExecutor::ServerExecutor(const Server& server) noexcept
+    : m_server(server)
+{
+}
+
+inline ServerExecutor::~ServerExecutor() noexcept
+{
+    stop();
+}
+
+inline Status ServerExecutor::init(uint32_t workersCount, size_t queueCapacity, size_t maxQueueDepth) noexcept
+{
+    if (isValid())
+        return Status::ErrorAlreadyInited;
+
+    if (workersCount == 0)
+        return Status::ErrorInvalidArgument;
+
+    for (auto& queue : m_queues)
+        AGS_CS_RUN(queue.init(queueCapacity));
+
+    m_maxQueueDepth = maxQueueDepth == 0 || maxQueueDepth > queueCapacity ? queueCapacity : maxQueueDepth;
+
+    AGS_CS_RUN(m_threads.reserve(workersCount));
+
+    for (uint32_t i = 0; i < workersCount; ++i)
+        if (Status status = m_threads.emplaceBack([this] { workerRoutine(); }); !statusSuccess(status))
+        {
+            // Workers that are already started must not outlive failed init
+            stop();
+            return status;
+        }
+
+    return Status::NoError;
+}
+
+AGS_CS_ALWAYS_INLINE bool ServerExecutor::isValid() const noexcept
+{
+    return m_threads.size() != 0;
+}
+
+AGS_CS_ALWAYS_INLINE uint32_t ServerExecutor::getWorkersCount() const noexcept
+{
+    return static_cast<uint32_t>(m_threads.size());
+}
+
+AGS_CS_ALWAYS_INLINE size_t ServerExecutor::getQueueSize() const noexcept
+{
+    size_t size = 0;
+
+    for (const auto& queue : m_queues)
+        size += queue.size();
+
+    return size;
+}
+
+inline Status ServerExecutor::submit(IRequest& request) noexcept
+{
+    if (!isValid())
+        return Status::ErrorNotInited;
+
+    // Pairs with stop flag set and counter check in stop(),
+    // so either we see stop or stop waits until request is pushed
+    m_submittingCount.fetch_add(1, std::memory_order_seq_cst);
+
+    if (m_stop.load(std::memory_order_seq_cst))
+    {
+        m_submittingCount.fetch_sub(1, std::memory_order_release);
+        return Status::ErrorNotInited;
+    }
+
+    MpmcQueue<IRequest*>& queue = m_queues[static_cast<size_t>(m_server.getMessagePriority(request.getInput()))];
+
+    // Size is approximate, so depth limit is soft while capacity is a hard one
+    const bool pushed = queue.size() < m_maxQueueDepth && statusSuccess(queue.tryPush(&request));
+
+    m_submittingCount.fetch_sub(1, std::memory_order_release);
+
+    if (!pushed)
+        return Status::ErrorBusy;
+
+    // Pairs with increment of sleeping workers counter before last check of queue,
+    // so either worker sees new request or we see sleeping worker
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_sleepingWorkers.load(std::memory_order_relaxed) != 0)
+    {
+        WGuard guard(m_sleepMutex);
+        m_sleepCv.notify_one();
+    }
+
+    return Status::NoError;
+}
+
+inline void ServerExecutor::stop() noexcept
+{
+    m_stop.store(true, std::memory_order_seq_cst);
+
+    // Workers may exit only when every accepted request is in the queue
+    while (m_submittingCount.load(std::memory_order_seq_cst) != 0)
+        std::this_thread::yield();
+
+    {
+        WGuard guard(m_sleepMutex);
+        m_exit.store(true, std::memory_order_relaxed);
+    }
+
+    m_sleepCv.notify_all();
+
+    // Workers are draining the queue before exit, so all scheduled requests are completed
+    for (auto& thread : m_threads)
+        thread.join();
+
+    m_threads.clear();
+}
+
+inline void ServerExecutor::workerRoutine() noexcept
+{
+    BinVectorT output;
+    IRequest* pRequest{ nullptr };
+    uint32_t popsCount{ 0 };
+
+    while (waitForRequest(pRequest, popsCount))
+    {
+        output.clear();
+
+        Status status = m_server.handleMessage(pRequest->getInput(), pRequest->getClientId(), output);
+        pRequest->complete(status, output);
+
+        if (output.capacity() > kMaxRetainedBufferSize)
+            output.invalidate();
+    }
+}
+
+inline bool ServerExecutor::waitForRequest(IRequest*& pRequest, uint32_t& popsCount) noexcept
+{
+    for (uint32_t i = 0; i < kSpinCount; ++i)
+        if (tryPopRequest(pRequest, popsCount))
+            return true;
+
+    WGuard guard(m_sleepMutex);
+
+    while (true)
+    {
+        m_sleepingWorkers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        bool popped = tryPopRequest(pRequest, popsCount);
+
+        if (!popped && !m_exit.load(std::memory_order_relaxed))
+            m_sleepCv.wait(guard);
+
+        m_sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+
+        if (popped)
+            return true;
+        else if (m_exit.load(std::memory_order_relaxed))
+            return tryPopRequest(pRequest, popsCount);
+    }
+}
+
+inline bool ServerExecutor::tryPopRequest(IRequest*& pRequest, uint32_t& popsCount) noexcept
+{
+    constexpr size_t kLanesCount = AdmissionController::kPrioritiesCount;
+
+    // Queues are in order of priority lanes
+    const size_t firstLane = popsCount % kLaneTurnPeriod == kLaneTurnPeriod - 1 ? popsCount / kLaneTurnPeriod % kLanesCount : 0;
+
+    for (size_t i = 0; i < kLanesCount; ++i)
+        if (m_queues[(firstLane + i) % kLanesCount].tryPop(pRequest))
+        {
+            ++popsCount;
+            return true;
+        }
+
+    return false;
+}
+
+} // namespace common_serialization::csp::messaging
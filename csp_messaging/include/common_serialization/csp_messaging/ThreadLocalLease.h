@@ -0,0 +1,105 @@
+/**
+ * @file common_serialization/csp_messaging/ThreadLocalLease.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
+
+namespace common_serialization::csp::messaging
+{
+
+/// @brief Lends container of current thread for the time of one request processing
+/// @details Container is taken on first call of get() and is cleared (not destroyed)
+///     when lease ends, so its allocated storage is reused by next requests
+///     of the same thread.
+/// @note When request is processed from inside of another one on the same thread,
+///     the nested request uses container of its own lease.
+/// @tparam T Container type that has clear() method. Type may do its own bookkeeping
+///     in clear(), for example shrinking storage that was not used for a long time.
+template<typename T>
+class ThreadLocalLease
+{
+public:
+    ThreadLocalLease() = default;
+    ThreadLocalLease(const ThreadLocalLease&) = delete;
+    ThreadLocalLease& operator=(const ThreadLocalLease&) = delete;
+    ~ThreadLocalLease() noexcept;
+
+    /// @brief Get leased container
+    /// @return Empty container on first call
+    [[nodiscard]] T& get() noexcept;
+
+private:
+    struct Cache
+    {
+        T object;
+        bool isLeased{ false };
+    };
+
+    static Cache& getCache() noexcept;
+
+    Cache* m_pCache{ nullptr };
+    T* m_pObject{ nullptr };
+    T m_ownObject;
+};
+
+template<typename T>
+ThreadLocalLease<T>::~ThreadLocalLease() noexcept
+{
+    if (m_pCache)
+    {
+        m_pCache->object.clear();
+        m_pCache->isLeased = false;
+    }
+}
+
+template<typename T>
+T& ThreadLocalLease<T>::get() noexcept
+{
+    if (!m_pObject)
+    {
+        Cache& cache = getCache();
+
+        if (!cache.isLeased)
+        {
+            cache.isLeased = true;
+            m_pCache = &cache;
+            m_pObject = &cache.object;
+        }
+        else
+            m_pObject = &m_ownObject;
+    }
+
+    return *m_pObject;
+}
+
+template<typename T>
+typename ThreadLocalLease<T>::Cache& ThreadLocalLease<T>::getCache() noexcept
+{
+    thread_local Cache cache;
+
+    return cache;
+}
+
+} // namespace common_serialization::csp::messaging
@@ -0,0 +1,202 @@
+/**
+ * @file common_serialization/csp_messaging/ThreadPool.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <common_serialization/concurrency_interfaces/GuardRW.h>
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
+#include <common_serialization/csp_messaging/IExecutor.h>
+
+namespace common_serialization::csp::messaging
+{
+
+/// @brief Executor with fixed number of worker threads
+///     and FIFO queue of tasks
+class ThreadPool : public IExecutor
+{
+public:
+    ThreadPool() = default;
+
+    /// @brief Intitializing constructor
+    /// @param threadsCount Number of worker threads
+    explicit ThreadPool(uint32_t threadsCount) noexcept;
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool() noexcept;
+
+    /// @brief Start worker threads
+    /// @param threadsCount Number of worker threads
+    /// @return Status of operation
+    /// @note Can be inited one time
+    Status init(uint32_t threadsCount) noexcept;
+
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] bool isValid() const noexcept;
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] uint32_t getThreadsCount() const noexcept;
+
+    Status execute(ITask& task) noexcept override;
+    bool cancel(ITask& task) noexcept override;
+
+private:
+    void stop() noexcept;
+    void workerRoutine() noexcept;
+
+    VectorT<ThreadT> m_threads;
+    ITask* m_pQueueHead{ nullptr };
+    ITask* m_pQueueTail{ nullptr };
+    bool m_stop{ false };
+    MutexT m_queueMutex;
+    ConditionVariableT m_queueCv;
+};
+
+inline ThreadPool::ThreadPool(uint32_t threadsCount) noexcept
+{
+    init(threadsCount);
+}
+
+inline ThreadPool::~ThreadPool() noexcept
+{
+    stop();
+}
+
+inline Status ThreadPool::init(uint32_t threadsCount) noexcept
+{
+    if (isValid())
+        return Status::ErrorAlreadyInited;
+
+    if (threadsCount == 0)
+        return Status::ErrorInvalidArgument;
+
+    AGS_CS_RUN(m_threads.reserve(threadsCount));
+
+    for (uint32_t i = 0; i < threadsCount; ++i)
+        if (Status status = m_threads.emplaceBack([this] { workerRoutine(); }); !statusSuccess(status))
+        {
+            // Workers that are already started must not outlive failed init
+            stop();
+            return status;
+        }
+
+    return Status::NoError;
+}
+
+AGS_CS_ALWAYS_INLINE bool ThreadPool::isValid() const noexcept
+{
+    return m_threads.size() != 0;
+}
+
+AGS_CS_ALWAYS_INLINE uint32_t ThreadPool::getThreadsCount() const noexcept
+{
+    return static_cast<uint32_t>(m_threads.size());
+}
+
+inline Status ThreadPool::execute(ITask& task) noexcept
+{
+    if (!isValid())
+        return Status::ErrorNotInited;
+
+    task.pNextTask = nullptr;
+
+    {
+        WGuard guard(m_queueMutex);
+
+        if (m_pQueueTail)
+            m_pQueueTail->pNextTask = &task;
+        else
+            m_pQueueHead = &task;
+
+        m_pQueueTail = &task;
+    }
+
+    m_queueCv.notify_one();
+
+    return Status::NoError;
+}
+
+inline bool ThreadPool::cancel(ITask& task) noexcept
+{
+    WGuard guard(m_queueMutex);
+
+    ITask* pPrevTask{ nullptr };
+
+    for (ITask* pTask = m_pQueueHead; pTask; pPrevTask = pTask, pTask = pTask->pNextTask)
+        if (pTask == &task)
+        {
+            if (pPrevTask)
+                pPrevTask->pNextTask = pTask->pNextTask;
+            else
+                m_pQueueHead = pTask->pNextTask;
+
+            if (m_pQueueTail == pTask)
+                m_pQueueTail = pPrevTask;
+
+            return true;
+        }
+
+    return false;
+}
+
+inline void ThreadPool::stop() noexcept
+{
+    {
+        WGuard guard(m_queueMutex);
+        m_stop = true;
+    }
+
+    m_queueCv.notify_all();
+
+    // Workers are draining the queue before exit, so all scheduled tasks are run
+    for (auto& thread : m_threads)
+        thread.join();
+
+    m_threads.clear();
+
+    // Pool may be inited again after failed init
+    WGuard guard(m_queueMutex);
+    m_stop = false;
+}
+
+inline void ThreadPool::workerRoutine() noexcept
+{
+    while (true)
+    {
+        ITask* pTask{ nullptr };
+
+        {
+            WGuard guard(m_queueMutex);
+            m_queueCv.wait(guard, [this] { return m_pQueueHead || m_stop; });
+
+            if (!m_pQueueHead)
+                return;
+
+            pTask = m_pQueueHead;
+            m_pQueueHead = pTask->pNextTask;
+
+            if (!m_pQueueHead)
+                m_pQueueTail = nullptr;
+        }
+
+        pTask->run();
+    }
+}
+
+} // namespace common_serialization::csp::messaging
@@ -24,12 +24,23 @@
 #pragma once
 
 #include <common_serialization/csp_messaging/csp_messaging_config.h>
+#include <common_serialization/csp_messaging/AdmissionController.h>
 #include <common_serialization/csp_messaging/Client.h>
+#include <common_serialization/csp_messaging/ClientSettingsCache.h>
 #include <common_serialization/csp_messaging/IClientDataHandlerTraits.h>
 #include <common_serialization/csp_messaging/GenericServerDataHandlerRegistrar.h>
+#include <common_serialization/csp_messaging/HandlerMetrics.h>
+#include <common_serialization/csp_messaging/IExecutor.h>
 #include <common_serialization/csp_messaging/IServerDataHandler.h>
 #include <common_serialization/csp_messaging/IServerDataHandlerBase.h>
 #include <common_serialization/csp_messaging/IServerDataHandlerRegistrar.h>
 #include <common_serialization/csp_messaging/IServerDataHandlerTraits.h>
+#include <common_serialization/csp_messaging/MpmcQueue.h>
+#include <common_serialization/csp_messaging/ObjectsPool.h>
+#include <common_serialization/csp_messaging/RcuServerDataHandlerRegistrar.h>
+#include <common_serialization/csp_messaging/ResponseCache.h>
 #include <common_serialization/csp_messaging/Server.h>
+#include <common_serialization/csp_messaging/ServerExecutor.h>
+#include <common_serialization/csp_messaging/ThreadLocalLease.h>
+#include <common_serialization/csp_messaging/ThreadPool.h>
 #include <common_serialization/csp_messaging/service_structs/service_structs.h>
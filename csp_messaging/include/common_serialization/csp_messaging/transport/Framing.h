@@ -0,0 +1,397 @@
+/**
+ * @file common_serialization/csp_messaging/transport/Framing.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
+
+namespace common_serialization::csp::messaging::transport
+{
+
+/// @brief Envelope in which CSP messages are sent over streaming transports
+/// @details Common context of CSP message has no total length field,
+///     so stream receiver can't find message end without parsing message.
+///     Envelope is a 32-bit little-endian word that holds message size in lower 31 bits
+///     and flag of checksum presence in highest bit. If flag is set, the word is followed
+///     by 32-bit little-endian CRC-32C of message. After that message itself goes.
+class Framing
+{
+public:
+    static constexpr uint32_t kMaxMessageSize = 0x7fffffff;
+    static constexpr uint32_t kChecksumFlag = 0x80000000;
+    static constexpr size_t kMinHeaderSize = sizeof(uint32_t);
+    static constexpr size_t kMaxHeaderSize = 2 * sizeof(uint32_t);
+
+    struct FrameHeader
+    {
+        size_t headerSize{ 0 };
+        uint32_t messageSize{ 0 };
+        bool withChecksum{ false };
+        uint32_t checksum{ 0 };
+    };
+
+    /// @brief Make envelope for message
+    /// @param p Message
+    /// @param size Size of message
+    /// @param withChecksum Should checksum be added
+    /// @param header Buffer for envelope
+    /// @param headerSize Size of envelope
+    /// @return Status of operation
+    static constexpr Status makeHeader(const uint8_t* p, size_t size, bool withChecksum
+        , uint8_t (&header)[kMaxHeaderSize], size_t& headerSize) noexcept;
+
+    /// @brief Get size of envelope by its first kMinHeaderSize bytes
+    /// @param p Start of envelope
+    /// @return Size of envelope
+    static constexpr [[nodiscard]] size_t getHeaderSize(const uint8_t* p) noexcept;
+
+    /// @brief Parse envelope
+    /// @param p Start of envelope (getHeaderSize() bytes must be available)
+    /// @param maxMessageSize Maximum allowed size of message
+    /// @param header Parsed envelope
+    /// @return Status of operation
+    static constexpr Status parseHeader(const uint8_t* p, uint32_t maxMessageSize, FrameHeader& header) noexcept;
+
+    /// @brief Check message against its envelope
+    /// @param header Envelope of message
+    /// @param p Message
+    /// @return Status of operation
+    static constexpr Status checkMessage(const FrameHeader& header, const uint8_t* p) noexcept;
+
+    /// @brief Calculate CRC-32C (Castagnoli)
+    /// @param p Data
+    /// @param size Size of data
+    /// @return Checksum
+    static constexpr [[nodiscard]] uint32_t crc32c(const uint8_t* p, size_t size) noexcept;
+
+private:
+    static constexpr uint32_t kCrc32cPolynomial = 0x82f63b78;
+
+    struct Crc32cTable
+    {
+        constexpr Crc32cTable() noexcept;
+
+        uint32_t values[256]{};
+    };
+
+    static const Crc32cTable kCrc32cTable;
+
+    static constexpr uint32_t readLittleEndian(const uint8_t* p) noexcept;
+    static constexpr void writeLittleEndian(uint32_t value, uint8_t* p) noexcept;
+};
+
+/// @brief Reader that accumulates bytes of stream and yields complete messages
+/// @details Bytes are read by caller directly into free space of internal buffer,
+///     so one read may bring many messages. Messages are not copied: buffer walker
+///     is positioned on message start and its size is limited by message end
+///     while message is being handled.
+class FrameReader
+{
+public:
+    /// @brief Constructor
+    /// @param maxMessageSize Maximum allowed size of message
+    explicit FrameReader(uint32_t maxMessageSize = Framing::kMaxMessageSize) noexcept;
+
+    /// @brief Get free space at the end of buffer for reading stream into
+    /// @details If beginning of incomplete message is already in buffer,
+    ///     free space is enough to hold message remainder
+    /// @param minSize Minimum size of free space
+    /// @param p Start of free space
+    /// @param size Size of free space
+    /// @return Status of operation
+    Status getFreeSpace(size_t minSize, uint8_t*& p, size_t& size) noexcept;
+
+    /// @brief Mark bytes of free space as received
+    /// @param size Number of received bytes
+    /// @return Status of operation
+    Status commitFreeSpace(size_t size) noexcept;
+
+    /// @brief Copy bytes in buffer
+    /// @param p Bytes
+    /// @param size Number of bytes
+    /// @return Status of operation
+    Status append(const uint8_t* p, size_t size) noexcept;
+
+    /// @brief Get next complete message
+    /// @details Previous message becomes invalid
+    /// @param pMessage Walker positioned on message start and limited by message end
+    ///     or nullptr if there is no complete message yet
+    /// @return Status of operation. If envelope is not valid stream can't be read further.
+    Status getNextMessage(BinWalkerT*& pMessage) noexcept;
+
+    /// @brief Has last message returned by getNextMessage() a checksum
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] bool isLastMessageWithChecksum() const noexcept;
+
+    /// @brief Get number of received bytes that are not yet returned as messages
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] size_t getPendingSize() const noexcept;
+
+    /// @brief Free buffer memory if there is no pending bytes and buffer is bigger than given size
+    /// @param maxRetainedSize Maximum size of buffer that is kept
+    void shrink(size_t maxRetainedSize) noexcept;
+
+    void clear() noexcept;
+
+private:
+    void releaseMessage() noexcept;
+
+    BinWalkerT m_buffer;
+    uint32_t m_maxMessageSize{ Framing::kMaxMessageSize };
+    size_t m_dataSize{ 0 };
+    size_t m_consumedSize{ 0 };
+    size_t m_messageEnd{ 0 };
+    bool m_messageIssued{ false };
+    bool m_lastMessageWithChecksum{ false };
+};
+
+constexpr Status Framing::makeHeader(const uint8_t* p, size_t size, bool withChecksum
+    , uint8_t (&header)[kMaxHeaderSize], size_t& headerSize) noexcept
+{
+    if (size > kMaxMessageSize)
+        return Status::ErrorOverflow;
+
+    writeLittleEndian(static_cast<uint32_t>(size) | (withChecksum ? kChecksumFlag : 0), header);
+    headerSize = kMinHeaderSize;
+
+    if (withChecksum)
+    {
+        writeLittleEndian(crc32c(p, size), header + kMinHeaderSize);
+        headerSize = kMaxHeaderSize;
+    }
+
+    return Status::NoError;
+}
+
+constexpr size_t Framing::getHeaderSize(const uint8_t* p) noexcept
+{
+    return readLittleEndian(p) & kChecksumFlag ? kMaxHeaderSize : kMinHeaderSize;
+}
+
+constexpr Status Framing::parseHeader(const uint8_t* p, uint32_t maxMessageSize, FrameHeader& header) noexcept
+{
+    const uint32_t sizeAndFlags = readLittleEndian(p);
+
+    header.messageSize = sizeAndFlags & ~kChecksumFlag;
+    header.withChecksum = (sizeAndFlags & kChecksumFlag) != 0;
+    header.headerSize = header.withChecksum ? kMaxHeaderSize : kMinHeaderSize;
+    header.checksum = header.withChecksum ? readLittleEndian(p + kMinHeaderSize) : 0;
+
+    return header.messageSize > maxMessageSize ? Status::ErrorOverflow : Status::NoError;
+}
+
+constexpr Status Framing::checkMessage(const FrameHeader& header, const uint8_t* p) noexcept
+{
+    return !header.withChecksum || crc32c(p, header.messageSize) == header.checksum
+        ? Status::NoError
+        : Status::ErrorDataCorrupted;
+}
+
+constexpr Framing::Crc32cTable::Crc32cTable() noexcept
+{
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t value = i;
+
+        for (int bit = 0; bit < 8; ++bit)
+            value = value & 1 ? (value >> 1) ^ kCrc32cPolynomial : value >> 1;
+
+        values[i] = value;
+    }
+}
+
+inline constexpr Framing::Crc32cTable Framing::kCrc32cTable{};
+
+constexpr uint32_t Framing::crc32c(const uint8_t* p, size_t size) noexcept
+{
+    uint32_t crc = 0xffffffff;
+
+    for (size_t i = 0; i < size; ++i)
+        crc = kCrc32cTable.values[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+
+    return ~crc;
+}
+
+constexpr uint32_t Framing::readLittleEndian(const uint8_t* p) noexcept
+{
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8
+        | static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+constexpr void Framing::writeLittleEndian(uint32_t value, uint8_t* p) noexcept
+{
+    for (size_t i = 0; i < sizeof(uint32_t); ++i)
+        p[i] = static_cast<uint8_t>(value >> (i * 8));
+}
+
+inline FrameReader::FrameReader(uint32_t maxMessageSize) noexcept
+    : m_maxMessageSize(maxMessageSize < Framing::kMaxMessageSize ? maxMessageSize : Framing::kMaxMessageSize)
+{
+}
+
+inline Status FrameReader::getFreeSpace(size_t minSize, uint8_t*& p, size_t& size) noexcept
+{
+    releaseMessage();
+
+    BinVectorT& buffer = m_buffer.getVector();
+
+    if (m_consumedSize == m_dataSize)
+    {
+        m_consumedSize = m_dataSize = 0;
+        buffer.clear();
+    }
+
+    const size_t pendingSize = getPendingSize();
+    size_t requiredSize = minSize;
+
+    // If envelope of incomplete message is already here, make room for whole message at once
+    if (pendingSize >= Framing::kMinHeaderSize
+        && pendingSize >= Framing::getHeaderSize(buffer.data() + m_consumedSize))
+    {
+        Framing::FrameHeader header;
+        AGS_CS_RUN(Framing::parseHeader(buffer.data() + m_consumedSize, m_maxMessageSize, header));
+
+        // Buffer may already hold complete message followed by part of the next one
+        const size_t frameSize = header.headerSize + header.messageSize;
+        if (pendingSize < frameSize && frameSize - pendingSize > requiredSize)
+            requiredSize = frameSize - pendingSize;
+    }
+
+    // Consumed bytes are dropped only when there is not enough room after data
+    if (m_consumedSize != 0 && buffer.capacity() - m_dataSize < requiredSize)
+    {
+        AGS_CS_RUN(buffer.erase(0, m_consumedSize));
+        m_dataSize -= m_consumedSize;
+        m_consumedSize = 0;
+    }
+
+    AGS_CS_RUN(buffer.reserve(m_dataSize + requiredSize));
+
+    p = buffer.data() + m_dataSize;
+    size = buffer.capacity() - m_dataSize;
+
+    return Status::NoError;
+}
+
+inline Status FrameReader::commitFreeSpace(size_t size) noexcept
+{
+    BinVectorT& buffer = m_buffer.getVector();
+
+    if (m_dataSize + size > buffer.capacity())
+        return Status::ErrorOverflow;
+
+    m_dataSize += size;
+
+    return buffer.setSize(m_dataSize);
+}
+
+inline Status FrameReader::append(const uint8_t* p, size_t size) noexcept
+{
+    uint8_t* pFree = nullptr;
+    size_t freeSize = 0;
+
+    AGS_CS_RUN(getFreeSpace(size, pFree, freeSize));
+
+    if (freeSize < size)
+        return Status::ErrorOverflow;
+
+    memcpy(pFree, p, size);
+
+    return commitFreeSpace(size);
+}
+
+inline Status FrameReader::getNextMessage(BinWalkerT*& pMessage) noexcept
+{
+    releaseMessage();
+
+    pMessage = nullptr;
+
+    const size_t pendingSize = getPendingSize();
+    const uint8_t* pFrame = m_buffer.getVector().data() + m_consumedSize;
+
+    if (pendingSize < Framing::kMinHeaderSize || pendingSize < Framing::getHeaderSize(pFrame))
+        return Status::NoError;
+
+    Framing::FrameHeader header;
+    AGS_CS_RUN(Framing::parseHeader(pFrame, m_maxMessageSize, header));
+
+    if (pendingSize < header.headerSize + header.messageSize)
+        return Status::NoError;
+
+    AGS_CS_RUN(Framing::checkMessage(header, pFrame + header.headerSize));
+
+    m_messageEnd = m_consumedSize + header.headerSize + header.messageSize;
+
+    AGS_CS_RUN(m_buffer.getVector().setSize(m_messageEnd));
+    AGS_CS_RUN(m_buffer.seek(m_consumedSize + header.headerSize));
+
+    m_messageIssued = true;
+    m_lastMessageWithChecksum = header.withChecksum;
+    pMessage = &m_buffer;
+
+    return Status::NoError;
+}
+
+AGS_CS_ALWAYS_INLINE bool FrameReader::isLastMessageWithChecksum() const noexcept
+{
+    return m_lastMessageWithChecksum;
+}
+
+AGS_CS_ALWAYS_INLINE size_t FrameReader::getPendingSize() const noexcept
+{
+    return m_dataSize - (m_messageIssued ? m_messageEnd : m_consumedSize);
+}
+
+inline void FrameReader::shrink(size_t maxRetainedSize) noexcept
+{
+    releaseMessage();
+
+    if (getPendingSize() == 0 && m_buffer.getVector().capacity() > maxRetainedSize)
+    {
+        m_buffer.getVector().invalidate();
+        m_consumedSize = m_dataSize = 0;
+    }
+}
+
+inline void FrameReader::clear() noexcept
+{
+    m_buffer.clear();
+    m_dataSize = 0;
+    m_consumedSize = 0;
+    m_messageEnd = 0;
+    m_messageIssued = false;
+    m_lastMessageWithChecksum = false;
+}
+
+inline void FrameReader::releaseMessage() noexcept
+{
+    if (!m_messageIssued)
+        return;
+
+    // Size only grows back over bytes that are already in buffer
+    m_buffer.getVector().setSize(m_dataSize);
+    m_buffer.seek(0);
+    m_consumedSize = m_messageEnd;
+    m_messageIssued = false;
+}
+
+} // namespace common_serialization::csp::messaging::transport
@@ -0,0 +1,456 @@
+/**
+ * @file common_serialization/csp_messaging/transport/SharedMemoryChannel.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <common_serialization/concurrency_interfaces/GuardRW.h>
+#include <common_serialization/csp_messaging/Client.h>
+#include <common_serialization/csp_messaging/Server.h>
+#include <common_serialization/csp_messaging/transport/SharedMemoryRing.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace common_serialization::csp::messaging::transport
+{
+
+/// @brief Shared memory region that holds two rings: for requests from client to server
+///     and for responses from server to client
+/// @details Region is created by one side either as anonymous memory file (memfd),
+///     which descriptor must be passed to another process (by inheritance or over unix socket),
+///     or as named POSIX shared memory object. Another side opens it by descriptor or by name.
+class SharedMemoryChannel
+{
+public:
+    SharedMemoryChannel() = default;
+    SharedMemoryChannel(const SharedMemoryChannel&) = delete;
+    SharedMemoryChannel& operator=(const SharedMemoryChannel&) = delete;
+    ~SharedMemoryChannel() noexcept;
+
+    /// @brief Create channel in anonymous memory file
+    /// @param ringCapacity Capacity of every ring in bytes (must be power of two)
+    /// @return Status of operation
+    Status create(uint32_t ringCapacity) noexcept;
+
+    /// @brief Create channel in named shared memory object
+    /// @param name Name of shared memory object (in shm_open() format)
+    /// @param ringCapacity Capacity of every ring in bytes (must be power of two)
+    /// @return Status of operation
+    /// @note Object is unlinked when creator channel is destroyed
+    Status create(const char* name, uint32_t ringCapacity) noexcept;
+
+    /// @brief Open channel created by another SharedMemoryChannel
+    /// @param fd Descriptor of shared memory (it is duplicated, so caller still owns it)
+    /// @return Status of operation
+    Status open(int fd) noexcept;
+
+    /// @brief Open channel created by another SharedMemoryChannel
+    /// @param name Name of shared memory object
+    /// @return Status of operation
+    Status open(const char* name) noexcept;
+
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] bool isValid() const noexcept;
+
+    /// @brief Get descriptor of shared memory
+    /// @return Descriptor or -1 if channel is not valid
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] int getFd() const noexcept;
+
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] SharedMemoryRing& getRequestsRing() noexcept;
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] SharedMemoryRing& getResponsesRing() noexcept;
+
+    /// @brief Close both rings, so all waiters on them on both sides are woken up
+    void close() noexcept;
+
+private:
+    static constexpr uint32_t kMagic = 0x43505343; // "CSPC"
+    static constexpr size_t kHeaderSize = 64;
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t ringCapacity;
+    };
+
+    static constexpr size_t getRingMemorySize(uint32_t ringCapacity) noexcept;
+
+    Status createInFd(int fd, uint32_t ringCapacity) noexcept;
+    Status openFd(int fd) noexcept;
+    void release() noexcept;
+
+    int m_fd{ -1 };
+    void* m_pMemory{ nullptr };
+    size_t m_memorySize{ 0 };
+    SharedMemoryRing m_requestsRing;
+    SharedMemoryRing m_responsesRing;
+    VectorT<char> m_nameToUnlink;
+};
+
+/// @brief Client side of shared memory channel
+/// @details Every request is put in requests ring, and then response is taken from responses ring.
+///     Requests from different threads are serialized, because rings have single producer
+///     and single consumer.
+class SharedMemoryClientToServerCommunicator : public IClientToServerCommunicator
+{
+public:
+    /// @brief Constructor
+    /// @param channel Channel that must outlive communicator
+    explicit SharedMemoryClientToServerCommunicator(SharedMemoryChannel& channel) noexcept;
+
+    Status process(const BinVectorT& input, BinVectorT& output) override;
+
+private:
+    SharedMemoryChannel& m_channel;
+    MutexT m_mutex;
+};
+
+/// @brief Server side of shared memory channel
+/// @details Takes requests from requests ring, passes them to Server::handleMessage()
+///     and puts responses in responses ring. Buffers are reused between requests.
+class SharedMemoryServerPump
+{
+public:
+    /// @brief Constructor
+    /// @param server Server that handles requests
+    /// @param channel Channel that must outlive pump
+    SharedMemoryServerPump(const Server& server, SharedMemoryChannel& channel) noexcept;
+
+    /// @brief Handle requests until channel is closed
+    /// @note If requests can't be handled anymore, channel is closed,
+    ///     so that client is not waiting for response forever
+    /// @param clientId Id of client which is on other side of channel
+    /// @return Status of operation
+    Status run(const GenericPointerKeeperT& clientId) noexcept;
+
+    /// @brief Handle one request waiting for it if it is needed
+    /// @param clientId Id of client which is on other side of channel
+    /// @return Status of operation. If channel is closed ErrorNotAvailible is returned.
+    Status runOnce(const GenericPointerKeeperT& clientId) noexcept;
+
+private:
+    /// @brief Replace response by Status message with error
+    Status serializeErrorResponse(Status error) noexcept;
+
+    const Server& m_server;
+    SharedMemoryChannel& m_channel;
+    BinWalkerT m_binInput;
+    BinVectorT m_binOutput;
+};
+
+inline SharedMemoryChannel::~SharedMemoryChannel() noexcept
+{
+    release();
+}
+
+inline Status SharedMemoryChannel::create(uint32_t ringCapacity) noexcept
+{
+    if (isValid())
+        return Status::ErrorAlreadyInited;
+
+    int fd = memfd_create("csp_channel", MFD_CLOEXEC);
+    if (fd == -1)
+        return Status::ErrorNotAvailible;
+
+    Status status = createInFd(fd, ringCapacity);
+    if (!statusSuccess(status))
+        ::close(fd);
+
+    return status;
+}
+
+inline Status SharedMemoryChannel::create(const char* name, uint32_t ringCapacity) noexcept
+{
+    if (isValid())
+        return Status::ErrorAlreadyInited;
+
+    if (!name)
+        return Status::ErrorInvalidArgument;
+
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd == -1)
+        return Status::ErrorNotAvailible;
+
+    Status status = createInFd(fd, ringCapacity);
+
+    if (statusSuccess(status))
+        status = m_nameToUnlink.pushBackN(name, strlen(name) + 1);
+
+    if (!statusSuccess(status))
+    {
+        release();
+        ::close(fd);
+        shm_unlink(name);
+    }
+
+    return status;
+}
+
+inline Status SharedMemoryChannel::open(int fd) noexcept
+{
+    if (isValid())
+        return Status::ErrorAlreadyInited;
+
+    int fdCopy = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (fdCopy == -1)
+        return Status::ErrorInvalidArgument;
+
+    Status status = openFd(fdCopy);
+    if (!statusSuccess(status))
+        ::close(fdCopy);
+
+    return status;
+}
+
+inline Status SharedMemoryChannel::open(const char* name) noexcept
+{
+    if (isValid())
+        return Status::ErrorAlreadyInited;
+
+    if (!name)
+        return Status::ErrorInvalidArgument;
+
+    int fd = shm_open(name, O_RDWR | O_CLOEXEC, 0);
+    if (fd == -1)
+        return Status::ErrorNotAvailible;
+
+    Status status = openFd(fd);
+    if (!statusSuccess(status))
+        ::close(fd);
+
+    return status;
+}
+
+AGS_CS_ALWAYS_INLINE bool SharedMemoryChannel::isValid() const noexcept
+{
+    return m_pMemory != nullptr;
+}
+
+AGS_CS_ALWAYS_INLINE int SharedMemoryChannel::getFd() const noexcept
+{
+    return m_fd;
+}
+
+AGS_CS_ALWAYS_INLINE SharedMemoryRing& SharedMemoryChannel::getRequestsRing() noexcept
+{
+    return m_requestsRing;
+}
+
+AGS_CS_ALWAYS_INLINE SharedMemoryRing& SharedMemoryChannel::getResponsesRing() noexcept
+{
+    return m_responsesRing;
+}
+
+inline void SharedMemoryChannel::close() noexcept
+{
+    m_requestsRing.close();
+    m_responsesRing.close();
+}
+
+constexpr size_t SharedMemoryChannel::getRingMemorySize(uint32_t ringCapacity) noexcept
+{
+    // Every ring must start on cache line
+    return (SharedMemoryRing::getRequiredMemorySize(ringCapacity) + kHeaderSize - 1) & ~(kHeaderSize - 1);
+}
+
+inline Status SharedMemoryChannel::createInFd(int fd, uint32_t ringCapacity) noexcept
+{
+    if (ringCapacity == 0 || (ringCapacity & (ringCapacity - 1)) != 0)
+        return Status::ErrorInvalidArgument;
+
+    const size_t memorySize = kHeaderSize + 2 * getRingMemorySize(ringCapacity);
+
+    if (ftruncate(fd, static_cast<off_t>(memorySize)) == -1)
+        return Status::ErrorNoMemory;
+
+    void* pMemory = mmap(nullptr, memorySize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (pMemory == MAP_FAILED)
+        return Status::ErrorNoMemory;
+
+    uint8_t* pRings = static_cast<uint8_t*>(pMemory) + kHeaderSize;
+
+    Status status = m_requestsRing.create(pRings, ringCapacity);
+    if (statusSuccess(status))
+        status = m_responsesRing.create(pRings + getRingMemorySize(ringCapacity), ringCapacity);
+
+    if (!statusSuccess(status))
+    {
+        munmap(pMemory, memorySize);
+        m_requestsRing = SharedMemoryRing{};
+        return status;
+    }
+
+    Header* pHeader = static_cast<Header*>(pMemory);
+    pHeader->ringCapacity = ringCapacity;
+    pHeader->magic = kMagic;
+
+    m_fd = fd;
+    m_pMemory = pMemory;
+    m_memorySize = memorySize;
+
+    return Status::NoError;
+}
+
+inline Status SharedMemoryChannel::openFd(int fd) noexcept
+{
+    struct stat fileStat{};
+    if (fstat(fd, &fileStat) == -1 || static_cast<size_t>(fileStat.st_size) < kHeaderSize)
+        return Status::ErrorInvalidArgument;
+
+    const size_t memorySize = static_cast<size_t>(fileStat.st_size);
+
+    void* pMemory = mmap(nullptr, memorySize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (pMemory == MAP_FAILED)
+        return Status::ErrorNoMemory;
+
+    const Header* pHeader = static_cast<const Header*>(pMemory);
+    const uint32_t ringCapacity = pHeader->ringCapacity;
+    uint8_t* pRings = static_cast<uint8_t*>(pMemory) + kHeaderSize;
+
+    Status status = pHeader->magic == kMagic && memorySize >= kHeaderSize + 2 * getRingMemorySize(ringCapacity)
+        ? Status::NoError
+        : Status::ErrorDataCorrupted;
+
+    if (statusSuccess(status))
+        status = m_requestsRing.attach(pRings, getRingMemorySize(ringCapacity));
+    if (statusSuccess(status))
+        status = m_responsesRing.attach(pRings + getRingMemorySize(ringCapacity), getRingMemorySize(ringCapacity));
+
+    if (!statusSuccess(status))
+    {
+        munmap(pMemory, memorySize);
+        m_requestsRing = SharedMemoryRing{};
+        m_responsesRing = SharedMemoryRing{};
+        return status;
+    }
+
+    m_fd = fd;
+    m_pMemory = pMemory;
+    m_memorySize = memorySize;
+
+    return Status::NoError;
+}
+
+inline void SharedMemoryChannel::release() noexcept
+{
+    if (!isValid())
+        return;
+
+    munmap(m_pMemory, m_memorySize);
+    ::close(m_fd);
+
+    if (m_nameToUnlink.size() != 0)
+        shm_unlink(m_nameToUnlink.data());
+
+    m_nameToUnlink.clear();
+    m_requestsRing = SharedMemoryRing{};
+    m_responsesRing = SharedMemoryRing{};
+    m_fd = -1;
+    m_pMemory = nullptr;
+    m_memorySize = 0;
+}
+
+inline SharedMemoryClientToServerCommunicator::SharedMemoryClientToServerCommunicator(SharedMemoryChannel& channel) noexcept
+    : m_channel(channel)
+{
+}
+
+inline Status SharedMemoryClientToServerCommunicator::process(const BinVectorT& input, BinVectorT& output)
+{
+    if (!m_channel.isValid())
+        return Status::ErrorNotInited;
+
+    if (input.size() > UINT32_MAX)
+        return Status::ErrorOverflow;
+
+    WGuard guard(m_mutex);
+
+    AGS_CS_RUN(m_channel.getRequestsRing().push(input.data(), static_cast<uint32_t>(input.size())));
+
+    return m_channel.getResponsesRing().pop(output);
+}
+
+inline SharedMemoryServerPump::SharedMemoryServerPump(const Server& server, SharedMemoryChannel& channel) noexcept
+    : m_server(server), m_channel(channel)
+{
+}
+
+inline Status SharedMemoryServerPump::run(const GenericPointerKeeperT& clientId) noexcept
+{
+    while (true)
+    {
+        Status status = runOnce(clientId);
+
+        if (status == Status::ErrorNotAvailible)
+            return Status::NoError;
+        else if (!statusSuccess(status))
+        {
+            m_channel.close();
+            return status;
+        }
+    }
+}
+
+inline Status SharedMemoryServerPump::runOnce(const GenericPointerKeeperT& clientId) noexcept
+{
+    if (!m_channel.isValid())
+        return Status::ErrorNotInited;
+
+    AGS_CS_RUN(m_channel.getRequestsRing().pop(m_binInput.getVector()));
+    AGS_CS_RUN(m_binInput.seek(0));
+
+    // Status of handling is always packed in response, so client receives it anyway
+    m_server.handleMessage(m_binInput, clientId, m_binOutput);
+
+    Status status = m_binOutput.size() <= UINT32_MAX
+        ? m_channel.getResponsesRing().push(m_binOutput.data(), static_cast<uint32_t>(m_binOutput.size()))
+        : Status::ErrorOverflow;
+
+    // Response that doesn't fit in ring is replaced by error, because client is waiting for any response
+    if (status == Status::ErrorOverflow)
+    {
+        AGS_CS_RUN(serializeErrorResponse(Status::ErrorOverflow));
+        status = m_channel.getResponsesRing().push(m_binOutput.data(), static_cast<uint32_t>(m_binOutput.size()));
+    }
+
+    return status;
+}
+
+inline Status SharedMemoryServerPump::serializeErrorResponse(Status error) noexcept
+{
+    m_binOutput.clear();
+
+    AGS_CS_RUN(m_binInput.seek(0));
+
+    // Request was already handled by server, so its Common Context is valid
+    context::DCommon ctx(m_binInput, m_server.getSettings().getOldestProtocolVersion());
+    AGS_CS_RUN(processing::common::ContextProcessor::deserialize(ctx));
+    AGS_CS_RUN(processing::status::Helpers::serializeFullContext(m_binOutput, ctx.getProtocolVersion(), ctx.getCommonFlags(), error));
+
+    if (ctx.withCorrelationId())
+        AGS_CS_RUN(processing::common::ContextProcessor::setCorrelationId(m_binOutput, ctx.getCorrelationId()));
+
+    return Status::NoError;
+}
+
+} // namespace common_serialization::csp::messaging::transport
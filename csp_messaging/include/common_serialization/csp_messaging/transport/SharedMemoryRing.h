@@ -0,0 +1,311 @@
+/**
+ * @file common_serialization/csp_messaging/transport/SharedMemoryRing.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <common_serialization/csp_messaging/csp_messaging_config.h>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace common_serialization::csp::messaging::transport
+{
+
+/// @brief Single producer single consumer ring of messages that is placed in memory
+///     shared between processes
+/// @details Every message is stored as 32-bit size followed by message bytes.
+///     Waiting for free space or for data is made by spinning a little
+///     and then by futex, that is woken only when other side is really waiting.
+/// @note Object itself is only a view on shared memory, so every process
+///     has its own SharedMemoryRing object that is attached to the same memory.
+class SharedMemoryRing
+{
+public:
+    /// @brief Get size of memory that ring with given capacity occupies
+    /// @param capacity Capacity of ring data in bytes (must be power of two)
+    /// @return Size of memory in bytes
+    static constexpr [[nodiscard]] size_t getRequiredMemorySize(uint32_t capacity) noexcept;
+
+    /// @brief Create new ring in memory
+    /// @param pMemory Memory of getRequiredMemorySize() size aligned on cache line
+    /// @param capacity Capacity of ring data in bytes (must be power of two)
+    /// @return Status of operation
+    Status create(void* pMemory, uint32_t capacity) noexcept;
+
+    /// @brief Attach to ring that was created in memory by another SharedMemoryRing
+    /// @param pMemory Memory that ring was created in
+    /// @param memorySize Size of memory that is available from pMemory
+    /// @return Status of operation
+    Status attach(void* pMemory, size_t memorySize) noexcept;
+
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] bool isValid() const noexcept;
+
+    /// @brief Put message to the ring waiting for free space if it is needed
+    /// @param p Message
+    /// @param size Message size
+    /// @return Status of operation. If ring is closed ErrorNotAvailible is returned.
+    Status push(const uint8_t* p, uint32_t size) noexcept;
+
+    /// @brief Take message from the ring waiting for it if it is needed
+    /// @param output Message (previous contents are dropped, but capacity is reused)
+    /// @return Status of operation. If ring is closed and empty ErrorNotAvailible is returned.
+    Status pop(BinVectorT& output) noexcept;
+
+    /// @brief Close ring and wake all its waiters
+    void close() noexcept;
+
+private:
+    static constexpr uint32_t kMagic = 0x52505343; // "CSPR"
+    static constexpr uint32_t kSpinCount = 256;
+    static constexpr size_t kCacheLineSize = 64;
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t capacity;
+        AtomicBoolT closed;
+
+        // Producer side
+        alignas(kCacheLineSize) AtomicUint64T writePosition;
+        AtomicUint32T writeSequence;
+        AtomicUint32T consumerWaiters;
+
+        // Consumer side
+        alignas(kCacheLineSize) AtomicUint64T readPosition;
+        AtomicUint32T readSequence;
+        AtomicUint32T producerWaiters;
+    };
+
+    static_assert(AtomicUint32T::is_always_lock_free && AtomicUint64T::is_always_lock_free
+        , "Atomics that are placed in shared memory must be lock free");
+
+    // Wait until predicate is true, sequence is incremented by other side every time when state is changed
+    template<typename Predicate>
+    Status wait(AtomicUint32T& sequence, AtomicUint32T& waiters, Predicate predicate) noexcept;
+    static void wake(AtomicUint32T& sequence, AtomicUint32T& waiters) noexcept;
+
+    void copyIn(uint64_t position, const uint8_t* p, uint32_t size) noexcept;
+    void copyOut(uint64_t position, uint8_t* p, uint32_t size) const noexcept;
+
+    Header* m_pHeader{ nullptr };
+    uint8_t* m_pData{ nullptr };
+    uint32_t m_capacity{ 0 };
+    uint32_t m_mask{ 0 };
+};
+
+constexpr size_t SharedMemoryRing::getRequiredMemorySize(uint32_t capacity) noexcept
+{
+    return sizeof(Header) + capacity;
+}
+
+inline Status SharedMemoryRing::create(void* pMemory, uint32_t capacity) noexcept
+{
+    if (!pMemory || capacity < sizeof(uint32_t) || (capacity & (capacity - 1)) != 0 || reinterpret_cast<uintptr_t>(pMemory) % kCacheLineSize != 0)
+        return Status::ErrorInvalidArgument;
+
+    m_pHeader = new (pMemory) Header{};
+    m_pHeader->capacity = capacity;
+    m_pHeader->magic = kMagic;
+
+    m_pData = static_cast<uint8_t*>(pMemory) + sizeof(Header);
+    m_capacity = capacity;
+    m_mask = capacity - 1;
+
+    return Status::NoError;
+}
+
+inline Status SharedMemoryRing::attach(void* pMemory, size_t memorySize) noexcept
+{
+    if (!pMemory || memorySize < sizeof(Header) || reinterpret_cast<uintptr_t>(pMemory) % kCacheLineSize != 0)
+        return Status::ErrorInvalidArgument;
+
+    Header* pHeader = static_cast<Header*>(pMemory);
+
+    // Header is written by other side, so it can't be trusted. Capacity is read once
+    // and kept locally, so that later changes of it in shared memory can't affect us.
+    const uint32_t capacity = pHeader->capacity;
+
+    if (pHeader->magic != kMagic || capacity < sizeof(uint32_t) || (capacity & (capacity - 1)) != 0
+        || memorySize < getRequiredMemorySize(capacity))
+    {
+        return Status::ErrorDataCorrupted;
+    }
+
+    m_pHeader = pHeader;
+    m_pData = static_cast<uint8_t*>(pMemory) + sizeof(Header);
+    m_capacity = capacity;
+    m_mask = capacity - 1;
+
+    return Status::NoError;
+}
+
+AGS_CS_ALWAYS_INLINE bool SharedMemoryRing::isValid() const noexcept
+{
+    return m_pHeader != nullptr;
+}
+
+inline Status SharedMemoryRing::push(const uint8_t* p, uint32_t size) noexcept
+{
+    if (!isValid())
+        return Status::ErrorNotInited;
+
+    const uint64_t needed = sizeof(uint32_t) + static_cast<uint64_t>(size);
+
+    if (needed > m_capacity)
+        return Status::ErrorOverflow;
+
+    // Only this side changes write position
+    const uint64_t writePosition = m_pHeader->writePosition.load(std::memory_order_relaxed);
+
+    AGS_CS_RUN(wait(m_pHeader->readSequence, m_pHeader->producerWaiters, [this, writePosition, needed]
+        {
+            return m_capacity - (writePosition - m_pHeader->readPosition.load(std::memory_order_acquire)) >= needed;
+        }));
+
+    copyIn(writePosition, reinterpret_cast<const uint8_t*>(&size), sizeof(uint32_t));
+    copyIn(writePosition + sizeof(uint32_t), p, size);
+
+    m_pHeader->writePosition.store(writePosition + needed, std::memory_order_release);
+    wake(m_pHeader->writeSequence, m_pHeader->consumerWaiters);
+
+    return Status::NoError;
+}
+
+inline Status SharedMemoryRing::pop(BinVectorT& output) noexcept
+{
+    if (!isValid())
+        return Status::ErrorNotInited;
+
+    output.clear();
+
+    // Only this side changes read position
+    const uint64_t readPosition = m_pHeader->readPosition.load(std::memory_order_relaxed);
+
+    // Producer publishes size and message at once, so when size is available message is too
+    AGS_CS_RUN(wait(m_pHeader->writeSequence, m_pHeader->consumerWaiters, [this, readPosition]
+        {
+            return m_pHeader->writePosition.load(std::memory_order_acquire) != readPosition;
+        }));
+
+    // Positions and sizes are written by other side, so they can't be trusted either
+    const uint64_t availableSize = m_pHeader->writePosition.load(std::memory_order_acquire) - readPosition;
+
+    if (availableSize > m_capacity)
+        return Status::ErrorDataCorrupted;
+
+    uint32_t size = 0;
+    copyOut(readPosition, reinterpret_cast<uint8_t*>(&size), sizeof(uint32_t));
+
+    const uint64_t needed = sizeof(uint32_t) + static_cast<uint64_t>(size);
+
+    if (needed > m_capacity || needed > availableSize)
+        return Status::ErrorDataCorrupted;
+
+    AGS_CS_RUN(output.reserve(size));
+    AGS_CS_RUN(output.setSize(size));
+    copyOut(readPosition + sizeof(uint32_t), output.data(), size);
+
+    m_pHeader->readPosition.store(readPosition + sizeof(uint32_t) + size, std::memory_order_release);
+    wake(m_pHeader->readSequence, m_pHeader->producerWaiters);
+
+    return Status::NoError;
+}
+
+inline void SharedMemoryRing::close() noexcept
+{
+    if (!isValid())
+        return;
+
+    m_pHeader->closed.store(true, std::memory_order_seq_cst);
+
+    wake(m_pHeader->writeSequence, m_pHeader->consumerWaiters);
+    wake(m_pHeader->readSequence, m_pHeader->producerWaiters);
+}
+
+template<typename Predicate>
+Status SharedMemoryRing::wait(AtomicUint32T& sequence, AtomicUint32T& waiters, Predicate predicate) noexcept
+{
+    for (uint32_t i = 0; i < kSpinCount; ++i)
+        if (predicate())
+            return Status::NoError;
+
+    while (true)
+    {
+        // Waiters counter must be visible to other side before we check the state,
+        // so it either sees us waiting or we see its change
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        const uint32_t currentSequence = sequence.load(std::memory_order_seq_cst);
+
+        if (predicate())
+        {
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+            return Status::NoError;
+        }
+        else if (m_pHeader->closed.load(std::memory_order_seq_cst))
+        {
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+            return Status::ErrorNotAvailible;
+        }
+
+        // Futex is not private because it is shared between processes
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sequence), FUTEX_WAIT, currentSequence, nullptr, nullptr, 0);
+
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+inline void SharedMemoryRing::wake(AtomicUint32T& sequence, AtomicUint32T& waiters) noexcept
+{
+    sequence.fetch_add(1, std::memory_order_seq_cst);
+
+    if (waiters.load(std::memory_order_seq_cst) != 0)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sequence), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+inline void SharedMemoryRing::copyIn(uint64_t position, const uint8_t* p, uint32_t size) noexcept
+{
+    if (size == 0)
+        return;
+
+    const uint32_t offset = static_cast<uint32_t>(position & m_mask);
+    const uint32_t firstPartSize = std::min(size, m_capacity - offset);
+
+    memcpy(m_pData + offset, p, firstPartSize);
+    memcpy(m_pData, p + firstPartSize, size - firstPartSize);
+}
+
+inline void SharedMemoryRing::copyOut(uint64_t position, uint8_t* p, uint32_t size) const noexcept
+{
+    if (size == 0)
+        return;
+
+    const uint32_t offset = static_cast<uint32_t>(position & m_mask);
+    const uint32_t firstPartSize = std::min(size, m_capacity - offset);
+
+    memcpy(p, m_pData + offset, firstPartSize);
+    memcpy(p + firstPartSize, m_pData, size - firstPartSize);
+}
+
+} // namespace common_serialization::csp::messaging::transport
@@ -0,0 +1,544 @@
+/**
+ * @file common_serialization/csp_messaging/transport/StreamSocket.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <common_serialization/concurrency_interfaces/GuardRW.h>
+#include <common_serialization/csp_messaging/Client.h>
+#include <common_serialization/csp_messaging/transport/Framing.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace common_serialization::csp::messaging::transport
+{
+
+/// @brief Owner of stream socket descriptor that exchanges CSP messages
+/// @details Every message on the wire is put in Framing envelope.
+///     TCP sockets are bound and connected only on loopback interface.
+class StreamSocket
+{
+public:
+    /// @brief Maximum size of message that is received by default
+    static constexpr uint32_t kDefaultMaxMessageSize = 64 * 1024 * 1024;
+
+    StreamSocket() = default;
+
+    /// @brief Take ownership of existing descriptor
+    /// @param fd Socket descriptor
+    explicit StreamSocket(int fd) noexcept;
+    StreamSocket(const StreamSocket&) = delete;
+    StreamSocket(StreamSocket&& rhs) noexcept;
+    StreamSocket& operator=(const StreamSocket&) = delete;
+    StreamSocket& operator=(StreamSocket&& rhs) noexcept;
+    ~StreamSocket() noexcept;
+
+    /// @brief Connect to unix domain socket
+    /// @param path Path of socket
+    /// @return Status of operation
+    Status connectUnix(const char* path) noexcept;
+
+    /// @brief Connect to TCP socket on loopback interface
+    /// @param port Port of socket
+    /// @return Status of operation
+    Status connectTcpLoopback(uint16_t port) noexcept;
+
+    /// @brief Create listening unix domain socket
+    /// @param path Path of socket (it must not exist)
+    /// @return Status of operation
+    Status listenUnix(const char* path) noexcept;
+
+    /// @brief Create listening TCP socket on loopback interface
+    /// @param port Port of socket (if it is 0 port is chosen by system)
+    /// @return Status of operation
+    Status listenTcpLoopback(uint16_t port) noexcept;
+
+    /// @brief Get port to which TCP socket is bound
+    /// @param port Port of socket
+    /// @return Status of operation
+    Status getLocalPort(uint16_t& port) const noexcept;
+
+    /// @brief Switch socket to non-blocking mode
+    /// @return Status of operation
+    Status setNonBlocking() noexcept;
+
+    /// @brief Send message in Framing envelope
+    /// @param p Message
+    /// @param size Size of message
+    /// @param withChecksum Should checksum of message be sent
+    /// @return Status of operation
+    /// @note Works with both blocking and non-blocking sockets
+    Status sendFrame(const uint8_t* p, size_t size, bool withChecksum = false) noexcept;
+
+    /// @brief Send as much of data as socket takes without waiting
+    /// @details Data is given in two parts, so header and message could be sent by one call
+    /// @param p1 First part of data
+    /// @param size1 Size of first part
+    /// @param p2 Second part of data
+    /// @param size2 Size of second part
+    /// @param sentSize Number of bytes that were sent
+    /// @return Status of operation
+    Status sendNoWait(const uint8_t* p1, size_t size1, const uint8_t* p2, size_t size2, size_t& sentSize) noexcept;
+
+    /// @brief Receive message that was sent by sendFrame()
+    /// @param output Container for message
+    /// @param maxMessageSize Maximum allowed size of message
+    /// @return Status of operation. If connection is closed ErrorNotAvailible is returned.
+    /// @note Works with both blocking and non-blocking sockets
+    Status receiveFrame(BinVectorT& output, uint32_t maxMessageSize = kDefaultMaxMessageSize) noexcept;
+
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] bool isValid() const noexcept;
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] int getFd() const noexcept;
+
+    /// @brief Release ownership of descriptor
+    /// @return Descriptor
+    [[nodiscard]] int release() noexcept;
+
+    void close() noexcept;
+
+private:
+    static constexpr int kListenBacklog = 128;
+
+    static Status makeUnixAddress(const char* path, sockaddr_un& address) noexcept;
+    Status waitFor(short events) noexcept;
+    Status receiveExact(uint8_t* p, size_t size) noexcept;
+
+    int m_fd{ -1 };
+};
+
+/// @brief Client side of stream socket transport
+/// @details Requests from different threads are serialized,
+///     because responses come in the same order as requests.
+class StreamSocketClientToServerCommunicator : public IClientToServerCommunicator
+{
+public:
+    StreamSocketClientToServerCommunicator() = default;
+
+    /// @brief Connect to server on unix domain socket
+    /// @param path Path of socket
+    /// @return Status of operation
+    Status connectUnix(const char* path) noexcept;
+
+    /// @brief Connect to server on TCP loopback socket
+    /// @param port Port of socket
+    /// @return Status of operation
+    Status connectTcpLoopback(uint16_t port) noexcept;
+
+    /// @brief Close connection
+    void close() noexcept;
+
+    /// @brief Send checksum with every request (server answers in the same way)
+    /// @param withChecksum Should checksum be sent
+    AGS_CS_ALWAYS_INLINE void setWithChecksum(bool withChecksum) noexcept;
+
+    Status process(const BinVectorT& input, BinVectorT& output) override;
+
+private:
+    StreamSocket m_socket;
+    bool m_withChecksum{ false };
+    MutexT m_mutex;
+};
+
+inline StreamSocket::StreamSocket(int fd) noexcept
+    : m_fd(fd)
+{
+}
+
+inline StreamSocket::StreamSocket(StreamSocket&& rhs) noexcept
+    : m_fd(rhs.release())
+{
+}
+
+inline StreamSocket& StreamSocket::operator=(StreamSocket&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        close();
+        m_fd = rhs.release();
+    }
+
+    return *this;
+}
+
+inline StreamSocket::~StreamSocket() noexcept
+{
+    close();
+}
+
+inline Status StreamSocket::connectUnix(const char* path) noexcept
+{
+    if (isValid())
+        return Status::ErrorAlreadyInited;
+
+    sockaddr_un address{};
+    AGS_CS_RUN(makeUnixAddress(path, address));
+
+    m_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_fd == -1)
+        return Status::ErrorNotAvailible;
+
+    if (connect(m_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == -1)
+    {
+        close();
+        return Status::ErrorNotAvailible;
+    }
+
+    return Status::NoError;
+}
+
+inline Status StreamSocket::connectTcpLoopback(uint16_t port) noexcept
+{
+    if (isValid())
+        return Status::ErrorAlreadyInited;
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    m_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_fd == -1)
+        return Status::ErrorNotAvailible;
+
+    // Requests are small and must not wait for coalescing
+    int noDelay = 1;
+
+    if (setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)) == -1
+        || connect(m_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == -1)
+    {
+        close();
+        return Status::ErrorNotAvailible;
+    }
+
+    return Status::NoError;
+}
+
+inline Status StreamSocket::listenUnix(const char* path) noexcept
+{
+    if (isValid())
+        return Status::ErrorAlreadyInited;
+
+    sockaddr_un address{};
+    AGS_CS_RUN(makeUnixAddress(path, address));
+
+    m_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_fd == -1)
+        return Status::ErrorNotAvailible;
+
+    if (bind(m_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == -1
+        || listen(m_fd, kListenBacklog) == -1)
+    {
+        close();
+        return Status::ErrorNotAvailible;
+    }
+
+    return Status::NoError;
+}
+
+inline Status StreamSocket::listenTcpLoopback(uint16_t port) noexcept
+{
+    if (isValid())
+        return Status::ErrorAlreadyInited;
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    m_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_fd == -1)
+        return Status::ErrorNotAvailible;
+
+    int reuseAddress = 1;
+
+    if (setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress)) == -1
+        || bind(m_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == -1
+        || listen(m_fd, kListenBacklog) == -1)
+    {
+        close();
+        return Status::ErrorNotAvailible;
+    }
+
+    return Status::NoError;
+}
+
+inline Status StreamSocket::getLocalPort(uint16_t& port) const noexcept
+{
+    sockaddr_in address{};
+    socklen_t addressSize = sizeof(address);
+
+    if (getsockname(m_fd, reinterpret_cast<sockaddr*>(&address), &addressSize) == -1 || address.sin_family != AF_INET)
+        return Status::ErrorInvalidArgument;
+
+    port = ntohs(address.sin_port);
+
+    return Status::NoError;
+}
+
+inline Status StreamSocket::setNonBlocking() noexcept
+{
+    int flags = fcntl(m_fd, F_GETFL);
+
+    return flags != -1 && fcntl(m_fd, F_SETFL, flags | O_NONBLOCK) != -1 ? Status::NoError : Status::ErrorInvalidArgument;
+}
+
+inline Status StreamSocket::sendFrame(const uint8_t* p, size_t size, bool withChecksum) noexcept
+{
+    uint8_t header[Framing::kMaxHeaderSize]{};
+    size_t headerSize = 0;
+    AGS_CS_RUN(Framing::makeHeader(p, size, withChecksum, header, headerSize));
+
+    // Header and message are sent by one call, so frame is not split
+    // in two segments when socket has enough space
+    iovec parts[2]{ { header, headerSize }, { const_cast<uint8_t*>(p), size } };
+    msghdr message{};
+    message.msg_iov = parts;
+    message.msg_iovlen = 2;
+
+    while (message.msg_iovlen != 0)
+    {
+        ssize_t sent = sendmsg(m_fd, &message, MSG_NOSIGNAL);
+
+        if (sent == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                AGS_CS_RUN(waitFor(POLLOUT));
+                continue;
+            }
+            else
+                return Status::ErrorNotAvailible;
+        }
+
+        size_t rest = static_cast<size_t>(sent);
+
+        while (message.msg_iovlen != 0 && rest >= message.msg_iov->iov_len)
+        {
+            rest -= message.msg_iov->iov_len;
+            ++message.msg_iov;
+            --message.msg_iovlen;
+        }
+
+        if (message.msg_iovlen != 0)
+        {
+            message.msg_iov->iov_base = static_cast<uint8_t*>(message.msg_iov->iov_base) + rest;
+            message.msg_iov->iov_len -= rest;
+        }
+    }
+
+    return Status::NoError;
+}
+
+inline Status StreamSocket::sendNoWait(const uint8_t* p1, size_t size1, const uint8_t* p2, size_t size2, size_t& sentSize) noexcept
+{
+    sentSize = 0;
+
+    const size_t size = size1 + size2;
+
+    while (sentSize < size)
+    {
+        iovec parts[2]{};
+        msghdr message{};
+        message.msg_iov = parts;
+
+        if (sentSize < size1)
+        {
+            parts[0] = { const_cast<uint8_t*>(p1) + sentSize, size1 - sentSize };
+            parts[1] = { const_cast<uint8_t*>(p2), size2 };
+            message.msg_iovlen = 2;
+        }
+        else
+        {
+            parts[0] = { const_cast<uint8_t*>(p2) + (sentSize - size1), size - sentSize };
+            message.msg_iovlen = 1;
+        }
+
+        ssize_t sent = sendmsg(m_fd, &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if (sent == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            else if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            else
+                return Status::ErrorNotAvailible;
+        }
+
+        sentSize += static_cast<size_t>(sent);
+    }
+
+    return Status::NoError;
+}
+
+inline Status StreamSocket::receiveFrame(BinVectorT& output, uint32_t maxMessageSize) noexcept
+{
+    uint8_t headerBytes[Framing::kMaxHeaderSize]{};
+    AGS_CS_RUN(receiveExact(headerBytes, Framing::kMinHeaderSize));
+
+    const size_t headerSize = Framing::getHeaderSize(headerBytes);
+    AGS_CS_RUN(receiveExact(headerBytes + Framing::kMinHeaderSize, headerSize - Framing::kMinHeaderSize));
+
+    Framing::FrameHeader header;
+    AGS_CS_RUN(Framing::parseHeader(headerBytes, maxMessageSize, header));
+
+    output.clear();
+    AGS_CS_RUN(output.setSize(header.messageSize));
+    AGS_CS_RUN(receiveExact(output.data(), header.messageSize));
+
+    return Framing::checkMessage(header, output.data());
+}
+
+AGS_CS_ALWAYS_INLINE bool StreamSocket::isValid() const noexcept
+{
+    return m_fd != -1;
+}
+
+AGS_CS_ALWAYS_INLINE int StreamSocket::getFd() const noexcept
+{
+    return m_fd;
+}
+
+inline int StreamSocket::release() noexcept
+{
+    int fd = m_fd;
+    m_fd = -1;
+
+    return fd;
+}
+
+inline void StreamSocket::close() noexcept
+{
+    if (isValid())
+        ::close(release());
+}
+
+inline Status StreamSocket::makeUnixAddress(const char* path, sockaddr_un& address) noexcept
+{
+    if (!path)
+        return Status::ErrorInvalidArgument;
+
+    const size_t pathLength = strlen(path);
+    if (pathLength == 0 || pathLength >= sizeof(address.sun_path))
+        return Status::ErrorInvalidArgument;
+
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path, pathLength + 1);
+
+    return Status::NoError;
+}
+
+inline Status StreamSocket::waitFor(short events) noexcept
+{
+    pollfd pollFd{ m_fd, events, 0 };
+
+    while (poll(&pollFd, 1, -1) == -1)
+        if (errno != EINTR)
+            return Status::ErrorNotAvailible;
+
+    return Status::NoError;
+}
+
+inline Status StreamSocket::receiveExact(uint8_t* p, size_t size) noexcept
+{
+    while (size != 0)
+    {
+        ssize_t received = recv(m_fd, p, size, 0);
+
+        if (received == 0)
+            return Status::ErrorNotAvailible;
+        else if (received == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                AGS_CS_RUN(waitFor(POLLIN));
+                continue;
+            }
+            else
+                return Status::ErrorNotAvailible;
+        }
+
+        p += received;
+        size -= static_cast<size_t>(received);
+    }
+
+    return Status::NoError;
+}
+
+inline Status StreamSocketClientToServerCommunicator::connectUnix(const char* path) noexcept
+{
+    WGuard guard(m_mutex);
+
+    return m_socket.connectUnix(path);
+}
+
+inline Status StreamSocketClientToServerCommunicator::connectTcpLoopback(uint16_t port) noexcept
+{
+    WGuard guard(m_mutex);
+
+    return m_socket.connectTcpLoopback(port);
+}
+
+inline void StreamSocketClientToServerCommunicator::close() noexcept
+{
+    WGuard guard(m_mutex);
+
+    m_socket.close();
+}
+
+AGS_CS_ALWAYS_INLINE void StreamSocketClientToServerCommunicator::setWithChecksum(bool withChecksum) noexcept
+{
+    m_withChecksum = withChecksum;
+}
+
+inline Status StreamSocketClientToServerCommunicator::process(const BinVectorT& input, BinVectorT& output)
+{
+    WGuard guard(m_mutex);
+
+    if (!m_socket.isValid())
+        return Status::ErrorNotInited;
+
+    Status status = m_socket.sendFrame(input.data(), input.size(), m_withChecksum);
+
+    if (statusSuccess(status))
+        status = m_socket.receiveFrame(output);
+
+    // After failure stream may stay in the middle of frame, so it can't be used anymore
+    if (!statusSuccess(status))
+        m_socket.close();
+
+    return status;
+}
+
+} // namespace common_serialization::csp::messaging::transport
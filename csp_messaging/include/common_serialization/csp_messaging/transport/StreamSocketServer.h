@@ -0,0 +1,501 @@
+/**
+ * @file common_serialization/csp_messaging/transport/StreamSocketServer.h
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#pragma once
+
+#include <common_serialization/concurrency_interfaces/GuardRW.h>
+#include <common_serialization/csp_messaging/Server.h>
+#include <common_serialization/csp_messaging/transport/StreamSocket.h>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+namespace common_serialization::csp::messaging::transport
+{
+
+/// @brief Front-end of Server that accepts stream socket connections
+///     and handles their messages on pool of threads
+/// @details All threads wait on one epoll instance. Every connection is armed
+///     in one-shot mode, so only one thread at a time reads its messages,
+///     and responses are sent in order of requests. Every connection
+///     has its own FrameReader and output buffer that are reused between messages,
+///     and one read from socket may bring many messages.
+///     Response has checksum when request has it.
+///     Threads never wait for socket to be writable: responses that socket can't take
+///     are kept by connection, and it is armed for writing instead of reading until they are sent.
+class StreamSocketServer
+{
+public:
+    /// @brief Identity of connection that is passed to Server as client ID
+    struct ClientInfo
+    {
+        /// @brief Id that is unique for every connection of StreamSocketServer
+        uint64_t connectionId{ 0 };
+
+        /// @brief Are pid, uid and gid of peer process known (they are for unix domain sockets only)
+        bool hasCredentials{ false };
+        pid_t pid{ 0 };
+        uid_t uid{ 0 };
+        gid_t gid{ 0 };
+    };
+
+    /// @brief Constructor
+    /// @param server Server that handles messages (must outlive StreamSocketServer)
+    explicit StreamSocketServer(const Server& server) noexcept;
+    StreamSocketServer(const StreamSocketServer&) = delete;
+    StreamSocketServer& operator=(const StreamSocketServer&) = delete;
+    ~StreamSocketServer() noexcept;
+
+    /// @brief Listen on unix domain socket
+    /// @param path Path of socket (it must not exist and it is removed on stop())
+    /// @return Status of operation
+    Status listenUnix(const char* path) noexcept;
+
+    /// @brief Listen on TCP socket on loopback interface
+    /// @param port Port of socket (if it is 0 port is chosen by system)
+    /// @return Status of operation
+    Status listenTcpLoopback(uint16_t port) noexcept;
+
+    /// @brief Get port of TCP listening socket
+    /// @return Port or 0 if server is not listening on TCP socket
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] uint16_t getPort() const noexcept;
+
+    /// @brief Set maximum allowed size of incoming message.
+    ///     Connections that send bigger messages are closed.
+    /// @param maxMessageSize Maximum size of message
+    AGS_CS_ALWAYS_INLINE void setMaxMessageSize(uint32_t maxMessageSize) noexcept;
+
+    /// @brief Start handling connections
+    /// @param threadsCount Number of threads
+    /// @return Status of operation
+    Status start(uint32_t threadsCount) noexcept;
+
+    /// @brief Stop threads and close all connections
+    void stop() noexcept;
+
+    AGS_CS_ALWAYS_INLINE [[nodiscard]] bool isRunning() const noexcept;
+
+private:
+    // Buffers that grown bigger are freed when connection has no more data,
+    // so occasional big message doesn't hold memory for connection lifetime
+    static constexpr size_t kMaxRetainedBufferSize = 1024 * 1024;
+    static constexpr size_t kReadChunkSize = 16 * 1024;
+
+    struct Connection
+    {
+        Connection(int fd, uint32_t maxMessageSize) noexcept : socket(fd), reader(maxMessageSize) { }
+
+        StreamSocket socket;
+        size_t index{ 0 };
+        GenericPointerKeeperT clientId;
+        FrameReader reader;
+        BinVectorT output;
+        // Framed responses that socket couldn't take yet
+        BinVectorT pendingOutput;
+        size_t pendingOutputOffset{ 0 };
+    };
+
+    Status addToEpoll(int fd, void* pData, uint32_t events) noexcept;
+    void workerRoutine() noexcept;
+    void acceptConnections() noexcept;
+    Status initClientId(Connection& connection) noexcept;
+
+    /// @param events Events that connection must be armed with
+    /// @return true if connection must stay open
+    bool serveConnection(Connection& connection, uint32_t& events) noexcept;
+    Status handleMessage(Connection& connection, BinWalkerT& input) noexcept;
+
+    /// @brief Send as much of pending output as socket takes without waiting
+    Status flushPendingOutput(Connection& connection) noexcept;
+    void closeConnection(Connection* pConnection) noexcept;
+
+    const Server& m_server;
+    StreamSocket m_listenSocket;
+    VectorT<char> m_unixPath;
+    uint16_t m_port{ 0 };
+    uint32_t m_maxMessageSize{ StreamSocket::kDefaultMaxMessageSize };
+    int m_epollFd{ -1 };
+    int m_stopFd{ -1 };
+    VectorT<ThreadT> m_threads;
+    AtomicUint64T m_nextConnectionId{ 1 };
+    MutexT m_connectionsMutex;
+    VectorT<Connection*> m_connections;
+};
+
+inline StreamSocketServer::StreamSocketServer(const Server& server) noexcept
+    : m_server(server)
+{
+}
+
+inline StreamSocketServer::~StreamSocketServer() noexcept
+{
+    stop();
+}
+
+inline Status StreamSocketServer::listenUnix(const char* path) noexcept
+{
+    if (m_listenSocket.isValid())
+        return Status::ErrorAlreadyInited;
+
+    AGS_CS_RUN(m_listenSocket.listenUnix(path));
+
+    Status status = m_unixPath.pushBackN(path, strlen(path) + 1);
+    if (!statusSuccess(status))
+    {
+        m_listenSocket.close();
+        unlink(path);
+    }
+
+    return status;
+}
+
+inline Status StreamSocketServer::listenTcpLoopback(uint16_t port) noexcept
+{
+    if (m_listenSocket.isValid())
+        return Status::ErrorAlreadyInited;
+
+    AGS_CS_RUN(m_listenSocket.listenTcpLoopback(port));
+
+    Status status = m_listenSocket.getLocalPort(m_port);
+    if (!statusSuccess(status))
+        m_listenSocket.close();
+
+    return status;
+}
+
+AGS_CS_ALWAYS_INLINE uint16_t StreamSocketServer::getPort() const noexcept
+{
+    return m_port;
+}
+
+AGS_CS_ALWAYS_INLINE void StreamSocketServer::setMaxMessageSize(uint32_t maxMessageSize) noexcept
+{
+    m_maxMessageSize = maxMessageSize;
+}
+
+inline Status StreamSocketServer::start(uint32_t threadsCount) noexcept
+{
+    if (isRunning())
+        return Status::ErrorAlreadyInited;
+
+    if (!m_listenSocket.isValid())
+        return Status::ErrorNotInited;
+
+    if (threadsCount == 0)
+        return Status::ErrorInvalidArgument;
+
+    AGS_CS_RUN(m_listenSocket.setNonBlocking());
+
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    Status status = m_epollFd != -1 && m_stopFd != -1 ? Status::NoError : Status::ErrorNotAvailible;
+
+    // Stop event is level-triggered and is never consumed, so it wakes all threads
+    if (statusSuccess(status))
+        status = addToEpoll(m_stopFd, &m_stopFd, EPOLLIN);
+    if (statusSuccess(status))
+        status = addToEpoll(m_listenSocket.getFd(), &m_listenSocket, EPOLLIN | EPOLLONESHOT);
+    if (statusSuccess(status))
+        status = m_threads.reserve(threadsCount);
+
+    for (uint32_t i = 0; i < threadsCount && statusSuccess(status); ++i)
+        status = m_threads.emplaceBack([this] { workerRoutine(); });
+
+    if (!statusSuccess(status))
+        stop();
+
+    return status;
+}
+
+inline void StreamSocketServer::stop() noexcept
+{
+    if (m_stopFd != -1)
+    {
+        uint64_t value = 1;
+        [[maybe_unused]] ssize_t written = write(m_stopFd, &value, sizeof(value));
+    }
+
+    for (auto& thread : m_threads)
+        thread.join();
+
+    m_threads.clear();
+
+    for (Connection* pConnection : m_connections)
+        delete pConnection;
+
+    m_connections.clear();
+
+    if (m_epollFd != -1)
+        ::close(m_epollFd);
+    if (m_stopFd != -1)
+        ::close(m_stopFd);
+
+    m_epollFd = -1;
+    m_stopFd = -1;
+
+    m_listenSocket.close();
+    m_port = 0;
+
+    if (m_unixPath.size() != 0)
+        unlink(m_unixPath.data());
+
+    m_unixPath.clear();
+}
+
+AGS_CS_ALWAYS_INLINE bool StreamSocketServer::isRunning() const noexcept
+{
+    return m_threads.size() != 0;
+}
+
+inline Status StreamSocketServer::addToEpoll(int fd, void* pData, uint32_t events) noexcept
+{
+    epoll_event event{};
+    event.events = events;
+    event.data.ptr = pData;
+
+    return epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) == 0 ? Status::NoError : Status::ErrorNotAvailible;
+}
+
+inline void StreamSocketServer::workerRoutine() noexcept
+{
+    while (true)
+    {
+        epoll_event event{};
+        int eventsCount = epoll_wait(m_epollFd, &event, 1, -1);
+
+        if (eventsCount == -1 && errno != EINTR)
+            return;
+        else if (eventsCount <= 0)
+            continue;
+
+        if (event.data.ptr == &m_stopFd)
+            return;
+        else if (event.data.ptr == &m_listenSocket)
+            acceptConnections();
+        else
+        {
+            Connection* pConnection = static_cast<Connection*>(event.data.ptr);
+            uint32_t events = 0;
+
+            if (!(event.events & (EPOLLHUP | EPOLLERR)) && serveConnection(*pConnection, events))
+            {
+                event.events = events;
+
+                if (epoll_ctl(m_epollFd, EPOLL_CTL_MOD, pConnection->socket.getFd(), &event) == 0)
+                    continue;
+            }
+
+            closeConnection(pConnection);
+        }
+    }
+}
+
+inline void StreamSocketServer::acceptConnections() noexcept
+{
+    while (true)
+    {
+        int fd = accept4(m_listenSocket.getFd(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (fd == -1)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            else
+                break;
+        }
+
+        Connection* pConnection = new (std::nothrow) Connection(fd, m_maxMessageSize);
+        if (!pConnection)
+        {
+            ::close(fd);
+            continue;
+        }
+
+        Status status = initClientId(*pConnection);
+
+        if (statusSuccess(status))
+        {
+            WGuard guard(m_connectionsMutex);
+            pConnection->index = m_connections.size();
+            status = m_connections.pushBack(pConnection);
+        }
+
+        if (statusSuccess(status))
+            status = addToEpoll(fd, pConnection, EPOLLIN | EPOLLRDHUP | EPOLLONESHOT);
+
+        if (!statusSuccess(status))
+            closeConnection(pConnection);
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.ptr = &m_listenSocket;
+    epoll_ctl(m_epollFd, EPOLL_CTL_MOD, m_listenSocket.getFd(), &event);
+}
+
+inline Status StreamSocketServer::initClientId(Connection& connection) noexcept
+{
+    ClientInfo* pClientInfo = connection.clientId.allocateAndConstructOne<ClientInfo>();
+    if (!pClientInfo)
+        return Status::ErrorNoMemory;
+
+    pClientInfo->connectionId = m_nextConnectionId.fetch_add(1, std::memory_order_relaxed);
+
+    ucred credentials{};
+    socklen_t credentialsSize = sizeof(credentials);
+
+    if (getsockopt(connection.socket.getFd(), SOL_SOCKET, SO_PEERCRED, &credentials, &credentialsSize) == 0 && credentials.pid != 0)
+    {
+        pClientInfo->hasCredentials = true;
+        pClientInfo->pid = credentials.pid;
+        pClientInfo->uid = credentials.uid;
+        pClientInfo->gid = credentials.gid;
+    }
+
+    return Status::NoError;
+}
+
+inline bool StreamSocketServer::serveConnection(Connection& connection, uint32_t& events) noexcept
+{
+    while (true)
+    {
+        if (!statusSuccess(flushPendingOutput(connection)))
+            return false;
+
+        // New messages are not handled until client reads responses to previous ones
+        if (connection.pendingOutput.size() != 0)
+        {
+            events = EPOLLOUT | EPOLLRDHUP | EPOLLONESHOT;
+            return true;
+        }
+
+        // Messages that are already received are handled before reading more
+        BinWalkerT* pInput = nullptr;
+
+        if (!statusSuccess(connection.reader.getNextMessage(pInput)))
+            return false;
+        else if (pInput)
+        {
+            if (!statusSuccess(handleMessage(connection, *pInput)))
+                return false;
+
+            continue;
+        }
+
+        uint8_t* p = nullptr;
+        size_t size = 0;
+
+        if (!statusSuccess(connection.reader.getFreeSpace(kReadChunkSize, p, size)))
+            return false;
+
+        ssize_t received = recv(connection.socket.getFd(), p, size, 0);
+
+        if (received == -1)
+        {
+            if (errno == EINTR)
+                continue;
+
+            // Connection is waiting for more data
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                return false;
+
+            connection.reader.shrink(kMaxRetainedBufferSize);
+            if (connection.output.capacity() > kMaxRetainedBufferSize)
+                connection.output.invalidate();
+            if (connection.pendingOutput.capacity() > kMaxRetainedBufferSize)
+                connection.pendingOutput.invalidate();
+
+            events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+            return true;
+        }
+        else if (received == 0 || !statusSuccess(connection.reader.commitFreeSpace(static_cast<size_t>(received))))
+            return false;
+    }
+}
+
+inline Status StreamSocketServer::handleMessage(Connection& connection, BinWalkerT& input) noexcept
+{
+    // Status of handling is always packed in response, so client receives it anyway
+    m_server.handleMessage(input, connection.clientId, connection.output);
+
+    uint8_t header[Framing::kMaxHeaderSize]{};
+    size_t headerSize = 0;
+    AGS_CS_RUN(Framing::makeHeader(connection.output.data(), connection.output.size(), connection.reader.isLastMessageWithChecksum(), header, headerSize));
+
+    // Response is sent directly only if there are no previous ones in queue, so that order is kept
+    size_t sentSize = 0;
+
+    if (connection.pendingOutput.size() == 0)
+        AGS_CS_RUN(connection.socket.sendNoWait(header, headerSize, connection.output.data(), connection.output.size(), sentSize));
+
+    if (sentSize < headerSize)
+        AGS_CS_RUN(connection.pendingOutput.pushBackN(header + sentSize, headerSize - sentSize));
+
+    const size_t sentMessageSize = sentSize > headerSize ? sentSize - headerSize : 0;
+
+    return connection.pendingOutput.pushBackN(connection.output.data() + sentMessageSize, connection.output.size() - sentMessageSize);
+}
+
+inline Status StreamSocketServer::flushPendingOutput(Connection& connection) noexcept
+{
+    BinVectorT& pendingOutput = connection.pendingOutput;
+
+    if (pendingOutput.size() == 0)
+        return Status::NoError;
+
+    size_t sentSize = 0;
+    AGS_CS_RUN(connection.socket.sendNoWait(pendingOutput.data() + connection.pendingOutputOffset
+        , pendingOutput.size() - connection.pendingOutputOffset, nullptr, 0, sentSize));
+
+    connection.pendingOutputOffset += sentSize;
+
+    if (connection.pendingOutputOffset == pendingOutput.size())
+    {
+        pendingOutput.clear();
+        connection.pendingOutputOffset = 0;
+    }
+
+    return Status::NoError;
+}
+
+inline void StreamSocketServer::closeConnection(Connection* pConnection) noexcept
+{
+    {
+        WGuard guard(m_connectionsMutex);
+
+        if (pConnection->index < m_connections.size() && m_connections[pConnection->index] == pConnection)
+        {
+            Connection* pLast = m_connections[m_connections.size() - 1];
+            m_connections[pConnection->index] = pLast;
+            pLast->index = pConnection->index;
+            m_connections.erase(m_connections.size() - 1);
+        }
+    }
+
+    // Closing descriptor removes it from epoll
+    delete pConnection;
+}
+
+} // namespace common_serialization::csp::messaging::transport
@@ -328,6 +328,41 @@ TEST_F(ClientTests, GetServerHandlerSettingsValidReturnFromServer)
     EXPECT_EQ(outputTypeId, expectedOutputTypeId);
 }
 
+TEST_F(ClientTests, GetServerHandlerSettingsCached)
+{
+    m_client.init(getValidCspPartySettings());
+
+    constexpr interface_version_t expectedMinimumVersion{ 5 };
+    constexpr Id expectedOutputTypeId = tests_csp_interface::SpecialProcessingType<>::getId();
+
+    // Server must be asked only once until cache is cleared
+    EXPECT_CALL(m_clientToServerCommunicator, process).Times(2).WillRepeatedly(Invoke(
+        [expectedMinimumVersion, &expectedOutputTypeId](const BinVectorT& input, BinVectorT& output)
+        {
+            processing::status::Helpers::serializeErrorNotSupportedInterfaceVersion(
+                  getLatestProtocolVersion()
+                , {}
+                , expectedMinimumVersion
+                , expectedOutputTypeId
+                , output);
+            return Status::NoError;
+        }
+    ));
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        if (i == 2)
+            m_client.clearServerHandlerSettingsCache();
+
+        interface_version_t minimumInterfaceVersion{ 0 };
+        Id outputTypeId;
+
+        EXPECT_EQ(m_client.getServerHandlerSettings<tests_csp_interface::Diamond<>>(minimumInterfaceVersion, outputTypeId), Status::NoError);
+        EXPECT_EQ(minimumInterfaceVersion, expectedMinimumVersion);
+        EXPECT_EQ(outputTypeId, expectedOutputTypeId);
+    }
+}
+
 TEST_F(ClientTests, GetSettingsClientNotInited)
 {
     EXPECT_EQ(m_client.getSettings(), CspPartySettings<>());
@@ -25,7 +25,14 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <memory>
+#include <atomic>
+#include <coroutine>
+#include <limits>
+#include <set>
+#include <string>
 #include <common_serialization/csp_messaging/csp_messaging.h>
+#include <common_serialization/csp_messaging/transport/SharedMemoryChannel.h>
+#include <common_serialization/csp_messaging/transport/StreamSocketServer.h>
 #include <common_serialization/tests_csp_another_interface/tests_csp_another_interface.h>
 #include <common_serialization/tests_csp_descendant_interface/tests_csp_descendant_interface.h>
 #include <common_serialization/tests_csp_interface/tests_csp_interface.h>
@@ -54,7 +61,120 @@ public:
     MOCK_METHOD(Status, process, (const BinVectorT& input, BinVectorT& output), (override));
 };
 
-inline int g_numberOfMultiEntrances = 0;
+// Runs every request on its own thread, so responses come in arbitrary order
+class AsyncClientToServerCommunicator : public csp::messaging::IAsyncClientToServerCommunicator
+{
+public:
+    explicit AsyncClientToServerCommunicator(const csp::messaging::Server& server)
+        : m_server(server)
+    { }
+
+    ~AsyncClientToServerCommunicator()
+    {
+        join();
+    }
+
+    Status processAsync(const BinVectorT& input, BinVectorT& output, ICompletion& completion) override
+    {
+        m_threads.emplace_back([&server = m_server, &input, &output, &completion]
+            {
+                BinWalkerT inputW;
+                inputW.init(input);
+
+                completion.complete(server.handleMessage(inputW, GenericPointerKeeper{}, output));
+            });
+
+        return Status::NoError;
+    }
+
+    void join()
+    {
+        for (auto& thread : m_threads)
+            thread.join();
+
+        m_threads.clear();
+    }
+
+private:
+    const csp::messaging::Server& m_server;
+    std::vector<std::thread> m_threads;
+};
+
+// Passes every request to ServerExecutor
+class ExecutorClientToServerCommunicator : public csp::messaging::IAsyncClientToServerCommunicator
+{
+public:
+    explicit ExecutorClientToServerCommunicator(csp::messaging::ServerExecutor& executor)
+        : m_executor(executor)
+    { }
+
+    Status processAsync(const BinVectorT& input, BinVectorT& output, ICompletion& completion) override
+    {
+        Request* pRequest = new Request(output, completion);
+        AGS_CS_RUN(pRequest->m_input.init(input));
+
+        Status status = m_executor.submit(*pRequest);
+        if (!statusSuccess(status))
+            delete pRequest;
+
+        return status;
+    }
+
+private:
+    class Request : public csp::messaging::ServerExecutor::IRequest
+    {
+    public:
+        Request(BinVectorT& output, ICompletion& completion)
+            : m_output(output), m_completion(completion)
+        { }
+
+        BinWalkerT& getInput() noexcept override { return m_input; }
+        const GenericPointerKeeper& getClientId() noexcept override { return m_clientId; }
+
+        void complete(Status status, BinVectorT& output) noexcept override
+        {
+            if (statusSuccess(status))
+                status = m_output.init(output);
+
+            m_completion.complete(status);
+            delete this;
+        }
+
+        BinWalkerT m_input;
+
+    private:
+        GenericPointerKeeper m_clientId;
+        BinVectorT& m_output;
+        ICompletion& m_completion;
+    };
+
+    csp::messaging::ServerExecutor& m_executor;
+};
+
+// Coroutine that starts immediately and is not awaited by anyone
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept { }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+template<typename Cht>
+DetachedTask awaitHandleData(csp::messaging::Client& client, const typename Cht::InputType& input, typename Cht::OutputType& output
+    , Status& status, std::atomic_int& completedCount)
+{
+    status = co_await client.handleDataAwaitable<Cht>(input, output);
+    ++completedCount;
+}
+
+inline std::atomic_int g_numberOfMultiEntrances = 0;
+inline std::atomic_int g_numberOfDistinctMultiInputs = 0;
+inline std::atomic<const void*> g_pLastMultiInput = nullptr;
 
 template<typename InputStruct, typename OutputStruct>
 Status defaultHandle(const InputStruct& input, OutputStruct& output)
@@ -79,6 +199,9 @@ Status multiHandle(const InputStruct& input)
 
     ++g_numberOfMultiEntrances;
 
+    if (g_pLastMultiInput.exchange(&input) != &input)
+        ++g_numberOfDistinctMultiInputs;
+
     return Status::NoError;
 }
 
@@ -179,13 +302,127 @@ public:
     }
 };
 
+class RejectingCspService
+    : IServerDataHandler<csm::ServerStackMultiHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>
+{
+public:
+    RejectingCspService() = default;
+
+    Status registerHandlers(csm::IServerDataHandlerRegistrar& registrar)
+    {
+        IServerDataHandler<csm::ServerStackMultiHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>::registerHandler(registrar, this);
+        return Status::NoError;
+    }
+
+    const csm::HandlerMetrics& getMetrics() const noexcept
+    {
+        return IServerDataHandler<csm::ServerStackMultiHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>::getMetrics();
+    }
+
+    Status checkPoliciesCompliance(const tests_csp_interface::SimplyAssignable<>* input, const csp::context::DData& ctx, const GenericPointerKeeper& clientId) override
+    {
+        // Policies are checked before input deserialization
+        EXPECT_EQ(input, nullptr);
+
+        return Status::ErrorNotAvailible;
+    }
+
+    Status handleData(const tests_csp_interface::SimplyAssignable<>& input
+        , Vector<GenericPointerKeeper>* pUnmanagedPointers
+        , const GenericPointerKeeper& clientId
+        , ISerializableDummy& output) override
+    {
+        ADD_FAILURE() << "Handler that rejected message must not be called";
+
+        return multiHandle(input);
+    }
+};
+
+class PooledCspService
+    : IServerDataHandler<csm::ServerPooledHandler<tests_csp_interface::Diamond<>, tests_csp_interface::DynamicPolymorphic<>, ObjectsPoolType::PerHandler>>
+    , IServerDataHandler<csm::ServerPooledHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>, ObjectsPoolType::PerThread, 1>>
+{
+public:
+    PooledCspService() = default;
+
+    Status registerHandlers(csm::IServerDataHandlerRegistrar& registrar)
+    {
+        IServerDataHandler<csm::ServerPooledHandler<tests_csp_interface::Diamond<>, tests_csp_interface::DynamicPolymorphic<>, ObjectsPoolType::PerHandler>>::registerHandler(registrar, this);
+        IServerDataHandler<csm::ServerPooledHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>, ObjectsPoolType::PerThread, 1>>::registerHandler(registrar, this);
+
+        return Status::NoError;
+    }
+
+    Status handleData(
+        const tests_csp_interface::Diamond<>& input
+        , Vector<GenericPointerKeeper>* pUnmanagedPointers
+        , const GenericPointerKeeper& clientId
+        , tests_csp_interface::DynamicPolymorphic<>& output) override
+    {
+        // Output must be reset after previous use
+        EXPECT_EQ(output, tests_csp_interface::DynamicPolymorphic<>{});
+        m_inputs.insert(&input);
+
+        return defaultHandle(input, output);
+    }
+
+    Status handleData(
+        const tests_csp_interface::SimplyAssignableAlignedToOne<>& input
+        , Vector<GenericPointerKeeper>* pUnmanagedPointers
+        , const GenericPointerKeeper& clientId
+        , tests_csp_interface::SimplyAssignableDescendant<>& output) override
+    {
+        EXPECT_EQ(output, tests_csp_interface::SimplyAssignableDescendant<>{});
+        m_inputs.insert(&input);
+
+        return defaultHandle(input, output);
+    }
+
+    std::set<const void*> m_inputs;
+};
+
+class IdempotentCspService
+    : IServerDataHandler<csm::ServerIdempotentHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>
+{
+public:
+    using Handler = IServerDataHandler<csm::ServerIdempotentHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>;
+
+    IdempotentCspService() = default;
+
+    Status registerHandlers(csm::IServerDataHandlerRegistrar& registrar)
+    {
+        return Handler::registerHandler(registrar, this);
+    }
+
+    ResponseCache& getResponseCache()
+    {
+        return Handler::getResponseCache();
+    }
+
+    Status handleData(
+        const tests_csp_interface::SimplyAssignableAlignedToOne<>& input
+        , Vector<GenericPointerKeeper>* pUnmanagedPointers
+        , const GenericPointerKeeper& clientId
+        , tests_csp_interface::SimplyAssignableDescendant<>& output) override
+    {
+        ++m_callsCount;
+        output.fill();
+        output.m_d = input.m_x;
+
+        return Status::NoError;
+    }
+
+    std::atomic_int m_callsCount = 0;
+};
+
+template<typename Registrar>
 class ComplexTests : public ::testing::Test
 {
 public:
     ComplexTests()
         : m_clientToServerCommunicator(), m_client(m_clientToServerCommunicator)
     {
-        m_server.init<GenericServerDataHandlerRegistrar>(getValidCspPartySettings());
+        m_server.template init<Registrar>(getValidCspPartySettings());
         m_client.init(getValidCspPartySettings());
     }
 
@@ -195,16 +432,19 @@ protected:
     ClientToServerCommunicatorMock m_clientToServerCommunicator;
 };
 
-TEST_F(ComplexTests, SimpleUnicastTest)
+using Registrars = ::testing::Types<GenericServerDataHandlerRegistrar, RcuServerDataHandlerRegistrar>;
+TYPED_TEST_SUITE(ComplexTests, Registrars);
+
+TYPED_TEST(ComplexTests, SimpleUnicastTest)
 {
     FirstCspService firstCspService;
-    firstCspService.registerHandlers(*m_server.getDataHandlersRegistrar());
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
 
     tests_csp_interface::SimplyAssignableAlignedToOne<> input;
     input.fill();
     tests_csp_interface::SimplyAssignableDescendant<> output;
 
-    EXPECT_CALL(m_clientToServerCommunicator, process).WillOnce(Invoke(
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillOnce(Invoke(
         [&server = this->m_server](const BinVectorT& input, BinVectorT& output)
         {
             BinWalkerT inputW;
@@ -214,7 +454,7 @@ TEST_F(ComplexTests, SimpleUnicastTest)
         })
     );
 
-    EXPECT_EQ((m_client.handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>(input, output)), Status::NoError);
+    EXPECT_EQ((this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>(input, output)), Status::NoError);
 
     tests_csp_interface::SimplyAssignableDescendant<> outputReference;
     outputReference.fill();
@@ -222,20 +462,185 @@ TEST_F(ComplexTests, SimpleUnicastTest)
     EXPECT_EQ(output, outputReference);
 }
 
-TEST_F(ComplexTests, SimpleMulticastTest)
+TYPED_TEST(ComplexTests, AsyncUnicastTest)
+{
+    using Cht = ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>;
+    constexpr size_t kRequestsCount = 16;
+
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    AsyncClientToServerCommunicator asyncCommunicator(this->m_server);
+    this->m_client.setAsyncClientToServerCommunicator(&asyncCommunicator);
+
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+    input.fill();
+    tests_csp_interface::SimplyAssignableDescendant<> outputReference;
+    outputReference.fill();
+
+    // Callback form
+    std::vector<tests_csp_interface::SimplyAssignableDescendant<>> outputs(kRequestsCount);
+    std::vector<Status> statuses(kRequestsCount, Status::ErrorInternal);
+    std::atomic_int completedCount = 0;
+
+    for (size_t i = 0; i < kRequestsCount; ++i)
+        EXPECT_EQ((this->m_client.template handleDataAsync<Cht>(input, outputs[i], [&status = statuses[i], &completedCount](Status result)
+            {
+                status = result;
+                ++completedCount;
+            })), Status::NoError);
+
+    asyncCommunicator.join();
+
+    EXPECT_EQ(completedCount.load(), kRequestsCount);
+
+    for (size_t i = 0; i < kRequestsCount; ++i)
+    {
+        EXPECT_EQ(statuses[i], Status::NoError);
+        EXPECT_EQ(outputs[i], outputReference);
+    }
+
+    // Coroutine form
+    outputs.assign(kRequestsCount, {});
+    statuses.assign(kRequestsCount, Status::ErrorInternal);
+    completedCount = 0;
+
+    for (size_t i = 0; i < kRequestsCount; ++i)
+        awaitHandleData<Cht>(this->m_client, input, outputs[i], statuses[i], completedCount);
+
+    asyncCommunicator.join();
+
+    EXPECT_EQ(completedCount.load(), kRequestsCount);
+
+    for (size_t i = 0; i < kRequestsCount; ++i)
+    {
+        EXPECT_EQ(statuses[i], Status::NoError);
+        EXPECT_EQ(outputs[i], outputReference);
+    }
+
+    this->m_client.setAsyncClientToServerCommunicator(nullptr);
+}
+
+TYPED_TEST(ComplexTests, ServerExecutorTest)
 {
+    using Cht = ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>;
+    constexpr size_t kRequestsCount = 256;
+
     FirstCspService firstCspService;
-    firstCspService.registerHandlers(*m_server.getDataHandlersRegistrar());
-    SecondCspService secondCspService;
-    secondCspService.registerHandlers(*m_server.getDataHandlersRegistrar());
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
 
-    tests_csp_interface::SimplyAssignable<> input;
+    csp::messaging::ServerExecutor executor(this->m_server);
+    EXPECT_EQ(executor.init(4, 64), Status::NoError);
+    EXPECT_EQ(executor.init(4, 64), Status::ErrorAlreadyInited);
+
+    ExecutorClientToServerCommunicator executorCommunicator(executor);
+    this->m_client.setAsyncClientToServerCommunicator(&executorCommunicator);
+
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input;
     input.fill();
-    ISerializableDummy outputDummy;
+    tests_csp_interface::SimplyAssignableDescendant<> outputReference;
+    outputReference.fill();
 
-    g_numberOfMultiEntrances = 0;
+    std::vector<tests_csp_interface::SimplyAssignableDescendant<>> outputs(kRequestsCount);
+    std::vector<Status> statuses(kRequestsCount, Status::ErrorInternal);
+    std::atomic_int completedCount = 0;
+
+    // Requests are submitted from several threads at once
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < 4; ++t)
+        threads.emplace_back([&, t]
+            {
+                for (size_t i = t; i < kRequestsCount; i += 4)
+                {
+                    // Queue may be full, then request is retried
+                    Status status = Status::NoError;
+                    do
+                    {
+                        status = this->m_client.template handleDataAsync<Cht>(input, outputs[i], [&status = statuses[i], &completedCount](Status result)
+                            {
+                                status = result;
+                                ++completedCount;
+                            });
+                    } while (status == Status::ErrorBusy);
+
+                    EXPECT_EQ(status, Status::NoError);
+                }
+            });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    executor.stop();
+
+    EXPECT_EQ(completedCount.load(), kRequestsCount);
+
+    for (size_t i = 0; i < kRequestsCount; ++i)
+    {
+        EXPECT_EQ(statuses[i], Status::NoError);
+        EXPECT_EQ(outputs[i], outputReference);
+    }
+
+    this->m_client.setAsyncClientToServerCommunicator(nullptr);
+}
+
+TYPED_TEST(ComplexTests, ServerExecutorStopWhileSubmittingTest)
+{
+    using Cht = ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>;
+    constexpr size_t kRequestsCount = 256;
+
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    csp::messaging::ServerExecutor executor(this->m_server);
+    EXPECT_EQ(executor.init(2, 64), Status::NoError);
+
+    ExecutorClientToServerCommunicator executorCommunicator(executor);
+    this->m_client.setAsyncClientToServerCommunicator(&executorCommunicator);
+
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+    input.fill();
+
+    std::vector<tests_csp_interface::SimplyAssignableDescendant<>> outputs(kRequestsCount);
+    std::atomic_int acceptedCount = 0;
+    std::atomic_int completedCount = 0;
+    std::atomic_bool submitterDone = false;
+
+    std::thread submitter([&]
+        {
+            for (size_t i = 0; i < kRequestsCount; ++i)
+            {
+                Status status = this->m_client.template handleDataAsync<Cht>(input, outputs[i], [&completedCount](Status) { ++completedCount; });
+
+                if (statusSuccess(status))
+                    ++acceptedCount;
+                else if (status == Status::ErrorNotInited)
+                    break;
+            }
+
+            submitterDone = true;
+        });
+
+    // Stop while requests are still coming, every accepted one must be completed
+    while (acceptedCount.load() < 16 && !submitterDone.load())
+        std::this_thread::yield();
+
+    executor.stop();
+    submitter.join();
+
+    EXPECT_EQ(completedCount.load(), acceptedCount.load());
+
+    this->m_client.setAsyncClientToServerCommunicator(nullptr);
+}
+
+TYPED_TEST(ComplexTests, IdempotentHandlerTest)
+{
+    using Cht = ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>;
 
-    EXPECT_CALL(m_clientToServerCommunicator, process).WillOnce(Invoke(
+    IdempotentCspService idempotentCspService;
+    idempotentCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillRepeatedly(Invoke(
         [&server = this->m_server](const BinVectorT& input, BinVectorT& output)
         {
             BinWalkerT inputW;
@@ -245,16 +650,1165 @@ TEST_F(ComplexTests, SimpleMulticastTest)
         })
     );
 
-    EXPECT_EQ((m_client.handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>(input, outputDummy)), Status::NoError);
-    EXPECT_EQ(g_numberOfMultiEntrances, 2);
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+    input.fill();
+
+    tests_csp_interface::SimplyAssignableDescendant<> outputReference;
+    outputReference.fill();
+    outputReference.m_d = input.m_x;
+
+    // Repeated request is answered from cache
+    for (size_t i = 0; i < 3; ++i)
+    {
+        tests_csp_interface::SimplyAssignableDescendant<> output;
+        EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::NoError);
+        EXPECT_EQ(output, outputReference);
+    }
+
+    EXPECT_EQ(idempotentCspService.m_callsCount.load(), 1);
+
+    // Request with different input or flags is handled again
+    input.m_x = 5;
+    outputReference.m_d = 5;
+
+    tests_csp_interface::SimplyAssignableDescendant<> output;
+    EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::NoError);
+    EXPECT_EQ(output, outputReference);
+    EXPECT_EQ(idempotentCspService.m_callsCount.load(), 2);
+
+    output = {};
+    EXPECT_EQ(this->m_client.template handleData<Cht>(input, output, CommonFlags{ CommonFlags::kCorrelationId }, DataFlags{}), Status::NoError);
+    EXPECT_EQ(output, outputReference);
+    EXPECT_EQ(idempotentCspService.m_callsCount.load(), 3);
+
+    // Least recently used response is evicted
+    idempotentCspService.getResponseCache().setLimits(1, ResponseCache::kDefaultMaxInputSize);
+
+    for (uint8_t x : { 1, 2, 1 })
+    {
+        input.m_x = x;
+        EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::NoError);
+    }
+
+    EXPECT_EQ(idempotentCspService.m_callsCount.load(), 6);
+
+    EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::NoError);
+    EXPECT_EQ(idempotentCspService.m_callsCount.load(), 6);
+
+    // Key of Batch item does not depend on items that follow it
+    idempotentCspService.getResponseCache().setLimits(ResponseCache::kDefaultCapacity, ResponseCache::kDefaultMaxInputSize);
+
+    csp::messaging::Client::DataBatch batch;
+
+    for (uint8_t x : { 7, 8, 7 })
+    {
+        input.m_x = x;
+        EXPECT_EQ(this->m_client.template addToBatch<Cht>(batch, input), Status::NoError);
+    }
+
+    EXPECT_EQ(this->m_client.handleBatch(batch), Status::NoError);
+    EXPECT_EQ(idempotentCspService.m_callsCount.load(), 8);
+
+    for (csp_size_t i = 0; i < 3; ++i)
+    {
+        outputReference.m_d = i == 1 ? 8 : 7;
+        EXPECT_EQ(this->m_client.template getBatchOutput<Cht>(batch, i, output), Status::NoError);
+        EXPECT_EQ(output, outputReference);
+    }
+
+    // Body of request that allows unmanaged pointers may hold pointer values, so it is never answered from cache
+    const auto callsCount = idempotentCspService.m_callsCount.load();
+    Vector<GenericPointerKeeper> unmanagedPointers;
+
+    for (size_t i = 0; i < 2; ++i)
+        EXPECT_EQ(this->m_client.template handleData<Cht>(input, output, CommonFlags{}, DataFlags{ DataFlags::kAllowUnmanagedPointers }, &unmanagedPointers), Status::NoError);
+
+    EXPECT_EQ(idempotentCspService.m_callsCount.load(), callsCount + 2);
+}
+
+TYPED_TEST(ComplexTests, ClientBuffersShrinkTest)
+{
+    using Cht = ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>;
+    // Period of buffers shrink of Client
+    constexpr size_t kShrinkPeriod = 1024;
+    constexpr size_t kBigCapacity = 64 * 1024;
+
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    std::vector<size_t> capacities;
+
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillRepeatedly(Invoke(
+        [&server = this->m_server, &capacities](const BinVectorT& input, BinVectorT& output)
+        {
+            // First request grows buffer without using it
+            if (capacities.empty())
+                output.reserve(kBigCapacity);
+
+            capacities.push_back(output.capacity());
+
+            BinWalkerT inputW;
+            inputW.init(input);
+
+            return server.handleMessage(inputW, GenericPointerKeeper{}, output);
+        })
+    );
+
+    // Thread buffers are fresh on new thread, so shrink period starts from first request
+    std::thread([&]
+        {
+            tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+            input.fill();
+
+            for (size_t i = 0; i <= kShrinkPeriod; ++i)
+            {
+                tests_csp_interface::SimplyAssignableDescendant<> output;
+                EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::NoError);
+            }
+        }).join();
+
+    ASSERT_EQ(capacities.size(), kShrinkPeriod + 1);
+
+    // Buffer is reused until the end of period and then shrunk to the size that was used
+    for (size_t i = 0; i < kShrinkPeriod; ++i)
+        EXPECT_GE(capacities[i], kBigCapacity);
+
+    EXPECT_LT(capacities[kShrinkPeriod], kBigCapacity);
+}
+
+TYPED_TEST(ComplexTests, AdmissionControlTest)
+{
+    using Cht = ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>;
+    using Priority = AdmissionController::Priority;
+
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    const Id& interfaceId = tests_csp_interface::properties.m_id;
+    const Id& anotherInterfaceId = tests_csp_another_interface::properties.m_id;
+    const Id inputTypeId = tests_csp_interface::SimplyAssignableAlignedToOne<>::getId();
+
+    AdmissionController admissionController;
+    admissionController.setHandlerLimit(inputTypeId, 1);
+    admissionController.setInterfacePriority(interfaceId, Priority::Low);
+    admissionController.setPriorityLimit(Priority::Low, 2);
+    admissionController.setInterfacePriority(anotherInterfaceId, Priority::High);
+    this->m_server.setAdmissionController(&admissionController);
+
+    Priority messagePriority = Priority::Normal;
+
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillRepeatedly(Invoke(
+        [&server = this->m_server, &messagePriority](const BinVectorT& input, BinVectorT& output)
+        {
+            BinWalkerT inputW;
+            inputW.init(input);
+
+            messagePriority = server.getMessagePriority(inputW);
+            EXPECT_EQ(inputW.tell(), 0);
+
+            return server.handleMessage(inputW, GenericPointerKeeper{}, output);
+        })
+    );
+
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+    input.fill();
+    tests_csp_interface::SimplyAssignableDescendant<> output;
+
+    EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::NoError);
+    EXPECT_EQ(messagePriority, Priority::Low);
+    EXPECT_EQ(admissionController.getInFlightCount(), 0);
+
+    // Handler limit is reached
+    {
+        AdmissionController::Ticket ticket;
+        EXPECT_EQ(admissionController.admit(interfaceId, inputTypeId, ticket), Status::NoError);
+        EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::ErrorBusy);
+    }
+
+    EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::NoError);
+
+    // Lane limit is reached, but other lanes are not affected by it
+    {
+        AdmissionController::Ticket tickets[3];
+        EXPECT_EQ(admissionController.admit(interfaceId, Id{ 1, 1 }, tickets[0]), Status::NoError);
+        EXPECT_EQ(admissionController.admit(interfaceId, Id{ 1, 2 }, tickets[1]), Status::NoError);
+        EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::ErrorBusy);
+        EXPECT_EQ(admissionController.admit(anotherInterfaceId, Id{ 1, 3 }, tickets[2]), Status::NoError);
+        EXPECT_EQ(admissionController.getInFlightCount(), 3);
+    }
+
+    // Global limit is reached
+    admissionController.setGlobalLimit(1);
+
+    {
+        AdmissionController::Ticket ticket;
+        EXPECT_EQ(admissionController.admit(anotherInterfaceId, Id{ 1, 3 }, ticket), Status::NoError);
+        EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::ErrorBusy);
+    }
+
+    EXPECT_EQ(admissionController.getInFlightCount(), 0);
+    EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::NoError);
+
+    // Interface of input type is remembered, so registrar is not used to get lane of next messages
+    firstCspService.unregisterSimplyAssignableAlignedToOne(*this->m_server.getDataHandlersRegistrar());
+    messagePriority = Priority::Normal;
+
+    EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::ErrorNoSuchHandler);
+    EXPECT_EQ(messagePriority, Priority::Low);
+
+    this->m_server.setAdmissionController(nullptr);
+}
+
+TYPED_TEST(ComplexTests, HandlerMetricsTest)
+{
+    using Cht = ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>;
+    using Phase = HandlerMetrics::Phase;
+
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+    SecondCspService secondCspService;
+    secondCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    std::vector<size_t> messageSizes;
+
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillRepeatedly(Invoke(
+        [&server = this->m_server, &messageSizes](const BinVectorT& input, BinVectorT& output)
+        {
+            messageSizes.push_back(input.size());
+
+            BinWalkerT inputW;
+            inputW.init(input);
+
+            return server.handleMessage(inputW, GenericPointerKeeper{}, output);
+        })
+    );
+
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+    input.fill();
+    tests_csp_interface::SimplyAssignableDescendant<> output;
+
+    EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::NoError);
+    EXPECT_EQ(this->m_client.template handleData<Cht>(input, output), Status::NoError);
+
+    tests_csp_interface::SimplyAssignable<> multicastInput;
+    multicastInput.fill();
+    ISerializableDummy outputDummy;
+
+    EXPECT_EQ((this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>(multicastInput, outputDummy)), Status::NoError);
+
+    VectorT<HandlerMetrics::Snapshot> metrics;
+    EXPECT_EQ(this->m_server.getHandlersMetrics(metrics), Status::NoError);
+    EXPECT_EQ(metrics.size(), 4);
+
+    size_t multicastHandlersCount = 0;
+    uint64_t multicastDeserializations = 0;
+    uint64_t requestBytesIn = 0;
+
+    for (const auto& snapshot : metrics)
+    {
+        EXPECT_EQ(snapshot.getErrorsCount(), 0);
+
+        if (snapshot.inputTypeId == tests_csp_interface::SimplyAssignableAlignedToOne<>::getId())
+        {
+            EXPECT_EQ(snapshot.requests, 2);
+            EXPECT_GT(snapshot.bytesOut, 0);
+
+            // Only input body is counted
+            requestBytesIn = snapshot.bytesIn / 2;
+            EXPECT_GT(requestBytesIn, 0);
+            EXPECT_LT(requestBytesIn, messageSizes[0]);
+
+            for (Phase phase : { Phase::Deserialize, Phase::Handle, Phase::Serialize })
+            {
+                const LatencyHistogram::Snapshot& latencies = snapshot.getLatencies(phase);
+                EXPECT_EQ(latencies.count, 2);
+                EXPECT_LE(latencies.getPercentile(50), latencies.max);
+                EXPECT_GE(latencies.max, latencies.getMean());
+            }
+        }
+        else if (snapshot.inputTypeId == tests_csp_interface::SimplyAssignable<>::getId())
+        {
+            ++multicastHandlersCount;
+            EXPECT_EQ(snapshot.requests, 1);
+            EXPECT_GT(snapshot.bytesIn, 0);
+            EXPECT_LT(snapshot.bytesIn, messageSizes[2]);
+            EXPECT_EQ(snapshot.getLatencies(Phase::Handle).count, 1);
+            // Shared input is deserialized only once for all handlers
+            multicastDeserializations += snapshot.getLatencies(Phase::Deserialize).count;
+        }
+        else
+            EXPECT_EQ(snapshot.requests, 0);
+    }
+
+    EXPECT_EQ(multicastHandlersCount, 2);
+    EXPECT_EQ(multicastDeserializations, 1);
+
+    // Item of Batch is counted without items that follow it
+    csp::messaging::Client::DataBatch batch;
+    EXPECT_EQ(this->m_client.template addToBatch<Cht>(batch, input), Status::NoError);
+    EXPECT_EQ((this->m_client.template addToBatch<ClientHeapHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>(batch, multicastInput)), Status::NoError);
+    EXPECT_EQ(this->m_client.handleBatch(batch), Status::NoError);
+
+    EXPECT_EQ(this->m_server.getHandlersMetrics(metrics), Status::NoError);
+
+    for (const auto& snapshot : metrics)
+        if (snapshot.inputTypeId == tests_csp_interface::SimplyAssignableAlignedToOne<>::getId())
+        {
+            EXPECT_EQ(snapshot.requests, 3);
+            EXPECT_EQ(snapshot.bytesIn, 3 * requestBytesIn);
+        }
+
+    // Buckets keep relative error of values within 1/16
+    LatencyHistogram histogram;
+    for (uint64_t value : { 5, 100, 1000, 1000000 })
+        histogram.record(value);
+
+    LatencyHistogram::Snapshot histogramSnapshot;
+    histogram.getSnapshot(histogramSnapshot);
+
+    EXPECT_EQ(histogramSnapshot.count, 4);
+    EXPECT_EQ(histogramSnapshot.max, 1000000);
+    EXPECT_EQ(histogramSnapshot.getPercentile(25), 5);
+    EXPECT_EQ(histogramSnapshot.getPercentile(100), 1000000);
+
+    uint64_t median = histogramSnapshot.getPercentile(50);
+    EXPECT_GE(median, 100);
+    EXPECT_LE(median, 100 + 100 / 16);
+
+    for (uint64_t value = 0; value < 1 << 20; value = value * 3 / 2 + 1)
+    {
+        size_t index = LatencyHistogram::getBucketIndex(value);
+        EXPECT_LE(LatencyHistogram::getBucketLowestValue(index), value);
+        EXPECT_GT(LatencyHistogram::getBucketLowestValue(index + 1), value);
+    }
+
+    // Values recorded by different threads go to different shards and are merged in snapshot
+    constexpr size_t kThreadsCount = LatencyHistogram::kShardsCount + 2;
+    constexpr uint64_t kValuesCount = 1000;
+
+    LatencyHistogram shardedHistogram;
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < kThreadsCount; ++i)
+        threads.emplace_back([&shardedHistogram, i]
+            {
+                for (uint64_t value = 0; value < kValuesCount; ++value)
+                    shardedHistogram.record(value + i);
+            });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    shardedHistogram.getSnapshot(histogramSnapshot);
+
+    EXPECT_EQ(histogramSnapshot.count, kThreadsCount * kValuesCount);
+    EXPECT_EQ(histogramSnapshot.max, kValuesCount - 1 + kThreadsCount - 1);
+    EXPECT_EQ(histogramSnapshot.sum, kThreadsCount * (kValuesCount * (kValuesCount - 1) / 2) + kValuesCount * (kThreadsCount * (kThreadsCount - 1) / 2));
+}
+
+TYPED_TEST(ComplexTests, CorrelationIdTest)
+{
+    using Cht = ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>;
+    constexpr size_t kRequestsCount = 16;
+
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    csp::messaging::Client client(this->m_clientToServerCommunicator);
+    EXPECT_EQ(client.init(getMandatoryCorrelationIdCspPartySettings()), Status::NoError);
+
+    AsyncClientToServerCommunicator asyncCommunicator(this->m_server);
+    client.setAsyncClientToServerCommunicator(&asyncCommunicator);
+
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+    input.fill();
+    tests_csp_interface::SimplyAssignableDescendant<> outputReference;
+    outputReference.fill();
+
+    // Many requests in flight, responses are coming in arbitrary order
+    std::vector<tests_csp_interface::SimplyAssignableDescendant<>> outputs(kRequestsCount);
+    std::vector<Status> statuses(kRequestsCount, Status::ErrorInternal);
+    std::atomic_int completedCount = 0;
+
+    for (size_t i = 0; i < kRequestsCount; ++i)
+        awaitHandleData<Cht>(client, input, outputs[i], statuses[i], completedCount);
+
+    asyncCommunicator.join();
+
+    EXPECT_EQ(completedCount.load(), kRequestsCount);
+
+    for (size_t i = 0; i < kRequestsCount; ++i)
+    {
+        EXPECT_EQ(statuses[i], Status::NoError);
+        EXPECT_EQ(outputs[i], outputReference);
+    }
+
+    client.setAsyncClientToServerCommunicator(nullptr);
+
+    // Response must have the same correlation id as request
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillOnce(Invoke(
+        [&server = this->m_server](const BinVectorT& input, BinVectorT& output)
+        {
+            uint64_t requestCorrelationId = 0;
+            EXPECT_EQ(csp::processing::common::ContextProcessor::getCorrelationId(input, requestCorrelationId), Status::NoError);
+
+            BinWalkerT inputW;
+            inputW.init(input);
+
+            Status status = server.handleMessage(inputW, GenericPointerKeeper{}, output);
+
+            uint64_t responseCorrelationId = 0;
+            EXPECT_EQ(csp::processing::common::ContextProcessor::getCorrelationId(output, responseCorrelationId), Status::NoError);
+            EXPECT_EQ(responseCorrelationId, requestCorrelationId);
+
+            // Simulate response on another request
+            EXPECT_EQ(csp::processing::common::ContextProcessor::setCorrelationId(output, requestCorrelationId + 1), Status::NoError);
+
+            return status;
+        })
+    );
+
+    tests_csp_interface::SimplyAssignableDescendant<> output;
+    EXPECT_EQ((client.template handleData<Cht>(input, output)), Status::ErrorDataCorrupted);
+}
+
+TYPED_TEST(ComplexTests, ClientSettingsCacheTest)
+{
+    using Cht = ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>;
+
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    size_t messagesCount = 0;
+    size_t failedMessagesFrom = std::numeric_limits<size_t>::max();
+
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillRepeatedly(Invoke(
+        [&server = this->m_server, &messagesCount, &failedMessagesFrom](const BinVectorT& input, BinVectorT& output)
+        {
+            if (++messagesCount >= failedMessagesFrom)
+                return Status::ErrorNotAvailible;
+
+            BinWalkerT inputW;
+            inputW.init(input);
+
+            return server.handleMessage(inputW, GenericPointerKeeper{}, output);
+        })
+    );
+
+    const Id serverId{ 0x1d2f4c7e8a9b4c3d, 0x9e8f7a6b5c4d3e2f };
+    const CspPartySettings<> clientSettings = getValidCspPartySettings();
+    ClientSettingsCache cache;
+
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+    input.fill();
+    tests_csp_interface::SimplyAssignableDescendant<> outputReference;
+    outputReference.fill();
+
+    // No cached settings - full negotiation is made
+    {
+        csp::messaging::Client client(this->m_clientToServerCommunicator);
+        EXPECT_EQ(client.init(clientSettings, serverId, cache), Status::NoError);
+        EXPECT_EQ(messagesCount, 2);
+        EXPECT_EQ(cache.size(), 1);
+    }
+
+    // Cached settings - data is sent at once
+    {
+        messagesCount = 0;
+        csp::messaging::Client client(this->m_clientToServerCommunicator);
+        EXPECT_EQ(client.init(clientSettings, serverId, cache), Status::NoError);
+        EXPECT_EQ(messagesCount, 0);
+
+        tests_csp_interface::SimplyAssignableDescendant<> output;
+        EXPECT_EQ((client.template handleData<Cht>(input, output)), Status::NoError);
+        EXPECT_EQ(output, outputReference);
+        EXPECT_EQ(messagesCount, 1);
+    }
+
+    uint64_t clientSettingsHash = 0;
+    EXPECT_EQ(ClientSettingsCache::getSettingsHash(clientSettings, clientSettingsHash), Status::NoError);
+
+    RawVectorT<protocol_version_t> protocolVersions;
+    protocolVersions.pushBackN(kProtocolVersions, getProtocolVersionsCount());
+    RawVectorT<InterfaceVersion<>> interfaces;
+    InterfaceVersion<> staleInterface{ tests_csp_interface::properties };
+    // Server handler supports only interface versions starting from 1
+    staleInterface.m_version = 0;
+    interfaces.pushBack(staleInterface);
+    const CspPartySettings<> staleSettings(protocolVersions, {}, {}, interfaces);
+
+    // Stale cached settings and failed renegotiation - client keeps previous settings
+    {
+        EXPECT_EQ(cache.insert(serverId, clientSettingsHash, staleSettings), Status::NoError);
+
+        messagesCount = 0;
+        csp::messaging::Client client(this->m_clientToServerCommunicator);
+        EXPECT_EQ(client.init(clientSettings, serverId, cache), Status::NoError);
+
+        // Only the data request reaches server
+        failedMessagesFrom = 2;
+
+        tests_csp_interface::SimplyAssignableDescendant<> output;
+        EXPECT_EQ((client.template handleData<Cht>(input, output)), Status::ErrorNotAvailible);
+        EXPECT_TRUE(client.isValid());
+        EXPECT_EQ(client.getInterfaceVersion(tests_csp_interface::properties.m_id), 0);
+
+        // Renegotiation is retried on next request
+        messagesCount = 0;
+        failedMessagesFrom = std::numeric_limits<size_t>::max();
+
+        EXPECT_EQ((client.template handleData<Cht>(input, output)), Status::NoError);
+        EXPECT_EQ(output, outputReference);
+        EXPECT_EQ(messagesCount, 4);
+        EXPECT_EQ(client.getInterfaceVersion(tests_csp_interface::properties.m_id), tests_csp_interface::properties.m_version);
+    }
+
+    // Stale cached settings - server rejects request and settings are renegotiated
+    {
+        EXPECT_EQ(cache.insert(serverId, clientSettingsHash, staleSettings), Status::NoError);
+
+        messagesCount = 0;
+        csp::messaging::Client client(this->m_clientToServerCommunicator);
+        EXPECT_EQ(client.init(clientSettings, serverId, cache), Status::NoError);
+        EXPECT_EQ(client.getInterfaceVersion(tests_csp_interface::properties.m_id), 0);
+
+        tests_csp_interface::SimplyAssignableDescendant<> output;
+        EXPECT_EQ((client.template handleData<Cht>(input, output)), Status::NoError);
+        EXPECT_EQ(output, outputReference);
+        EXPECT_EQ(messagesCount, 4);
+        EXPECT_EQ(client.getInterfaceVersion(tests_csp_interface::properties.m_id), tests_csp_interface::properties.m_version);
+
+        CspPartySettings<> cachedSettings;
+        EXPECT_TRUE(cache.find(serverId, clientSettingsHash, cachedSettings));
+        EXPECT_EQ(cachedSettings, client.getSettings());
+    }
+
+    // Cache outlives process
+    {
+        BinWalkerT binCache;
+        EXPECT_EQ(cache.save(binCache.getVector()), Status::NoError);
+
+        ClientSettingsCache loadedCache;
+        EXPECT_EQ(loadedCache.load(binCache), Status::NoError);
+        EXPECT_EQ(loadedCache.size(), 1);
+
+        messagesCount = 0;
+        csp::messaging::Client client(this->m_clientToServerCommunicator);
+        EXPECT_EQ(client.init(clientSettings, serverId, loadedCache), Status::NoError);
+        EXPECT_EQ(messagesCount, 0);
+        EXPECT_EQ(client.getSettings(), this->m_client.getSettings());
+    }
+}
+
+TYPED_TEST(ComplexTests, BatchTest)
+{
+    using Cht = ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>;
+    using Cht2 = ClientHeapHandler<tests_csp_interface::Diamond<>, tests_csp_interface::DynamicPolymorphic<>>;
+    constexpr csp_size_t kRequestsCount = 8;
+
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+    input.fill();
+    tests_csp_interface::SimplyAssignableDescendant<> outputReference;
+    outputReference.fill();
+
+    tests_csp_interface::Diamond<> input2;
+    input2.fill();
+    tests_csp_interface::DynamicPolymorphic<> outputReference2;
+    outputReference2.fill();
+
+    // All requests of batch must be sent in one message
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).Times(2).WillRepeatedly(Invoke(
+        [&server = this->m_server](const BinVectorT& input, BinVectorT& output)
+        {
+            BinWalkerT inputW;
+            inputW.init(input);
+
+            return server.handleMessage(inputW, GenericPointerKeeper{}, output);
+        })
+    );
+
+    csp::messaging::Client::DataBatch batch;
+
+    for (csp_size_t i = 0; i < kRequestsCount; ++i)
+        EXPECT_EQ(i % 2 ? this->m_client.template addToBatch<Cht2>(batch, input2) : this->m_client.template addToBatch<Cht>(batch, input), Status::NoError);
+
+    EXPECT_EQ(batch.size(), kRequestsCount);
+    EXPECT_EQ(this->m_client.handleBatch(batch), Status::NoError);
+
+    for (csp_size_t i = 0; i < kRequestsCount; ++i)
+        if (i % 2)
+        {
+            tests_csp_interface::DynamicPolymorphic<> output;
+            EXPECT_EQ(this->m_client.template getBatchOutput<Cht2>(batch, i, output), Status::NoError);
+            EXPECT_EQ(output, outputReference2);
+        }
+        else
+        {
+            tests_csp_interface::SimplyAssignableDescendant<> output;
+            EXPECT_EQ(this->m_client.template getBatchOutput<Cht>(batch, i, output), Status::NoError);
+            EXPECT_EQ(output, outputReference);
+        }
+
+    tests_csp_interface::SimplyAssignableDescendant<> output;
+    EXPECT_EQ(this->m_client.template getBatchOutput<Cht>(batch, kRequestsCount, output), Status::ErrorInvalidArgument);
+
+    // Failure of one request must not affect others
+    batch.clear();
+    firstCspService.unregisterDiamond(*this->m_server.getDataHandlersRegistrar());
+
+    EXPECT_EQ(this->m_client.template addToBatch<Cht>(batch, input), Status::NoError);
+    EXPECT_EQ(this->m_client.template addToBatch<Cht2>(batch, input2), Status::NoError);
+    EXPECT_EQ(this->m_client.template addToBatch<Cht>(batch, input), Status::NoError);
+    EXPECT_EQ(this->m_client.handleBatch(batch), Status::NoError);
+
+    tests_csp_interface::DynamicPolymorphic<> output2;
+    EXPECT_EQ(this->m_client.template getBatchOutput<Cht2>(batch, 1, output2), Status::ErrorNoSuchHandler);
+
+    for (csp_size_t i = 0; i < 3; i += 2)
+    {
+        tests_csp_interface::SimplyAssignableDescendant<> output;
+        EXPECT_EQ(this->m_client.template getBatchOutput<Cht>(batch, i, output), Status::NoError);
+        EXPECT_EQ(output, outputReference);
+    }
+}
+
+TYPED_TEST(ComplexTests, SharedMemoryTransportTest)
+{
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    transport::SharedMemoryChannel serverChannel;
+    ASSERT_EQ(serverChannel.create(4096), Status::NoError);
+
+    transport::SharedMemoryChannel clientChannel;
+    ASSERT_EQ(clientChannel.open(serverChannel.getFd()), Status::NoError);
+
+    transport::SharedMemoryServerPump pump(this->m_server, serverChannel);
+    Status pumpStatus = Status::ErrorInternal;
+    std::thread serverThread([&pump, &pumpStatus] { pumpStatus = pump.run(GenericPointerKeeper{}); });
+
+    transport::SharedMemoryClientToServerCommunicator communicator(clientChannel);
+    csp::messaging::Client client(communicator);
+    EXPECT_EQ(client.init(getValidCspPartySettings()), Status::NoError);
+
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+    input.fill();
+
+    tests_csp_interface::SimplyAssignableDescendant<> outputReference;
+    outputReference.fill();
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        tests_csp_interface::SimplyAssignableDescendant<> output;
+        EXPECT_EQ((client.handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>(input, output)), Status::NoError);
+        EXPECT_EQ(output, outputReference);
+    }
+
+    clientChannel.close();
+    serverThread.join();
+
+    EXPECT_EQ(pumpStatus, Status::NoError);
+
+    tests_csp_interface::SimplyAssignableDescendant<> output;
+    EXPECT_EQ((client.handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>(input, output)), Status::ErrorNotAvailible);
+}
+
+TYPED_TEST(ComplexTests, SharedMemoryTransportResponseOverflowTest)
+{
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    // Ring is big enough for settings and for request, but not for response
+    transport::SharedMemoryChannel serverChannel;
+    ASSERT_EQ(serverChannel.create(128), Status::NoError);
+
+    transport::SharedMemoryChannel clientChannel;
+    ASSERT_EQ(clientChannel.open(serverChannel.getFd()), Status::NoError);
+
+    transport::SharedMemoryServerPump pump(this->m_server, serverChannel);
+    Status pumpStatus = Status::ErrorInternal;
+    std::thread serverThread([&pump, &pumpStatus] { pumpStatus = pump.run(GenericPointerKeeper{}); });
+
+    transport::SharedMemoryClientToServerCommunicator communicator(clientChannel);
+    csp::messaging::Client client(communicator);
+    EXPECT_EQ(client.init(getValidCspPartySettings()), Status::NoError);
+
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+    input.fill();
+    tests_csp_interface::SimplyAssignableDescendant<> output;
+
+    // Server must answer with error instead of leaving client without response
+    EXPECT_EQ((client.handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>(input, output)), Status::ErrorOverflow);
+
+    // Channel stays usable for smaller responses
+    tests_csp_interface::Diamond<> input2;
+    input2.fill();
+    tests_csp_interface::DynamicPolymorphic<> output2;
+    EXPECT_EQ((client.handleData<ClientHeapHandler<tests_csp_interface::Diamond<>, tests_csp_interface::DynamicPolymorphic<>>>(input2, output2)), Status::NoError);
+
+    clientChannel.close();
+    serverThread.join();
+
+    EXPECT_EQ(pumpStatus, Status::NoError);
+}
+
+TYPED_TEST(ComplexTests, StreamSocketTransportTest)
+{
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    std::string unixPath = "/tmp/ags_cs_stream_socket_test_" + std::to_string(getpid());
+
+    transport::StreamSocketServer unixServer(this->m_server);
+    ASSERT_EQ(unixServer.listenUnix(unixPath.c_str()), Status::NoError);
+    ASSERT_EQ(unixServer.start(2), Status::NoError);
+
+    transport::StreamSocketServer tcpServer(this->m_server);
+    ASSERT_EQ(tcpServer.listenTcpLoopback(0), Status::NoError);
+    ASSERT_NE(tcpServer.getPort(), 0);
+    ASSERT_EQ(tcpServer.start(2), Status::NoError);
+
+    constexpr size_t kClientsCount = 4;
+    std::vector<std::thread> clientThreads;
+
+    for (size_t i = 0; i < kClientsCount; ++i)
+        clientThreads.emplace_back([i, &unixPath, port = tcpServer.getPort()]
+            {
+                transport::StreamSocketClientToServerCommunicator communicator;
+
+                if (i % 2 == 0)
+                    EXPECT_EQ(communicator.connectUnix(unixPath.c_str()), Status::NoError);
+                else
+                    EXPECT_EQ(communicator.connectTcpLoopback(port), Status::NoError);
+
+                communicator.setWithChecksum(i >= kClientsCount / 2);
+
+                csp::messaging::Client client(communicator);
+                EXPECT_EQ(client.init(getValidCspPartySettings()), Status::NoError);
+
+                tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+                input.fill();
+
+                tests_csp_interface::SimplyAssignableDescendant<> outputReference;
+                outputReference.fill();
+
+                for (size_t j = 0; j < 100; ++j)
+                {
+                    tests_csp_interface::SimplyAssignableDescendant<> output;
+                    EXPECT_EQ((client.handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>(input, output)), Status::NoError);
+                    EXPECT_EQ(output, outputReference);
+                }
+            });
+
+    for (auto& thread : clientThreads)
+        thread.join();
+
+    unixServer.stop();
+    tcpServer.stop();
+
+    transport::StreamSocketClientToServerCommunicator communicator;
+    EXPECT_EQ(communicator.connectUnix(unixPath.c_str()), Status::ErrorNotAvailible);
+}
+
+TYPED_TEST(ComplexTests, StreamSocketStalledClientTest)
+{
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    std::string unixPath = "/tmp/ags_cs_stream_socket_stalled_test_" + std::to_string(getpid());
+
+    // The only thread of server must not be held by client that doesn't read responses
+    transport::StreamSocketServer server(this->m_server);
+    ASSERT_EQ(server.listenUnix(unixPath.c_str()), Status::NoError);
+    ASSERT_EQ(server.start(1), Status::NoError);
+
+    BinVectorT request;
+    context::SCommon ctxRequest(request, this->m_server.getSettings().getLatestProtocolVersion(), context::Message::GetSettings
+        , this->m_server.getSettings().getMandatoryCommonFlags());
+    ASSERT_EQ(processing::common::ContextProcessor::serialize(ctxRequest), Status::NoError);
+
+    uint8_t header[transport::Framing::kMaxHeaderSize]{};
+    size_t headerSize = 0;
+    ASSERT_EQ(transport::Framing::makeHeader(request.data(), request.size(), false, header, headerSize), Status::NoError);
+
+    BinVectorT requests;
+    for (size_t i = 0; i < 1024; ++i)
+    {
+        ASSERT_EQ(requests.pushBackN(header, headerSize), Status::NoError);
+        ASSERT_EQ(requests.pushBackN(request.data(), request.size()), Status::NoError);
+    }
+
+    transport::StreamSocket stalledSocket;
+    ASSERT_EQ(stalledSocket.connectUnix(unixPath.c_str()), Status::NoError);
+
+    // Requests are sent until server stops reading them, because their responses are not read
+    for (size_t idleCount = 0; idleCount < 100;)
+    {
+        size_t sentSize = 0;
+        ASSERT_EQ(stalledSocket.sendNoWait(requests.data(), requests.size(), nullptr, 0, sentSize), Status::NoError);
+
+        if (sentSize == 0)
+        {
+            ++idleCount;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        else
+            idleCount = 0;
+    }
+
+    transport::StreamSocketClientToServerCommunicator communicator;
+    ASSERT_EQ(communicator.connectUnix(unixPath.c_str()), Status::NoError);
+
+    csp::messaging::Client client(communicator);
+    EXPECT_EQ(client.init(getValidCspPartySettings()), Status::NoError);
+
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input;
+    input.fill();
+    tests_csp_interface::SimplyAssignableDescendant<> output;
+    EXPECT_EQ((client.handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>(input, output)), Status::NoError);
+
+    server.stop();
+}
+
+TYPED_TEST(ComplexTests, SimpleMulticastTest)
+{
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+    SecondCspService secondCspService;
+    secondCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    tests_csp_interface::SimplyAssignable<> input;
+    input.fill();
+    ISerializableDummy outputDummy;
+
+    g_numberOfMultiEntrances = 0;
+    g_numberOfDistinctMultiInputs = 0;
+    g_pLastMultiInput = nullptr;
+
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillOnce(Invoke(
+        [&server = this->m_server](const BinVectorT& input, BinVectorT& output)
+        {
+            BinWalkerT inputW;
+            inputW.init(input);
+
+            return server.handleMessage(inputW, GenericPointerKeeper{}, output);
+        })
+    );
+
+    EXPECT_EQ((this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>(input, outputDummy)), Status::NoError);
+    EXPECT_EQ(g_numberOfMultiEntrances.load(), 2);
+    // Input must be deserialized once and shared between all handlers
+    EXPECT_EQ(g_numberOfDistinctMultiInputs.load(), 1);
+}
+
+TYPED_TEST(ComplexTests, ConcurrentMulticastTest)
+{
+    csp::messaging::ThreadPool threadPool;
+    EXPECT_EQ(threadPool.init(2), Status::NoError);
+    this->m_server.setExecutor(&threadPool);
+
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+    SecondCspService secondCspService;
+    secondCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    tests_csp_interface::SimplyAssignable<> input;
+    input.fill();
+    ISerializableDummy outputDummy;
+
+    g_numberOfMultiEntrances = 0;
+    g_numberOfDistinctMultiInputs = 0;
+    g_pLastMultiInput = nullptr;
+
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillOnce(Invoke(
+        [&server = this->m_server](const BinVectorT& input, BinVectorT& output)
+        {
+            BinWalkerT inputW;
+            inputW.init(input);
+
+            return server.handleMessage(inputW, GenericPointerKeeper{}, output);
+        })
+    );
+
+    EXPECT_EQ((this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>(input, outputDummy)), Status::NoError);
+    EXPECT_EQ(g_numberOfMultiEntrances.load(), 2);
+    // Input must be deserialized once and shared between all handlers
+    EXPECT_EQ(g_numberOfDistinctMultiInputs.load(), 1);
+
+    this->m_server.setExecutor(nullptr);
+}
+
+TYPED_TEST(ComplexTests, ConcurrentMulticastOnExecutorThreadTest)
+{
+    // The only worker handles message itself, so multicast tasks can be run only if it takes them back
+    csp::messaging::ThreadPool threadPool;
+    EXPECT_EQ(threadPool.init(1), Status::NoError);
+    this->m_server.setExecutor(&threadPool);
+
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+    SecondCspService secondCspService;
+    secondCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    tests_csp_interface::SimplyAssignable<> input;
+    input.fill();
+    ISerializableDummy outputDummy;
+
+    g_numberOfMultiEntrances = 0;
+
+    struct HandleMessageTask : csp::messaging::IExecutor::ITask
+    {
+        HandleMessageTask(const Server& server, const BinVectorT& input, BinVectorT& output)
+            : server(server), output(output)
+        {
+            this->input.init(input);
+        }
+
+        void run() noexcept override
+        {
+            status = server.handleMessage(input, GenericPointerKeeper{}, output);
+            done.count_down();
+        }
+
+        const Server& server;
+        BinWalkerT input;
+        BinVectorT& output;
+        Status status{ Status::NoError };
+        std::latch done{ 1 };
+    };
+
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillOnce(Invoke(
+        [&server = this->m_server, &threadPool](const BinVectorT& input, BinVectorT& output)
+        {
+            HandleMessageTask task(server, input, output);
+            EXPECT_EQ(threadPool.execute(task), Status::NoError);
+            task.done.wait();
+
+            return task.status;
+        })
+    );
+
+    EXPECT_EQ((this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>(input, outputDummy)), Status::NoError);
+    EXPECT_EQ(g_numberOfMultiEntrances.load(), 2);
+
+    this->m_server.setExecutor(nullptr);
+}
+
+TYPED_TEST(ComplexTests, MulticastPoliciesTest)
+{
+    RejectingCspService rejectingCspService;
+    rejectingCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    tests_csp_interface::SimplyAssignable<> input;
+    input.fill();
+    ISerializableDummy outputDummy;
+
+    g_numberOfMultiEntrances = 0;
+
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillRepeatedly(Invoke(
+        [&server = this->m_server](const BinVectorT& input, BinVectorT& output)
+        {
+            BinWalkerT inputW;
+            inputW.init(input);
+
+            return server.handleMessage(inputW, GenericPointerKeeper{}, output);
+        })
+    );
+
+    // Handler that rejects message is skipped, while others still get it
+    SecondCspService secondCspService;
+    secondCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    EXPECT_EQ((this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>(input, outputDummy)), Status::ErrorNotAvailible);
+    EXPECT_EQ(g_numberOfMultiEntrances.load(), 1);
+
+    // When all handlers reject message, its input is not deserialized at all
+    secondCspService.unregisterService(*this->m_server.getDataHandlersRegistrar());
+    RejectingCspService secondRejectingCspService;
+    secondRejectingCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    EXPECT_EQ((this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>(input, outputDummy)), Status::ErrorNotAvailible);
+    EXPECT_EQ(g_numberOfMultiEntrances.load(), 1);
+
+    csm::HandlerMetrics::Snapshot metrics;
+    rejectingCspService.getMetrics().getSnapshot(metrics);
+    EXPECT_EQ(metrics.requests, 2);
+    EXPECT_EQ(metrics.getErrorsCount(Status::ErrorNotAvailible), 2);
+}
+
+TYPED_TEST(ComplexTests, RegistrarWriterProgressTest)
+{
+    // Writer of generic registrar waits for shared mutex, which may be reader-preferring
+    if constexpr (!std::is_same_v<TypeParam, RcuServerDataHandlerRegistrar>)
+        GTEST_SKIP();
+
+    // More readers than reader slots, so some of them share slots and slots are never free of readers
+    constexpr size_t kReadersCount = 80;
+    constexpr size_t kChangesCount = 4;
+
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+    SecondCspService secondCspService;
+    secondCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    IServerDataHandlerRegistrar& registrar = *this->m_server.getDataHandlersRegistrar();
+    const Id id = tests_csp_interface::SimplyAssignable<>::getId();
+
+    std::atomic_bool stop = false;
+    std::atomic_size_t readersStarted = 0;
+    std::vector<std::thread> readers;
+
+    for (size_t i = 0; i < kReadersCount; ++i)
+        readers.emplace_back([&]
+            {
+                RawVectorT<IServerDataHandlerBase*> handlers;
+                ++readersStarted;
+
+                while (!stop.load(std::memory_order_relaxed))
+                    if (statusSuccess(registrar.aquireHandlers(id, handlers)))
+                        for (auto pHandler : handlers)
+                            registrar.releaseHandler(pHandler);
+            });
+
+    while (readersStarted.load() != kReadersCount)
+        std::this_thread::yield();
+
+    for (size_t i = 0; i < kChangesCount; ++i)
+    {
+        secondCspService.unregisterService(registrar);
+        secondCspService.registerHandlers(registrar);
+    }
+
+    stop = true;
+
+    for (auto& reader : readers)
+        reader.join();
+
+    firstCspService.unregisterService(registrar);
+    secondCspService.unregisterService(registrar);
+}
+
+TYPED_TEST(ComplexTests, RegisterWhileHandlerInUseTest)
+{
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    IServerDataHandlerRegistrar& registrar = *this->m_server.getDataHandlersRegistrar();
+
+    // Registration must not wait for handlers that are in use by the same thread
+    IServerDataHandlerBase* pHandler = nullptr;
+    ASSERT_EQ(registrar.aquireHandler(tests_csp_interface::Diamond<>::getId(), pHandler), Status::NoError);
+
+    SecondCspService secondCspService;
+    EXPECT_EQ(secondCspService.registerHandlers(registrar), Status::NoError);
+
+    RawVectorT<IServerDataHandlerBase*> handlers;
+    EXPECT_EQ(registrar.aquireHandlers(tests_csp_interface::SimplyAssignable<>::getId(), handlers), Status::NoError);
+    EXPECT_EQ(handlers.size(), 2);
+
+    for (auto pMultiHandler : handlers)
+        registrar.releaseHandler(pMultiHandler);
+
+    registrar.releaseHandler(pHandler);
+
+    secondCspService.unregisterService(registrar);
+    EXPECT_EQ(registrar.aquireHandlers(tests_csp_interface::SimplyAssignable<>::getId(), handlers), Status::NoError);
+    EXPECT_EQ(handlers.size(), 1);
+
+    for (auto pMultiHandler : handlers)
+        registrar.releaseHandler(pMultiHandler);
+
+    firstCspService.unregisterService(registrar);
+}
+
+TYPED_TEST(ComplexTests, UnregisterWaitsForReleaseTest)
+{
+    FirstCspService firstCspService;
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    IServerDataHandlerRegistrar& registrar = *this->m_server.getDataHandlersRegistrar();
+
+    for (bool wholeService : { false, true })
+    {
+        IServerDataHandlerBase* pHandler = nullptr;
+        ASSERT_EQ(registrar.aquireHandler(tests_csp_interface::Diamond<>::getId(), pHandler), Status::NoError);
+
+        std::atomic_bool unregistered = false;
+        std::thread unregisterThread([&]
+            {
+                if (wholeService)
+                    firstCspService.unregisterService(registrar);
+                else
+                    firstCspService.unregisterDiamond(registrar);
+
+                unregistered = true;
+            });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_FALSE(unregistered.load());
+
+        registrar.releaseHandler(pHandler);
+        unregisterThread.join();
+
+        EXPECT_TRUE(unregistered.load());
+        EXPECT_EQ(registrar.aquireHandler(tests_csp_interface::Diamond<>::getId(), pHandler), Status::ErrorNoSuchHandler);
+
+        firstCspService.unregisterService(registrar);
+        firstCspService.registerHandlers(registrar);
+    }
+
+    firstCspService.unregisterService(registrar);
+}
+
+TYPED_TEST(ComplexTests, PooledHandlersTest)
+{
+    PooledCspService pooledCspService;
+    pooledCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+
+    tests_csp_interface::Diamond<> input;
+    input.fill();
+    tests_csp_interface::DynamicPolymorphic<> outputReference;
+    outputReference.fill();
+
+    tests_csp_interface::SimplyAssignableAlignedToOne<> input2;
+    input2.fill();
+    tests_csp_interface::SimplyAssignableDescendant<> outputReference2;
+    outputReference2.fill();
+
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillRepeatedly(Invoke(
+        [&server = this->m_server](const BinVectorT& input, BinVectorT& output)
+        {
+            BinWalkerT inputW;
+            inputW.init(input);
+
+            return server.handleMessage(inputW, GenericPointerKeeper{}, output);
+        })
+    );
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        tests_csp_interface::DynamicPolymorphic<> output;
+        EXPECT_EQ((this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::Diamond<>, tests_csp_interface::DynamicPolymorphic<>>>(input, output)), Status::NoError);
+        EXPECT_EQ(output, outputReference);
+
+        tests_csp_interface::SimplyAssignableDescendant<> output2;
+        EXPECT_EQ((this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>(input2, output2)), Status::NoError);
+        EXPECT_EQ(output2, outputReference2);
+    }
+
+    // Every handler must receive the same input object on sequential requests
+    EXPECT_EQ(pooledCspService.m_inputs.size(), 2);
 }
 
-TEST_F(ComplexTests, StressTest)
+TYPED_TEST(ComplexTests, StressTest)
 {   
     FirstCspService firstCspService;
-    firstCspService.registerHandlers(*m_server.getDataHandlersRegistrar());
+    firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
     SecondCspService secondCspService;
-    secondCspService.registerHandlers(*m_server.getDataHandlersRegistrar());
+    secondCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
 
     tests_csp_interface::SimplyAssignableAlignedToOne<> input;
     input.fill();
@@ -268,7 +1822,7 @@ TEST_F(ComplexTests, StressTest)
     input3.fill();
     tests_csp_interface::DynamicPolymorphic<> output3;
 
-    EXPECT_CALL(m_clientToServerCommunicator, process).WillRepeatedly(Invoke(
+    EXPECT_CALL(this->m_clientToServerCommunicator, process).WillRepeatedly(Invoke(
         [&server = this->m_server](const BinVectorT& input, BinVectorT& output)
         {
             BinWalkerT inputW;
@@ -282,9 +1836,9 @@ TEST_F(ComplexTests, StressTest)
         {
             for (size_t i = 0; i < 10000; ++i)
             {
-                m_client.handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>(input2, outputDummy);
-                m_client.handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>(input, output);
-                m_client.handleData<ClientHeapHandler<tests_csp_interface::Diamond<>, tests_csp_interface::DynamicPolymorphic<>>>(input3, output3);
+                this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>(input2, outputDummy);
+                this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>(input, output);
+                this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::Diamond<>, tests_csp_interface::DynamicPolymorphic<>>>(input3, output3);
             }
         });
 
@@ -292,9 +1846,9 @@ TEST_F(ComplexTests, StressTest)
         {
             for (size_t i = 0; i < 10000; ++i)
             {
-                m_client.handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>(input2, outputDummy);
-                m_client.handleData<ClientHeapHandler<tests_csp_interface::Diamond<>, tests_csp_interface::DynamicPolymorphic<>>>(input3, output3);
-                m_client.handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>(input, output);
+                this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignable<>, ISerializableDummy>>(input2, outputDummy);
+                this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::Diamond<>, tests_csp_interface::DynamicPolymorphic<>>>(input3, output3);
+                this->m_client.template handleData<ClientHeapHandler<tests_csp_interface::SimplyAssignableAlignedToOne<>, tests_csp_interface::SimplyAssignableDescendant<>>>(input, output);
             }
         });
         
@@ -302,15 +1856,15 @@ TEST_F(ComplexTests, StressTest)
         {
             for (size_t i = 0; i < 200; ++i)
             {
-                firstCspService.unregisterService(*m_server.getDataHandlersRegistrar());
+                firstCspService.unregisterService(*this->m_server.getDataHandlersRegistrar());
                 std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                firstCspService.registerHandlers(*m_server.getDataHandlersRegistrar());
-                firstCspService.unregisterSimplyAssignableAlignedToOne(*m_server.getDataHandlersRegistrar());
-                firstCspService.unregisterSimplyAssignableAlignedToOne(*m_server.getDataHandlersRegistrar());
-                firstCspService.unregisterDiamond(*m_server.getDataHandlersRegistrar());
-                firstCspService.unregisterSimplyAssignable(*m_server.getDataHandlersRegistrar());
-                firstCspService.unregisterService(*m_server.getDataHandlersRegistrar());
-                firstCspService.registerHandlers(*m_server.getDataHandlersRegistrar());
+                firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+                firstCspService.unregisterSimplyAssignableAlignedToOne(*this->m_server.getDataHandlersRegistrar());
+                firstCspService.unregisterSimplyAssignableAlignedToOne(*this->m_server.getDataHandlersRegistrar());
+                firstCspService.unregisterDiamond(*this->m_server.getDataHandlersRegistrar());
+                firstCspService.unregisterSimplyAssignable(*this->m_server.getDataHandlersRegistrar());
+                firstCspService.unregisterService(*this->m_server.getDataHandlersRegistrar());
+                firstCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
             }
         });
 
@@ -318,11 +1872,11 @@ TEST_F(ComplexTests, StressTest)
         {
             for (size_t i = 0; i < 200; ++i)
             {
-                secondCspService.unregisterService(*m_server.getDataHandlersRegistrar());
+                secondCspService.unregisterService(*this->m_server.getDataHandlersRegistrar());
                 std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                secondCspService.registerHandlers(*m_server.getDataHandlersRegistrar());
-                secondCspService.unregisterService(*m_server.getDataHandlersRegistrar());
-                secondCspService.registerHandlers(*m_server.getDataHandlersRegistrar());
+                secondCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
+                secondCspService.unregisterService(*this->m_server.getDataHandlersRegistrar());
+                secondCspService.registerHandlers(*this->m_server.getDataHandlersRegistrar());
             }
         });
 
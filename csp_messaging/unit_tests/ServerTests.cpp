@@ -50,12 +50,18 @@ public:
     MOCK_METHOD(Status, aquireHandlers, (const Id&, RawVectorT<IServerDataHandlerBase*>&), (override));
     MOCK_METHOD(Status, aquireHandler, (const Id&, IServerDataHandlerBase*&), (noexcept, override));
     MOCK_METHOD(void, releaseHandler, (IServerDataHandlerBase*), (noexcept, override));
+    MOCK_METHOD(Status, getHandlersMetrics, (VectorT<csp::messaging::HandlerMetrics::Snapshot>&), (const, override));
 };
 
 class ServerDataHandlerBaseMock : public csp::messaging::IServerDataHandlerBase
 {
 public:
     MOCK_METHOD(Status, handleDataCommon, (DData&, const GenericPointerKeeperT&, BinVectorT&), (override));
+    MOCK_METHOD(const csp::Interface&, getInputInterface, (), (const, noexcept, override));
+    MOCK_METHOD(const csp::messaging::HandlerMetrics&, getMetrics, (), (const, noexcept, override));
+    MOCK_METHOD(Status, checkSharedInputPolicies, (const DData&, const GenericPointerKeeperT&), (override));
+    MOCK_METHOD(Status, deserializeSharedInput, (DData&, GenericPointerKeeperT&, BinVectorT&), (override));
+    MOCK_METHOD(Status, handleSharedInput, (const GenericPointerKeeperT&, DData&, const GenericPointerKeeperT&, BinVectorT&), (override));
 };
 
 class ServerTests : public ::testing::Test
@@ -187,6 +193,26 @@ TEST_F(ServerTests, HandleMessageGetSettings)
     EXPECT_EQ(receivedSettings, m_server.getSettings());
 }
 
+TEST_F(ServerTests, HandleMessageGetSettingsAllProtocolVersions)
+{
+    init(getValidCspPartySettings());
+
+    for (protocol_version_t protocolVersion : m_server.getSettings().getProtocolVersions())
+    {
+        BinWalkerT binInput;
+        SCommon ctxIn(binInput.getVector(), protocolVersion, context::Message::GetSettings, {});
+        processing::common::ContextProcessor::serialize(ctxIn);
+        BinVectorT binOutput;
+
+        EXPECT_EQ(m_server.handleMessage(binInput, m_clientId, binOutput), Status::NoError);
+
+        BinVectorT binExpected;
+        context::SData ctxExpected(binExpected, protocolVersion, m_server.getSettings().getMandatoryCommonFlags(), {}, true, protocolVersion);
+        EXPECT_EQ(m_server.getSettings().serialize(ctxExpected), Status::NoError);
+        EXPECT_EQ(binOutput, binExpected);
+    }
+}
+
 TEST_F(ServerTests, HandleMessageNotSupportedOne)
 {
     init(getValidCspPartySettings());
@@ -203,4 +229,62 @@ TEST_F(ServerTests, HandleMessageNotSupportedOne)
     EXPECT_EQ(statusOut, Status::ErrorDataCorrupted);
 }
 
+TEST_F(ServerTests, HandleMessageBatchNotProcessedAsWhole)
+{
+    init(getValidCspPartySettings());
+    BinWalkerT binInput;
+    SCommon ctxIn(binInput.getVector(), m_server.getSettings().getLatestProtocolVersion(), context::Message::Batch, m_server.getSettings().getMandatoryCommonFlags());
+    EXPECT_EQ(processing::common::ContextProcessor::serialize(ctxIn), Status::NoError);
+
+    // Only Data items are allowed in Batch
+    csp_size_t sizeOffset = 0;
+    EXPECT_EQ(processing::batch::ContextProcessor::serializeItemBegin(ctxIn, context::Message::Status, sizeOffset), Status::NoError);
+    EXPECT_EQ(processing::batch::ContextProcessor::serializeItemEnd(ctxIn, sizeOffset), Status::NoError);
+
+    BinWalkerT binOutput;
+
+    EXPECT_EQ(m_server.handleMessage(binInput, m_clientId, binOutput.getVector()), Status::ErrorDataCorrupted);
+
+    // Server must send Status message instead of partial Batch
+    DData ctxOut(binOutput);
+    EXPECT_EQ(processing::common::ContextProcessor::deserialize(ctxOut), Status::NoError);
+    EXPECT_EQ(ctxOut.getMessageType(), Message::Status);
+
+    Status statusOut{ Status::NoError };
+    EXPECT_EQ(processing::status::ContextProcessor::deserialize(ctxOut, statusOut), Status::NoError);
+    EXPECT_EQ(statusOut, Status::ErrorDataCorrupted);
+}
+
+TEST(ThreadLocalLeaseTests, ReuseAndNestedLease)
+{
+    VectorT<int>* pLeased{ nullptr };
+    const int* pData{ nullptr };
+
+    {
+        ThreadLocalLease<VectorT<int>> lease;
+        pLeased = &lease.get();
+        EXPECT_EQ(pLeased, &lease.get());
+        EXPECT_EQ(pLeased->pushBack(1), Status::NoError);
+        pData = pLeased->data();
+
+        // Nested lease on the same thread gets its own container
+        {
+            ThreadLocalLease<VectorT<int>> nestedLease;
+            VectorT<int>& nested = nestedLease.get();
+            EXPECT_NE(&nested, pLeased);
+            EXPECT_EQ(nested.size(), 0);
+            EXPECT_EQ(nested.pushBack(2), Status::NoError);
+        }
+
+        EXPECT_EQ(pLeased->size(), 1);
+        EXPECT_EQ((*pLeased)[0], 1);
+    }
+
+    // Next lease gets the same container cleared but with storage kept
+    ThreadLocalLease<VectorT<int>> lease;
+    EXPECT_EQ(&lease.get(), pLeased);
+    EXPECT_EQ(lease.get().size(), 0);
+    EXPECT_EQ(lease.get().data(), pData);
+}
+
 } // namespace
@@ -0,0 +1,286 @@
+/**
+ * @file common_serializaiton/csp_messaging/unit_tests/TransportTests.cpp
+ * @author Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * Copyright 2023-2024 Andrey Grabov-Smetankin <ukbpyh@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+ * THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <thread>
+#include <gtest/gtest.h>
+#include <common_serialization/csp_messaging/transport/Framing.h>
+#include <common_serialization/csp_messaging/transport/SharedMemoryRing.h>
+
+namespace
+{
+
+using namespace common_serialization;
+using namespace csp::messaging;
+
+TEST(TransportTests, SharedMemoryRingWrapAround)
+{
+    constexpr uint32_t kCapacity = 256;
+    constexpr uint32_t kMessagesCount = 2000;
+
+    alignas(64) uint8_t memory[transport::SharedMemoryRing::getRequiredMemorySize(kCapacity)];
+
+    transport::SharedMemoryRing producer;
+    ASSERT_EQ(producer.create(memory, kCapacity), Status::NoError);
+
+    transport::SharedMemoryRing consumer;
+    ASSERT_EQ(consumer.attach(memory, sizeof(memory)), Status::NoError);
+
+    // Message with its size prefix must fit in ring
+    uint8_t tooBig[kCapacity]{};
+    EXPECT_EQ(producer.push(tooBig, kCapacity), Status::ErrorOverflow);
+
+    std::thread producerThread([&producer]
+        {
+            uint8_t buffer[kCapacity]{};
+
+            for (uint32_t i = 0; i < kMessagesCount; ++i)
+            {
+                // Sizes are not multiples of capacity, so messages are often split by ring end
+                const uint32_t size = (i * 37) % (kCapacity - sizeof(uint32_t));
+                for (uint32_t j = 0; j < size; ++j)
+                    buffer[j] = static_cast<uint8_t>(i + j);
+
+                EXPECT_EQ(producer.push(buffer, size), Status::NoError);
+            }
+
+            producer.close();
+        });
+
+    BinVectorT output;
+
+    for (uint32_t i = 0; i < kMessagesCount; ++i)
+    {
+        ASSERT_EQ(consumer.pop(output), Status::NoError);
+
+        const uint32_t size = (i * 37) % (kCapacity - sizeof(uint32_t));
+        ASSERT_EQ(output.size(), size);
+
+        for (uint32_t j = 0; j < size; ++j)
+            ASSERT_EQ(output[j], static_cast<uint8_t>(i + j));
+    }
+
+    EXPECT_EQ(consumer.pop(output), Status::ErrorNotAvailible);
+
+    producerThread.join();
+}
+
+TEST(TransportTests, SharedMemoryRingAttachCorrupted)
+{
+    constexpr uint32_t kCapacity = 256;
+
+    alignas(64) uint8_t memory[transport::SharedMemoryRing::getRequiredMemorySize(kCapacity)];
+
+    transport::SharedMemoryRing producer;
+    ASSERT_EQ(producer.create(memory, kCapacity), Status::NoError);
+
+    // Capacity is written by other side right after magic, and it must be power of two that can hold message size
+    for (uint32_t capacity : { kCapacity - 1, uint32_t(2), uint32_t(0), kCapacity * 2 })
+    {
+        memcpy(memory + sizeof(uint32_t), &capacity, sizeof(capacity));
+
+        transport::SharedMemoryRing consumer;
+        EXPECT_EQ(consumer.attach(memory, sizeof(memory)), Status::ErrorDataCorrupted);
+        EXPECT_FALSE(consumer.isValid());
+    }
+}
+
+TEST(TransportTests, SharedMemoryRingPopCorrupted)
+{
+    constexpr uint32_t kCapacity = 256;
+    constexpr size_t kDataOffset = transport::SharedMemoryRing::getRequiredMemorySize(kCapacity) - kCapacity;
+    // Write position starts the second cache line of header
+    constexpr size_t kWritePositionOffset = 64;
+
+    alignas(64) uint8_t memory[transport::SharedMemoryRing::getRequiredMemorySize(kCapacity)];
+
+    const uint8_t message[16]{};
+    BinVectorT output;
+
+    // Message size that goes beyond written data
+    {
+        transport::SharedMemoryRing producer;
+        ASSERT_EQ(producer.create(memory, kCapacity), Status::NoError);
+        ASSERT_EQ(producer.push(message, sizeof(message)), Status::NoError);
+
+        const uint32_t size = sizeof(message) + 1;
+        memcpy(memory + kDataOffset, &size, sizeof(size));
+
+        transport::SharedMemoryRing consumer;
+        ASSERT_EQ(consumer.attach(memory, sizeof(memory)), Status::NoError);
+        EXPECT_EQ(consumer.pop(output), Status::ErrorDataCorrupted);
+    }
+
+    // Write position and message size that go beyond capacity
+    for (uint64_t writePosition : { uint64_t(kCapacity + 1), uint64_t(4) * kCapacity, ~uint64_t(0) })
+    {
+        transport::SharedMemoryRing producer;
+        ASSERT_EQ(producer.create(memory, kCapacity), Status::NoError);
+        ASSERT_EQ(producer.push(message, sizeof(message)), Status::NoError);
+
+        const uint32_t size = 2 * kCapacity;
+        memcpy(memory + kDataOffset, &size, sizeof(size));
+        memcpy(memory + kWritePositionOffset, &writePosition, sizeof(writePosition));
+
+        transport::SharedMemoryRing consumer;
+        ASSERT_EQ(consumer.attach(memory, sizeof(memory)), Status::NoError);
+        EXPECT_EQ(consumer.pop(output), Status::ErrorDataCorrupted);
+        EXPECT_EQ(output.size(), 0);
+    }
+}
+
+Status appendFrame(const BinVectorT& message, bool withChecksum, BinVectorT& stream)
+{
+    uint8_t header[transport::Framing::kMaxHeaderSize]{};
+    size_t headerSize = 0;
+
+    AGS_CS_RUN(transport::Framing::makeHeader(message.data(), message.size(), withChecksum, header, headerSize));
+    AGS_CS_RUN(stream.pushBackN(header, headerSize));
+
+    return stream.pushBackN(message.data(), message.size());
+}
+
+TEST(TransportTests, Crc32c)
+{
+    constexpr uint8_t kData[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    static_assert(transport::Framing::crc32c(kData, sizeof(kData)) == 0xe3069283);
+}
+
+TEST(TransportTests, FrameReader)
+{
+    constexpr size_t kMessagesCount = 50;
+
+    BinVectorT stream;
+
+    for (size_t i = 0; i < kMessagesCount; ++i)
+    {
+        BinVectorT message;
+        for (size_t j = 0; j < i * 7; ++j)
+            EXPECT_EQ(message.pushBack(static_cast<uint8_t>(i + j)), Status::NoError);
+
+        EXPECT_EQ(appendFrame(message, i % 2 == 0, stream), Status::NoError);
+    }
+
+    // The same stream is fed at once, byte by byte and by uneven chunks
+    for (size_t chunkSize : { stream.size(), size_t(1), size_t(13) })
+    {
+        transport::FrameReader reader;
+        size_t messagesCount = 0;
+
+        for (size_t offset = 0; offset < stream.size(); offset += chunkSize)
+        {
+            uint8_t* p = nullptr;
+            size_t size = 0;
+            const size_t received = std::min(chunkSize, stream.size() - offset);
+
+            ASSERT_EQ(reader.getFreeSpace(chunkSize, p, size), Status::NoError);
+            ASSERT_GE(size, received);
+            memcpy(p, stream.data() + offset, received);
+            ASSERT_EQ(reader.commitFreeSpace(received), Status::NoError);
+
+            BinWalkerT* pMessage = nullptr;
+
+            while (statusSuccess(reader.getNextMessage(pMessage)) && pMessage)
+            {
+                EXPECT_EQ(pMessage->size() - pMessage->tell(), messagesCount * 7);
+                EXPECT_EQ(reader.isLastMessageWithChecksum(), messagesCount % 2 == 0);
+
+                for (size_t j = 0; j < messagesCount * 7; ++j)
+                    EXPECT_EQ(pMessage->data()[pMessage->tell() + j], static_cast<uint8_t>(messagesCount + j));
+
+                ++messagesCount;
+            }
+        }
+
+        EXPECT_EQ(messagesCount, kMessagesCount);
+        EXPECT_EQ(reader.getPendingSize(), 0);
+    }
+}
+
+TEST(TransportTests, FrameReaderAppendWithoutDraining)
+{
+    constexpr size_t kMessagesCount = 3;
+
+    BinVectorT stream;
+
+    for (size_t i = 0; i < kMessagesCount; ++i)
+    {
+        BinVectorT message;
+        for (size_t j = 0; j < 100 * (i + 1); ++j)
+            EXPECT_EQ(message.pushBack(static_cast<uint8_t>(i + j)), Status::NoError);
+
+        EXPECT_EQ(appendFrame(message, i % 2 == 0, stream), Status::NoError);
+    }
+
+    // First append holds complete first message and part of the second one,
+    // and nothing is read from reader before the rest is appended
+    const size_t firstPartSize = transport::Framing::kMaxHeaderSize + 100 + transport::Framing::kMinHeaderSize + 50;
+
+    transport::FrameReader reader;
+    ASSERT_EQ(reader.append(stream.data(), firstPartSize), Status::NoError);
+    ASSERT_EQ(reader.append(stream.data() + firstPartSize, stream.size() - firstPartSize), Status::NoError);
+    EXPECT_EQ(reader.getPendingSize(), stream.size());
+
+    BinWalkerT* pMessage = nullptr;
+    size_t messagesCount = 0;
+
+    while (statusSuccess(reader.getNextMessage(pMessage)) && pMessage)
+    {
+        ASSERT_EQ(pMessage->size() - pMessage->tell(), 100 * (messagesCount + 1));
+
+        for (size_t j = 0; j < 100 * (messagesCount + 1); ++j)
+            EXPECT_EQ(pMessage->data()[pMessage->tell() + j], static_cast<uint8_t>(messagesCount + j));
+
+        ++messagesCount;
+    }
+
+    EXPECT_EQ(messagesCount, kMessagesCount);
+    EXPECT_EQ(reader.getPendingSize(), 0);
+}
+
+TEST(TransportTests, FrameReaderErrors)
+{
+    BinVectorT message;
+    EXPECT_EQ(message.pushBackN(reinterpret_cast<const uint8_t*>("message"), 7), Status::NoError);
+
+    BinVectorT stream;
+    EXPECT_EQ(appendFrame(message, true, stream), Status::NoError);
+    stream[stream.size() - 1] ^= 1;
+
+    transport::FrameReader reader;
+    BinWalkerT* pMessage = nullptr;
+
+    EXPECT_EQ(reader.append(stream.data(), stream.size()), Status::NoError);
+    EXPECT_EQ(reader.getNextMessage(pMessage), Status::ErrorDataCorrupted);
+    EXPECT_EQ(pMessage, nullptr);
+
+    stream.clear();
+    EXPECT_EQ(appendFrame(message, false, stream), Status::NoError);
+
+    transport::FrameReader smallReader(static_cast<uint32_t>(message.size() - 1));
+
+    EXPECT_EQ(smallReader.append(stream.data(), stream.size()), Status::NoError);
+    EXPECT_EQ(smallReader.getNextMessage(pMessage), Status::ErrorOverflow);
+}
+
+} // namespace
@@ -120,6 +120,18 @@ CspPartySettings<> getMandatoryAndForbiddenCommonFlagsCspPartySettings()
     return settings;
 }
 
+CspPartySettings<> getMandatoryCorrelationIdCspPartySettings()
+{
+    CspPartySettings settings = getValidCspPartySettings();
+    settings.init(
+          settings.getProtocolVersions()
+        , CommonFlags{ CommonFlags::kCorrelationId }
+        , {}
+        , settings.getInterfaces());
+
+    return settings;
+}
+
 CspPartySettings<> getInterfaceVersionZeroCspPartySettings()
 {
     RawVectorT<protocol_version_t> protocolVersions;
@@ -23,10 +23,20 @@
 
 #pragma once
 
+#include <cstring>
+#include <iterator>
 #include <string>
 #include <vector>
+#include <array>
+#include <span>
+#include <deque>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <tuple>
+#include <optional>
+#include <variant>
 #include <common_serialization/csp_base/processing/data/BodyProcessor.h>
 #include <common_serialization/csp_base/processing/data/TemplateProcessor.h>
 
@@ -54,8 +64,60 @@ public:
         value.clear();
         size_type size = 0;
         AGS_CS_RUN(BodyProcessor::deserializeSizeT(ctx, size));
-        value.resize(size);
+
+        // Size comes from input, so it is checked before any allocation.
+        // Every character and null-terminator take at least one byte.
+        BinWalkerT& binInput = ctx.getBinaryData();
+        const size_t restSize = binInput.size() - binInput.tell();
+
+        if (size >= restSize)
+            return Status::ErrorOverflow;
+
+        // Characters of variable size may be prepended by size of integer, so they are copied as is
+        // only when they are known to have the same size on both sides
+        if (BodyProcessor::isRawDataProcessingApplicable<T>(ctx) && (FixSizedArithmeticOrEnumType<T> || !ctx.sizeOfIntegersMayBeNotEqual()))
+        {
+            if (size + 1 > restSize / sizeof(T))
+                return Status::ErrorOverflow;
+
+            const uint8_t* pBegin = binInput.data() + binInput.tell();
+
+            // Aligned characters (and one byte characters are always aligned) are copied directly
+            // from input into allocated storage of string, which is not value-initialized before.
+            // Serialized null-terminator is skipped, string keeps its own one.
+            if (reinterpret_cast<uintptr_t>(pBegin) % alignof(T) == 0)
+            {
+                value.assign(static_cast<const T*>(static_cast<const void*>(pBegin)), size);
+                return binInput.seek(binInput.tell() + (size + 1) * sizeof(T));
+            }
+
+#ifdef __cpp_lib_string_resize_and_overwrite
+            // Characters are written directly to uninitialized storage of string
+            Status status = Status::NoError;
+            value.resize_and_overwrite(size, [&ctx, &status, size](T* p, size_type)
+                {
+                    // Second argument is not used because some library versions pass a wrong value there
+                    status = readRawData(ctx, size, p);
+                    return statusSuccess(status) ? size : 0;
+                });
+
+            if (!statusSuccess(status))
+                return status;
+#else // __cpp_lib_string_resize_and_overwrite
+            // Before C++23 unaligned characters can't be read into string without its initialization
+            value.resize(size);
+            AGS_CS_RUN(readRawData(ctx, size, value.data()));
+#endif // __cpp_lib_string_resize_and_overwrite
+
+            // Serialized null-terminator is skipped, string keeps its own one
+            T terminator{};
+            return readRawData(ctx, 1, &terminator);
+        }
+
+        // Null-terminator is deserialized as regular character and then removed
+        value.resize(size + 1);
         AGS_CS_RUN(BodyProcessor::deserialize(ctx, size + 1, value.data()));
+        value.pop_back();
 
         return Status::NoError;
     }
@@ -79,16 +141,239 @@ public:
 
         assert(sizeof(size_type) <= sizeof(size_t));
 
-        value.clear();
         size_type size = 0;
         AGS_CS_RUN(BodyProcessor::deserializeSizeT(ctx, size));
-        value.resize(size);
-        AGS_CS_RUN(BodyProcessor::deserialize(ctx, size, value.data()));
+
+        // Size comes from input, so it is checked before any allocation
+        BinWalkerT& binInput = ctx.getBinaryData();
+        const size_t restSize = binInput.size() - binInput.tell();
+
+        if (BodyProcessor::isRawDataProcessingApplicable<T>(ctx))
+        {
+            // Every element takes sizeof(T) bytes, or at least one byte when it is prepended by size of integer
+            if (size > (isPrependedBySizeOfInteger(ctx) ? restSize : restSize / sizeof(T)))
+                return Status::ErrorOverflow;
+
+            value.clear();
+            value.reserve(size);
+
+            if constexpr (std::is_trivially_copyable_v<T>)
+                if (!isPrependedBySizeOfInteger(ctx))
+                    return deserializeRawData(ctx, size, value);
+
+            value.resize(size);
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, size, value.data()));
+        }
+        else
+        {
+            // In reuse mode only trailing elements are destroyed
+            // and the rest of them are deserialized in place keeping their own storage
+            if (!ctx.isExistingElementsReused())
+                value.clear();
+            else if (value.size() > size)
+                value.erase(value.begin() + size, value.end());
+
+            // Elements of empty types take no bytes, so size itself can't be checked,
+            // but there is no point in reserving more elements than input bytes
+            value.reserve(std::min<size_t>(size, restSize));
+
+            size_type reused = value.size();
+            AGS_CS_RUN(BodyProcessor::deserializeInPlace(ctx, reused, value.data()));
+
+            // Every new element is constructed only once and then deserialized in place
+            for (size_type i = reused; i < size; ++i)
+            {
+                T& item = value.emplace_back();
+
+                if (ctx.checkRecursivePointers())
+                    (*ctx.getPointersMap())[ctx.getBinaryData().tell()] = &item;
+
+                AGS_CS_RUN(BodyProcessor::deserialize(ctx, item));
+            }
+        }
+
+        return Status::NoError;
+    }
+
+private:
+    static constexpr bool isPrependedBySizeOfInteger(const context::DData& ctx) noexcept
+    {
+        if constexpr ((std::is_integral_v<T> || std::is_enum_v<T>) && !FixSizedArithmeticOrEnumType<T>)
+            return ctx.sizeOfIntegersMayBeNotEqual();
+        else
+            return false;
+    }
+
+    /// @brief Iterator that reads elements from not aligned binary data
+    class RawDataIterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = T;
+
+        explicit RawDataIterator(const uint8_t* p) noexcept : m_p(p) { }
+
+        T operator*() const noexcept
+        {
+            T value;
+            memcpy(&value, m_p, sizeof(T));
+            return value;
+        }
+
+        T operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        RawDataIterator& operator++() noexcept { m_p += sizeof(T); return *this; }
+        RawDataIterator operator++(int) noexcept { RawDataIterator it(*this); ++*this; return it; }
+        RawDataIterator& operator--() noexcept { m_p -= sizeof(T); return *this; }
+        RawDataIterator operator--(int) noexcept { RawDataIterator it(*this); --*this; return it; }
+        RawDataIterator& operator+=(difference_type n) noexcept { m_p += n * static_cast<difference_type>(sizeof(T)); return *this; }
+        RawDataIterator& operator-=(difference_type n) noexcept { return *this += -n; }
+        RawDataIterator operator+(difference_type n) const noexcept { return RawDataIterator(*this) += n; }
+        RawDataIterator operator-(difference_type n) const noexcept { return RawDataIterator(*this) -= n; }
+        difference_type operator-(const RawDataIterator& rhs) const noexcept { return (m_p - rhs.m_p) / static_cast<difference_type>(sizeof(T)); }
+
+        bool operator==(const RawDataIterator& rhs) const noexcept { return m_p == rhs.m_p; }
+        auto operator<=>(const RawDataIterator& rhs) const noexcept { return m_p <=> rhs.m_p; }
+
+    private:
+        const uint8_t* m_p{ nullptr };
+    };
+
+    /// @brief Appends elements to vector directly from binary data.
+    ///     In contrast to resize() followed by overwrite
+    ///     the memory of vector is touched only once.
+    static Status deserializeRawData(context::DData& ctx, size_t size, std::vector<T, Allocator>& value)
+    {
+        BinWalkerT& binInput = ctx.getBinaryData();
+        const size_t offset = binInput.tell();
+
+        if (size > (binInput.size() - offset) / sizeof(T))
+            return Status::ErrorOverflow;
+
+        const uint8_t* pBegin = binInput.data() + offset;
+        const size_t bytesSize = size * sizeof(T);
+
+        // Aligned data is copied as one block, otherwise element by element
+        if (reinterpret_cast<uintptr_t>(pBegin) % alignof(T) == 0)
+        {
+            const T* pData = static_cast<const T*>(static_cast<const void*>(pBegin));
+            value.insert(value.end(), pData, pData + size);
+        }
+        else
+            value.insert(value.end(), RawDataIterator(pBegin), RawDataIterator(pBegin + bytesSize));
+
+        return binInput.seek(offset + bytesSize);
+    }
+};
+
+template<typename T, size_t N>
+class TemplateProcessor<std::array<T, N>, T>
+{
+public:
+    static Status serialize(const std::array<T, N>& value, context::SData& ctx)
+    {
+        // Same as for C arrays, size is not serialized because it is a part of the type.
+        // When T is allowed to be copied as is, whole array is written by one operation.
+        return BodyProcessor::serialize(value.data(), N, ctx);
+    }
+
+    static Status deserialize(context::DData& ctx, std::array<T, N>& value)
+    {
+        // Elements are already alive, so we must not construct them again over existing objects
+        return BodyProcessor::deserializeInPlace(ctx, N, value.data());
+    }
+};
+
+template<typename T, size_t Extent>
+class TemplateProcessor<std::span<T, Extent>, T>
+{
+public:
+    static Status serialize(const std::span<T, Extent>& value, context::SData& ctx)
+    {
+        AGS_CS_RUN(BodyProcessor::serializeSizeT(value.size(), ctx));
+        AGS_CS_RUN(BodyProcessor::serialize(value.data(), value.size(), ctx));
+
+        return Status::NoError;
+    }
+
+    /// @brief Deserializes data into memory viewed by span
+    /// @note Span is not owning its memory, so it must view exactly
+    ///     as many elements as were serialized.
+    ///     Viewed elements must be alive, they are deserialized in place.
+    static Status deserialize(context::DData& ctx, std::span<T, Extent>& value)
+    {
+        using size_type = typename std::span<T, Extent>::size_type;
+
+        size_type size = 0;
+        AGS_CS_RUN(BodyProcessor::deserializeSizeT(ctx, size));
+        if (size != value.size())
+            return Status::ErrorOverflow;
+
+        // Elements are already alive, so we must not construct them again over existing objects
+        AGS_CS_RUN(BodyProcessor::deserializeInPlace(ctx, size, value.data()));
 
         return Status::NoError;
     }
 };
 
+template<typename T, typename Allocator>
+class TemplateProcessor<std::deque<T, Allocator>, T, Allocator>
+{
+public:
+    static Status serialize(const std::deque<T, Allocator>& value, context::SData& ctx)
+    {
+        AGS_CS_RUN(BodyProcessor::serializeSizeT(value.size(), ctx));
+
+        // Elements of deque are not stored contiguously, so they are processed one by one
+        // and registered for recursive pointers the same way as elements of std::vector
+        for (auto& item : value)
+        {
+            if (ctx.checkRecursivePointers())
+                (*ctx.getPointersMap())[&item] = ctx.getBinaryData().size();
+
+            AGS_CS_RUN(BodyProcessor::serialize(item, ctx));
+        }
+
+        return Status::NoError;
+    }
+
+    static Status deserialize(context::DData& ctx, std::deque<T, Allocator>& value)
+    {
+        using size_type = typename std::deque<T, Allocator>::size_type;
+
+        assert(sizeof(size_type) <= sizeof(size_t));
+
+        size_type size = 0;
+        AGS_CS_RUN(BodyProcessor::deserializeSizeT(ctx, size));
+
+        // In reuse mode only trailing elements are destroyed, see std::vector processor
+        if (!ctx.isExistingElementsReused())
+            value.clear();
+        else if (value.size() > size)
+            value.erase(value.begin() + size, value.end());
+
+        for (auto& item : value)
+            AGS_CS_RUN(deserializeItem(ctx, item));
+
+        for (size_type i = value.size(); i < size; ++i)
+            AGS_CS_RUN(deserializeItem(ctx, value.emplace_back()));
+
+        return Status::NoError;
+    }
+
+private:
+    static Status deserializeItem(context::DData& ctx, T& item)
+    {
+        if (ctx.checkRecursivePointers())
+            (*ctx.getPointersMap())[ctx.getBinaryData().tell()] = &item;
+
+        return BodyProcessor::deserialize(ctx, item);
+    }
+};
+
 template<typename T1, typename T2>
 class TemplateProcessor<std::pair<T1, T2>, T1, T2>
 {
@@ -130,15 +415,238 @@ public:
 
         assert(sizeof(size_type) <= sizeof(size_t));
 
-        value.clear();
         size_type size = 0;
         AGS_CS_RUN(BodyProcessor::deserializeSizeT(ctx, size));
 
-        for (size_type i = 0; i < size; ++i)
+        size_t processed = 0;
+        if (ctx.isExistingElementsReused())
+        {
+            AGS_CS_RUN(deserializeIntoRecycledNodes(ctx, size, value, processed));
+        }
+        else
+            value.clear();
+
+        // Elements were serialized in ascending order of keys, so every next one
+        // belongs right before end() and hinted insertion takes amortized constant time.
+        // Mapped value is constructed in place and deserialized directly into the node.
+        for (size_type i = processed; i < size; ++i)
         {
-            std::pair<K, V> element;
-            AGS_CS_RUN(BodyProcessor::deserialize(ctx, element));
-            value.insert(std::move(element));
+            K key{};
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, key));
+            auto it = value.emplace_hint(value.end(), std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple());
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, it->second));
+        }
+
+        return Status::NoError;
+    }
+
+private:
+    /// @brief Deserializes elements into nodes extracted from existing ones,
+    ///     so keys and mapped values keep storage that they own
+    /// @param processed Number of elements that were deserialized
+    static Status deserializeIntoRecycledNodes(context::DData& ctx, size_t size, std::map<K, V, Compare, Allocator>& value, size_t& processed)
+    {
+        std::map<K, V, Compare, Allocator> recycled(value.key_comp(), value.get_allocator());
+        recycled.swap(value);
+
+        for (processed = 0; processed < size && !recycled.empty(); ++processed)
+        {
+            auto node = recycled.extract(recycled.begin());
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, node.key()));
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, node.mapped()));
+            value.insert(value.end(), std::move(node));
+        }
+
+        return Status::NoError;
+    }
+};
+
+template<typename K, class Compare, class Allocator>
+class TemplateProcessor<std::set<K, Compare, Allocator>, K, Compare, Allocator>
+{
+public:
+    static Status serialize(const std::set<K, Compare, Allocator>& value, context::SData& ctx)
+    {
+        AGS_CS_RUN(BodyProcessor::serializeSizeT(value.size(), ctx));
+
+        for (auto& key : value)
+            AGS_CS_RUN(BodyProcessor::serialize(key, ctx));
+
+        return Status::NoError;
+    }
+
+    static Status deserialize(context::DData& ctx, std::set<K, Compare, Allocator>& value)
+    {
+        using size_type = std::set<K, Compare, Allocator>::size_type;
+
+        assert(sizeof(size_type) <= sizeof(size_t));
+
+        size_type size = 0;
+        AGS_CS_RUN(BodyProcessor::deserializeSizeT(ctx, size));
+
+        size_t processed = 0;
+        if (ctx.isExistingElementsReused())
+        {
+            AGS_CS_RUN(deserializeIntoRecycledNodes(ctx, size, value, processed));
+        }
+        else
+            value.clear();
+
+        // Keys were serialized in ascending order, see std::map processor
+        for (size_type i = processed; i < size; ++i)
+        {
+            K key{};
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, key));
+            value.emplace_hint(value.end(), std::move(key));
+        }
+
+        return Status::NoError;
+    }
+
+private:
+    /// @brief Deserializes keys into nodes extracted from existing ones, see std::map processor
+    static Status deserializeIntoRecycledNodes(context::DData& ctx, size_t size, std::set<K, Compare, Allocator>& value, size_t& processed)
+    {
+        std::set<K, Compare, Allocator> recycled(value.key_comp(), value.get_allocator());
+        recycled.swap(value);
+
+        for (processed = 0; processed < size && !recycled.empty(); ++processed)
+        {
+            auto node = recycled.extract(recycled.begin());
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, node.value()));
+            value.insert(value.end(), std::move(node));
+        }
+
+        return Status::NoError;
+    }
+};
+
+template<typename K, typename V, class Hash, class KeyEqual, class Allocator>
+class TemplateProcessor<std::unordered_map<K, V, Hash, KeyEqual, Allocator>, K, V, Hash, KeyEqual, Allocator>
+{
+public:
+    static Status serialize(const std::unordered_map<K, V, Hash, KeyEqual, Allocator>& value, context::SData& ctx)
+    {
+        AGS_CS_RUN(BodyProcessor::serializeSizeT(value.size(), ctx));
+
+        for (auto& pair : value)
+            AGS_CS_RUN(BodyProcessor::serialize(pair, ctx));
+
+        return Status::NoError;
+    }
+
+    static Status deserialize(context::DData& ctx, std::unordered_map<K, V, Hash, KeyEqual, Allocator>& value)
+    {
+        using size_type = std::unordered_map<K, V, Hash, KeyEqual, Allocator>::size_type;
+
+        assert(sizeof(size_type) <= sizeof(size_t));
+
+        size_type size = 0;
+        AGS_CS_RUN(BodyProcessor::deserializeSizeT(ctx, size));
+
+        size_t processed = 0;
+        if (ctx.isExistingElementsReused())
+        {
+            AGS_CS_RUN(deserializeIntoRecycledNodes(ctx, size, value, processed));
+        }
+        else
+        {
+            value.clear();
+
+            // Allocate all buckets at once to avoid rehashing during insertion
+            value.reserve(size);
+        }
+
+        for (size_type i = processed; i < size; ++i)
+        {
+            K key{};
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, key));
+            auto it = value.try_emplace(std::move(key)).first;
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, it->second));
+        }
+
+        return Status::NoError;
+    }
+
+private:
+    /// @brief Deserializes elements into nodes extracted from existing ones, see std::map processor
+    static Status deserializeIntoRecycledNodes(context::DData& ctx, size_t size, std::unordered_map<K, V, Hash, KeyEqual, Allocator>& value, size_t& processed)
+    {
+        std::unordered_map<K, V, Hash, KeyEqual, Allocator> recycled(0, value.hash_function(), value.key_eq(), value.get_allocator());
+        recycled.swap(value);
+        value.reserve(size);
+
+        for (processed = 0; processed < size && !recycled.empty(); ++processed)
+        {
+            auto node = recycled.extract(recycled.begin());
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, node.key()));
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, node.mapped()));
+            value.insert(std::move(node));
+        }
+
+        return Status::NoError;
+    }
+};
+
+template<typename K, class Hash, class KeyEqual, class Allocator>
+class TemplateProcessor<std::unordered_set<K, Hash, KeyEqual, Allocator>, K, Hash, KeyEqual, Allocator>
+{
+public:
+    static Status serialize(const std::unordered_set<K, Hash, KeyEqual, Allocator>& value, context::SData& ctx)
+    {
+        AGS_CS_RUN(BodyProcessor::serializeSizeT(value.size(), ctx));
+
+        for (auto& key : value)
+            AGS_CS_RUN(BodyProcessor::serialize(key, ctx));
+
+        return Status::NoError;
+    }
+
+    static Status deserialize(context::DData& ctx, std::unordered_set<K, Hash, KeyEqual, Allocator>& value)
+    {
+        using size_type = std::unordered_set<K, Hash, KeyEqual, Allocator>::size_type;
+
+        assert(sizeof(size_type) <= sizeof(size_t));
+
+        size_type size = 0;
+        AGS_CS_RUN(BodyProcessor::deserializeSizeT(ctx, size));
+
+        size_t processed = 0;
+        if (ctx.isExistingElementsReused())
+        {
+            AGS_CS_RUN(deserializeIntoRecycledNodes(ctx, size, value, processed));
+        }
+        else
+        {
+            value.clear();
+
+            // Allocate all buckets at once to avoid rehashing during insertion
+            value.reserve(size);
+        }
+
+        for (size_type i = processed; i < size; ++i)
+        {
+            K key{};
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, key));
+            value.emplace(std::move(key));
+        }
+
+        return Status::NoError;
+    }
+
+private:
+    /// @brief Deserializes keys into nodes extracted from existing ones, see std::map processor
+    static Status deserializeIntoRecycledNodes(context::DData& ctx, size_t size, std::unordered_set<K, Hash, KeyEqual, Allocator>& value, size_t& processed)
+    {
+        std::unordered_set<K, Hash, KeyEqual, Allocator> recycled(0, value.hash_function(), value.key_eq(), value.get_allocator());
+        recycled.swap(value);
+        value.reserve(size);
+
+        for (processed = 0; processed < size && !recycled.empty(); ++processed)
+        {
+            auto node = recycled.extract(recycled.begin());
+            AGS_CS_RUN(BodyProcessor::deserialize(ctx, node.value()));
+            value.insert(std::move(node));
         }
 
         return Status::NoError;
@@ -188,4 +696,98 @@ public:
     }
 };
 
+template<typename T>
+class TemplateProcessor<std::optional<T>, T>
+{
+public:
+    static Status serialize(const std::optional<T>& value, context::SData& ctx)
+    {
+        if (!value.has_value())
+            return writePrimitive(uint8_t(0), ctx);
+
+        AGS_CS_RUN(writePrimitive(uint8_t(1), ctx));
+        AGS_CS_RUN(BodyProcessor::serialize(*value, ctx));
+
+        return Status::NoError;
+    }
+
+    static Status deserialize(context::DData& ctx, std::optional<T>& value)
+    {
+        uint8_t hasValue = 0;
+        AGS_CS_RUN(readPrimitive(ctx, hasValue));
+
+        if (!hasValue)
+        {
+            value.reset();
+            return Status::NoError;
+        }
+
+        // If optional already holds a value we are reusing it
+        if (!value.has_value())
+            value.emplace();
+
+        AGS_CS_RUN(BodyProcessor::deserialize(ctx, *value));
+
+        return Status::NoError;
+    }
+};
+
+template<typename... Ts>
+class TemplateProcessor<std::variant<Ts...>, Ts...>
+{
+public:
+    static Status serialize(const std::variant<Ts...>& value, context::SData& ctx)
+    {
+        if (value.valueless_by_exception())
+            return Status::ErrorInvalidArgument;
+
+        AGS_CS_RUN(BodyProcessor::serializeSizeT(value.index(), ctx));
+
+        return std::visit([&ctx](const auto& alternative) -> Status
+            {
+                if constexpr (std::is_same_v<normalize_t<decltype(alternative)>, std::monostate>)
+                    return Status::NoError;
+                else
+                    return BodyProcessor::serialize(alternative, ctx);
+            }
+            , value);
+    }
+
+    static Status deserialize(context::DData& ctx, std::variant<Ts...>& value)
+    {
+        size_t index = 0;
+        AGS_CS_RUN(BodyProcessor::deserializeSizeT(ctx, index));
+
+        if (index >= sizeof...(Ts))
+            return Status::ErrorDataCorrupted;
+
+        return deserializeVariantHelper(ctx, index, std::make_index_sequence<sizeof...(Ts)>{}, value);
+    }
+
+    template<size_t... Is>
+    static Status deserializeVariantHelper(context::DData& ctx, size_t index, std::index_sequence<Is...>, std::variant<Ts...>& value)
+    {
+        Status status = Status::NoError;
+
+        // Only alternative with matching index is deserialized,
+        // expression stops on it because comma operator returns true
+        ((Is == index && (status = deserializeAlternative<Is>(ctx, value), true)) || ...);
+
+        return status;
+    }
+
+    template<size_t I>
+    static Status deserializeAlternative(context::DData& ctx, std::variant<Ts...>& value)
+    {
+        // If variant already holds required alternative we are reusing it
+        if (value.index() != I)
+            value.template emplace<I>();
+
+        if constexpr (std::is_same_v<std::variant_alternative_t<I, std::variant<Ts...>>, std::monostate>)
+            return Status::NoError;
+        else
+            return BodyProcessor::deserialize(ctx, std::get<I>(value));
+    }
+};
+
 } // namespace common_serialization::csp::processing::data
@@ -43,4 +43,226 @@ TEST(MultiTests, MainT)
     EXPECT_EQ(input, output);
 }
 
+TEST(MultiTests, ReuseExistingElements)
+{
+    tests_csp_with_std_interface::OneBigType<> input;
+    input.fill();
+
+    BinWalkerT bin;
+    EXPECT_EQ(input.serialize(bin.getVector()), Status::NoError);
+
+    tests_csp_with_std_interface::OneBigType<> output;
+    EXPECT_EQ(output.deserialize(bin), Status::NoError);
+
+    const char* pVectorString = output.m_vector1[0].data();
+    const uint8_t* pMapVector = output.m_map2.begin()->second.data();
+    const std::string* pSetKey = &*output.m_set1.begin();
+
+    bin.seek(0);
+    csp::context::DData ctx(bin);
+    ctx.setExistingElementsReuse(true);
+    EXPECT_EQ(output.deserialize(ctx), Status::NoError);
+
+    EXPECT_EQ(input, output);
+
+    // Storage of elements that were alive must be kept
+    EXPECT_EQ(output.m_vector1[0].data(), pVectorString);
+    EXPECT_EQ(output.m_map2.begin()->second.data(), pMapVector);
+    EXPECT_EQ(&*output.m_set1.begin(), pSetKey);
+
+    // Extra elements must be destroyed
+    input.m_vector1.pop_back();
+    input.m_map2.erase(input.m_map2.begin());
+    input.m_set1.clear();
+    input.m_unorderedMap1.erase(8);
+    input.m_deque1.pop_front();
+
+    bin.clear();
+    EXPECT_EQ(input.serialize(bin.getVector()), Status::NoError);
+
+    csp::context::DData ctxShrink(bin);
+    ctxShrink.setExistingElementsReuse(true);
+    EXPECT_EQ(output.deserialize(ctxShrink), Status::NoError);
+
+    EXPECT_EQ(input, output);
+}
+
+TEST(MultiTests, BigVectorOfArithmetic)
+{
+    // Size is chosen to be processed by a few chunks on deserialization
+    std::vector<uint64_t> input(10001);
+    for (size_t i = 0; i < input.size(); ++i)
+        input[i] = i * i;
+
+    BinWalkerT bin;
+    csp::context::SData ctxIn(bin.getVector());
+    EXPECT_EQ(csp::processing::data::BodyProcessor::serialize(input, ctxIn), Status::NoError);
+
+    std::vector<uint64_t> output;
+    csp::context::DData ctxOut(bin);
+    EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, output), Status::NoError);
+
+    EXPECT_EQ(input, output);
+
+    // Elements that are not aligned in binary data
+    bin.clear();
+    uint8_t prefix = 7;
+    EXPECT_EQ(csp::processing::data::BodyProcessor::serialize(prefix, ctxIn), Status::NoError);
+    EXPECT_EQ(csp::processing::data::BodyProcessor::serialize(input, ctxIn), Status::NoError);
+
+    output.clear();
+    bin.seek(0);
+    uint8_t prefixOut = 0;
+    EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, prefixOut), Status::NoError);
+    EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, output), Status::NoError);
+
+    EXPECT_EQ(prefixOut, prefix);
+    EXPECT_EQ(input, output);
+
+    // Declared size must not exceed data
+    bin.getVector().erase(bin.size() - 1, 1);
+    bin.seek(1);
+    EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, output), Status::ErrorOverflow);
+}
+
+TEST(MultiTests, SizeExceedingInput)
+{
+    // Declared sizes are far beyond input, so they must be rejected before any allocation
+    for (size_t size : { size_t(100), SIZE_MAX / 16, SIZE_MAX - 1 })
+    {
+        BinWalkerT bin;
+        csp::context::SData ctxIn(bin.getVector());
+        EXPECT_EQ(csp::processing::data::BodyProcessor::serializeSizeT(size, ctxIn), Status::NoError);
+        EXPECT_EQ(bin.getVector().pushBackN(reinterpret_cast<const uint8_t*>("data"), 4), Status::NoError);
+
+        csp::context::DData ctxOut(bin);
+
+        std::vector<uint64_t> vectorOfArithmetic;
+        bin.seek(0);
+        EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, vectorOfArithmetic), Status::ErrorOverflow);
+
+        std::vector<std::string> vectorOfStrings;
+        bin.seek(0);
+        EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, vectorOfStrings), Status::ErrorOverflow);
+
+        std::string string;
+        bin.seek(0);
+        EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, string), Status::ErrorOverflow);
+
+        std::u16string u16string;
+        bin.seek(0);
+        EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, u16string), Status::ErrorOverflow);
+    }
+}
+
+TEST(MultiTests, StringsAlignedAndNot)
+{
+    const std::u16string input = u"aligned and not aligned";
+
+    // Prefix of every size puts characters on every offset
+    for (uint8_t prefixSize = 0; prefixSize < 4; ++prefixSize)
+    {
+        BinWalkerT bin;
+        csp::context::SData ctxIn(bin.getVector());
+
+        for (uint8_t i = 0; i < prefixSize; ++i)
+            EXPECT_EQ(csp::processing::data::BodyProcessor::serialize(i, ctxIn), Status::NoError);
+
+        EXPECT_EQ(csp::processing::data::BodyProcessor::serialize(input, ctxIn), Status::NoError);
+        EXPECT_EQ(csp::processing::data::BodyProcessor::serialize(std::string("next"), ctxIn), Status::NoError);
+
+        csp::context::DData ctxOut(bin);
+        bin.seek(prefixSize);
+
+        std::u16string output;
+        std::string next;
+        EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, output), Status::NoError);
+        EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, next), Status::NoError);
+
+        EXPECT_EQ(output, input);
+        EXPECT_EQ(next, "next");
+        EXPECT_EQ(bin.tell(), bin.size());
+    }
+}
+
+TEST(MultiTests, Span)
+{
+    std::vector<uint32_t> inputData{ 1, 22, 333, 4444 };
+    std::span<uint32_t> input(inputData);
+
+    BinWalkerT bin;
+    csp::context::SData ctxIn(bin.getVector());
+    EXPECT_EQ(csp::processing::data::BodyProcessor::serialize(input, ctxIn), Status::NoError);
+
+    std::vector<uint32_t> outputData(inputData.size());
+    std::span<uint32_t> output(outputData);
+    csp::context::DData ctxOut(bin);
+    EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, output), Status::NoError);
+
+    EXPECT_EQ(inputData, outputData);
+
+    // span must view exactly as many elements as were serialized
+    bin.seek(0);
+    std::span<uint32_t> shortOutput(outputData.data(), outputData.size() - 1);
+    EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, shortOutput), Status::ErrorOverflow);
+}
+
+TEST(MultiTests, SpanOfNotTrivial)
+{
+    std::vector<std::string> inputData{ "1", "22", std::string(100, '3') };
+    std::span<std::string> input(inputData);
+
+    BinWalkerT bin;
+    csp::context::SData ctxIn(bin.getVector());
+    EXPECT_EQ(csp::processing::data::BodyProcessor::serialize(input, ctxIn), Status::NoError);
+
+    // Elements viewed by span are alive and must be overwritten, not constructed again
+    std::vector<std::string> outputData{ std::string(100, 'a'), "b", "" };
+    std::span<std::string> output(outputData);
+    csp::context::DData ctxOut(bin);
+    EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, output), Status::NoError);
+
+    EXPECT_EQ(inputData, outputData);
+}
+
+TEST(MultiTests, DequeRecursivePointers)
+{
+    std::deque<std::string> input{ "1", "22", "333" };
+
+    BinWalkerT bin;
+    csp::context::SData ctxIn(bin.getVector());
+    ctxIn.setDataFlags(csp::context::DataFlags(csp::context::DataFlags::kCheckRecursivePointers));
+    csp::context::SPointersMap sMap;
+    ctxIn.setPointersMap(&sMap);
+
+    EXPECT_EQ(csp::processing::data::BodyProcessor::serialize(input, ctxIn), Status::NoError);
+
+    // Elements are registered the same way as elements of std::vector
+    EXPECT_EQ(sMap.size(), input.size());
+
+    for (auto& item : input)
+        EXPECT_TRUE(sMap.contains(&item));
+
+    // Both reused and new elements are registered
+    std::deque<std::string> output{ "a" };
+
+    csp::context::DData ctxOut(bin);
+    ctxOut.setDataFlags(csp::context::DataFlags(csp::context::DataFlags::kCheckRecursivePointers));
+    ctxOut.setExistingElementsReuse(true);
+    csp::context::DPointersMap dMap;
+    ctxOut.setPointersMap(&dMap);
+
+    EXPECT_EQ(csp::processing::data::BodyProcessor::deserialize(ctxOut, output), Status::NoError);
+    EXPECT_EQ(input, output);
+    EXPECT_EQ(dMap.size(), output.size());
+
+    // Every element is registered at the same offset on both sides
+    for (size_t i = 0; i < output.size(); ++i)
+    {
+        auto it = dMap.find(sMap.find(&input[i])->second);
+        ASSERT_NE(it, dMap.end());
+        EXPECT_EQ(it->second, &output[i]);
+    }
+}
+
 } // namespace
@@ -25,8 +25,15 @@
 
 #include <string>
 #include <vector>
+#include <array>
+#include <deque>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <tuple>
+#include <optional>
+#include <variant>
 #include <common_serialization/csp_base/ISerializable.h>
 #include <common_serialization/tests_csp_with_std_interface/interface.h>
 
@@ -64,6 +71,22 @@ public:
         m_map2.emplace(std::make_pair(" b34b", std::vector<uint8_t>{2, 78, 235, 16}));
         m_tuple1 = { 93, 3209857239, "099234" };
         m_tuple2 = { 35232632.2 };
+        m_set1.emplace("zx");
+        m_set1.emplace("abc");
+        m_set1.emplace("klmn");
+        m_unorderedMap1.emplace(std::make_pair(8, "qwerty"));
+        m_unorderedMap1.emplace(std::make_pair(3000000, "uiop"));
+        m_unorderedSet1.emplace(-5);
+        m_unorderedSet1.emplace(1200);
+        m_unorderedSet1.emplace(7);
+        m_array1 = { 1, 23, 456, 7890 };
+        m_array2 = { m_string1 + "arr", "ay" };
+        m_optional1 = "opt";
+        m_variant1 = "variant";
+        m_variant2 = 35;
+        m_deque1.push_back(11);
+        m_deque1.push_front(1);
+        m_deque1.push_back(111);
     }
 
     [[nodiscard]] auto operator<=>(const OneBigType&) const = default;
@@ -76,6 +99,17 @@ public:
     std::map<std::string, std::vector<uint8_t>> m_map2;
     std::tuple<uint8_t, int64_t, std::string> m_tuple1;
     std::tuple<double> m_tuple2;
+    std::set<std::string> m_set1;
+    std::unordered_map<uint32_t, std::string> m_unorderedMap1;
+    std::unordered_set<int16_t> m_unorderedSet1;
+    std::array<uint32_t, 4> m_array1{};
+    std::array<std::string, 2> m_array2;
+    std::optional<std::string> m_optional1;
+    std::optional<uint64_t> m_optional2;
+    std::variant<std::monostate, int32_t, std::string> m_variant1;
+    std::variant<std::monostate, int32_t, std::string> m_variant2;
+    std::variant<std::monostate, int32_t, std::string> m_variant3;
+    std::deque<uint16_t> m_deque1;
 };
 
 } // namespace tests_csp_with_std_interface
@@ -40,6 +40,17 @@ Status BodyProcessor::serialize(const tests_csp_with_std_interface::OneBigType<>
     AGS_CS_RUN(serialize(value.m_map2, ctx));
     AGS_CS_RUN(serialize(value.m_tuple1, ctx));
     AGS_CS_RUN(serialize(value.m_tuple2, ctx));
+    AGS_CS_RUN(serialize(value.m_set1, ctx));
+    AGS_CS_RUN(serialize(value.m_unorderedMap1, ctx));
+    AGS_CS_RUN(serialize(value.m_unorderedSet1, ctx));
+    AGS_CS_RUN(serialize(value.m_array1, ctx));
+    AGS_CS_RUN(serialize(value.m_array2, ctx));
+    AGS_CS_RUN(serialize(value.m_optional1, ctx));
+    AGS_CS_RUN(serialize(value.m_optional2, ctx));
+    AGS_CS_RUN(serialize(value.m_variant1, ctx));
+    AGS_CS_RUN(serialize(value.m_variant2, ctx));
+    AGS_CS_RUN(serialize(value.m_variant3, ctx));
+    AGS_CS_RUN(serialize(value.m_deque1, ctx));
 
     return Status::NoError;
 }
@@ -57,6 +68,17 @@ Status BodyProcessor::deserialize(context::DData& ctx, tests_csp_with_std_interf
     AGS_CS_RUN(deserialize(ctx, value.m_map2));
     AGS_CS_RUN(deserialize(ctx, value.m_tuple1));
     AGS_CS_RUN(deserialize(ctx, value.m_tuple2));
+    AGS_CS_RUN(deserialize(ctx, value.m_set1));
+    AGS_CS_RUN(deserialize(ctx, value.m_unorderedMap1));
+    AGS_CS_RUN(deserialize(ctx, value.m_unorderedSet1));
+    AGS_CS_RUN(deserialize(ctx, value.m_array1));
+    AGS_CS_RUN(deserialize(ctx, value.m_array2));
+    AGS_CS_RUN(deserialize(ctx, value.m_optional1));
+    AGS_CS_RUN(deserialize(ctx, value.m_optional2));
+    AGS_CS_RUN(deserialize(ctx, value.m_variant1));
+    AGS_CS_RUN(deserialize(ctx, value.m_variant2));
+    AGS_CS_RUN(deserialize(ctx, value.m_variant3));
+    AGS_CS_RUN(deserialize(ctx, value.m_deque1));
 
     return Status::NoError;
 }